@@ -0,0 +1,267 @@
+#include <benchmark/benchmark.h>
+
+#include <components/bsa/compressedbsafile.hpp>
+#include <components/bsa/memorystream.hpp>
+#include <components/files/constrainedfilestream.hpp>
+
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_streambuf.hpp>
+
+#include <lz4frame.h>
+#include <zlib.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::uint32_t zlibVersion = 0x68;
+    constexpr std::uint32_t lz4Version = 0x69;
+    constexpr std::size_t filesCount = 256;
+    constexpr std::size_t fileSize = 64 * 1024;
+
+    template <class T>
+    void write(std::ostream& stream, T value)
+    {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template <typename Random>
+    std::vector<char> generateContent(Random& random)
+    {
+        // Small alphabet to get compression ratio closer to real meshes and textures
+        std::uniform_int_distribution<int> distribution(0, 15);
+        std::vector<char> result(fileSize);
+        for (char& v : result)
+            v = static_cast<char>(distribution(random));
+        return result;
+    }
+
+    std::vector<char> compress(std::uint32_t version, const std::vector<char>& content)
+    {
+        std::vector<char> result;
+        if (version == lz4Version)
+        {
+            result.resize(LZ4F_compressFrameBound(content.size(), nullptr));
+            const std::size_t size = LZ4F_compressFrame(result.data(), result.size(), content.data(), content.size(), nullptr);
+            if (LZ4F_isError(size))
+                throw std::runtime_error(std::string("LZ4 compression error: ") + LZ4F_getErrorName(size));
+            result.resize(size);
+        }
+        else
+        {
+            uLongf size = compressBound(static_cast<uLong>(content.size()));
+            result.resize(size);
+            if (compress2(reinterpret_cast<Bytef*>(result.data()), &size, reinterpret_cast<const Bytef*>(content.data()),
+                          static_cast<uLong>(content.size()), Z_DEFAULT_COMPRESSION) != Z_OK)
+                throw std::runtime_error("zlib compression error");
+            result.resize(size);
+        }
+        return result;
+    }
+
+    struct Record
+    {
+        std::size_t mOffset;
+        std::size_t mSize; // including uncompressed size
+    };
+
+    struct Archive
+    {
+        std::string mPath;
+        std::vector<Record> mRecords;
+    };
+
+    /// Writes an archive with a single folder containing files compressed by default
+    Archive generateArchive(std::uint32_t version)
+    {
+        const std::string path = (std::filesystem::temp_directory_path()
+            / ("openmw_compressedbsafile_benchmark_" + std::to_string(version) + ".bsa")).string();
+
+        const std::string folder = "meshes";
+        std::vector<std::string> names;
+        std::vector<std::vector<char>> data;
+        std::minstd_rand random;
+        std::uint32_t namesLength = 0;
+        for (std::size_t i = 0; i < filesCount; ++i)
+        {
+            names.push_back("file" + std::to_string(i) + ".nif");
+            namesLength += static_cast<std::uint32_t>(names.back().size() + 1);
+            data.push_back(compress(version, generateContent(random)));
+        }
+
+        const std::uint32_t flags = 0x1 | 0x2 | 0x4;
+        const std::size_t folderRecordSize = version == lz4Version ? 24 : 16;
+        const std::size_t headerSize = 36 + folderRecordSize + 1 + folder.size() + 1 + 16 * filesCount + namesLength;
+
+        std::ofstream stream(path, std::ios::binary);
+        write<std::uint32_t>(stream, 0x00415342);
+        write<std::uint32_t>(stream, version);
+        write<std::uint32_t>(stream, 36);
+        write<std::uint32_t>(stream, flags);
+        write<std::uint32_t>(stream, 1);
+        write<std::uint32_t>(stream, static_cast<std::uint32_t>(filesCount));
+        write<std::uint32_t>(stream, static_cast<std::uint32_t>(folder.size() + 1));
+        write<std::uint32_t>(stream, namesLength);
+        write<std::uint32_t>(stream, 0);
+
+        write<std::uint64_t>(stream, Bsa::CompressedBSAFile::generateHash(folder, {}));
+        write<std::uint32_t>(stream, static_cast<std::uint32_t>(filesCount));
+        if (version == lz4Version)
+        {
+            write<std::uint32_t>(stream, 0);
+            write<std::uint64_t>(stream, 0);
+        }
+        else
+            write<std::uint32_t>(stream, 0);
+
+        write<char>(stream, static_cast<char>(folder.size() + 1));
+        stream.write(folder.c_str(), folder.size() + 1);
+
+        std::vector<Record> records;
+        std::size_t offset = headerSize;
+        for (std::size_t i = 0; i < filesCount; ++i)
+        {
+            const std::filesystem::path name(names[i]);
+            const std::size_t size = sizeof(std::uint32_t) + data[i].size();
+            write<std::uint64_t>(stream, Bsa::CompressedBSAFile::generateHash(name.stem().string(), name.extension().string()));
+            write<std::uint32_t>(stream, static_cast<std::uint32_t>(size));
+            write<std::uint32_t>(stream, static_cast<std::uint32_t>(offset));
+            records.push_back(Record {offset, size});
+            offset += size;
+        }
+
+        for (const std::string& name : names)
+            stream.write(name.c_str(), name.size() + 1);
+
+        for (const std::vector<char>& v : data)
+        {
+            write<std::uint32_t>(stream, static_cast<std::uint32_t>(fileSize));
+            stream.write(v.data(), v.size());
+        }
+
+        return Archive {path, std::move(records)};
+    }
+
+    const Archive& getArchive(std::uint32_t version)
+    {
+        static const Archive zlibArchive = generateArchive(zlibVersion);
+        static const Archive lz4Archive = generateArchive(lz4Version);
+        return version == lz4Version ? lz4Archive : zlibArchive;
+    }
+
+    /// Decompresses the file the way CompressedBSAFile::getFile did before: zlib through boost::iostreams filter
+    /// reading from a file stream, LZ4 with a new decompression context for each file.
+    std::unique_ptr<Bsa::MemoryInputStream> getFileBaseline(std::uint32_t version, const Archive& archive,
+        const Record& record)
+    {
+        const Files::IStreamPtr fileStream = Files::openConstrainedFileStream(archive.mPath, record.mOffset, record.mSize);
+        std::size_t size = record.mSize;
+        std::size_t uncompressedSize = 0;
+        fileStream->read(reinterpret_cast<char*>(&uncompressedSize), sizeof(std::uint32_t));
+        size -= sizeof(std::uint32_t);
+        auto result = std::make_unique<Bsa::MemoryInputStream>(uncompressedSize);
+
+        if (version == lz4Version)
+        {
+            std::vector<char> buffer(size);
+            fileStream->read(buffer.data(), size);
+            LZ4F_decompressionContext_t context = nullptr;
+            LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
+            LZ4F_decompressOptions_t options = {};
+            const LZ4F_errorCode_t errorCode = LZ4F_decompress(context, result->getRawData(), &uncompressedSize,
+                buffer.data(), &size, &options);
+            LZ4F_freeDecompressionContext(context);
+            if (LZ4F_isError(errorCode))
+                throw std::runtime_error(std::string("LZ4 decompression error: ") + LZ4F_getErrorName(errorCode));
+        }
+        else
+        {
+            boost::iostreams::filtering_streambuf<boost::iostreams::input> inputStreamBuf;
+            inputStreamBuf.push(boost::iostreams::zlib_decompressor());
+            inputStreamBuf.push(*fileStream);
+            boost::iostreams::basic_array_sink<char> sink(result->getRawData(), uncompressedSize);
+            boost::iostreams::copy(inputStreamBuf, sink);
+        }
+
+        return result;
+    }
+
+    std::vector<const Bsa::BSAFile::FileStruct*> getAllFiles(const Bsa::CompressedBSAFile& bsa)
+    {
+        std::vector<const Bsa::BSAFile::FileStruct*> result;
+        for (const Bsa::BSAFile::FileStruct& file : bsa.getList())
+            result.push_back(&file);
+        return result;
+    }
+
+    template <std::uint32_t version>
+    void getFileSequentially(benchmark::State& state)
+    {
+        Bsa::CompressedBSAFile bsa;
+        bsa.open(getArchive(version).mPath);
+        if (state.range(0) != 0)
+            bsa.enableMemoryMapping();
+        const auto files = getAllFiles(bsa);
+
+        for (auto _ : state)
+            for (const Bsa::BSAFile::FileStruct* file : files)
+            {
+                const auto result = bsa.getFile(file);
+                benchmark::DoNotOptimize(result);
+            }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * filesCount * fileSize));
+    }
+
+    template <std::uint32_t version>
+    void getFileSequentiallyBaseline(benchmark::State& state)
+    {
+        const Archive& archive = getArchive(version);
+
+        for (auto _ : state)
+            for (const Record& record : archive.mRecords)
+            {
+                const auto result = getFileBaseline(version, archive, record);
+                benchmark::DoNotOptimize(result);
+            }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * filesCount * fileSize));
+    }
+
+    void getFileSequentially_zlib(benchmark::State& state)
+    {
+        getFileSequentially<zlibVersion>(state);
+    }
+
+    void getFileSequentially_lz4(benchmark::State& state)
+    {
+        getFileSequentially<lz4Version>(state);
+    }
+
+    void getFileSequentiallyBaseline_zlib(benchmark::State& state)
+    {
+        getFileSequentiallyBaseline<zlibVersion>(state);
+    }
+
+    void getFileSequentiallyBaseline_lz4(benchmark::State& state)
+    {
+        getFileSequentiallyBaseline<lz4Version>(state);
+    }
+} // namespace
+
+BENCHMARK(getFileSequentially_zlib)->ArgName("mmap")->Arg(0)->Arg(1)->UseRealTime();
+BENCHMARK(getFileSequentially_lz4)->ArgName("mmap")->Arg(0)->Arg(1)->UseRealTime();
+BENCHMARK(getFileSequentiallyBaseline_zlib)->UseRealTime();
+BENCHMARK(getFileSequentiallyBaseline_lz4)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,116 @@
+#include <benchmark/benchmark.h>
+
+#include <components/misc/constants.hpp>
+#include <components/misc/spatialgrid.hpp>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // Actors are spread over the active grid of 3x3 exterior cells
+    constexpr float sAreaSize = 3 * Constants::CellSizeInUnits;
+    constexpr float sGridCellSize = 2048;
+    constexpr float sCollisionAvoidanceRange = 200;
+    constexpr float sProcessingRange = 7168;
+
+    struct Actor
+    {
+        std::size_t mId;
+        osg::Vec3f mPosition;
+    };
+
+    std::vector<Actor> generateActors(std::size_t count)
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> horizontal(0, sAreaSize);
+        std::uniform_real_distribution<float> vertical(0, 1000);
+        std::vector<Actor> result;
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            result.push_back(Actor {i, osg::Vec3f(horizontal(random), horizontal(random), vertical(random))});
+        return result;
+    }
+
+    Misc::SpatialGrid<std::size_t> makeGrid(const std::vector<Actor>& actors)
+    {
+        Misc::SpatialGrid<std::size_t> grid(sGridCellSize);
+        for (const Actor& actor : actors)
+            grid.insert(actor.mId, actor.mPosition);
+        return grid;
+    }
+
+    // Every actor looks for its neighbours like the collision avoidance and the combat engagement do
+    void queryAllLinear(benchmark::State& state, float radius)
+    {
+        const std::vector<Actor> actors = generateActors(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            std::size_t found = 0;
+            for (const Actor& actor : actors)
+                for (const Actor& other : actors)
+                    if ((other.mPosition - actor.mPosition).length2() <= radius * radius)
+                        ++found;
+            benchmark::DoNotOptimize(found);
+        }
+    }
+
+    void queryAllGrid(benchmark::State& state, float radius)
+    {
+        const std::vector<Actor> actors = generateActors(static_cast<std::size_t>(state.range(0)));
+        const Misc::SpatialGrid<std::size_t> grid = makeGrid(actors);
+        for (auto _ : state)
+        {
+            std::size_t found = 0;
+            for (const Actor& actor : actors)
+                grid.forEachInRadius(actor.mPosition, radius, [&] (std::size_t, const osg::Vec3f&) { ++found; });
+            benchmark::DoNotOptimize(found);
+        }
+    }
+
+    void queryCollisionAvoidanceRangeLinear(benchmark::State& state)
+    {
+        queryAllLinear(state, sCollisionAvoidanceRange);
+    }
+
+    void queryCollisionAvoidanceRangeGrid(benchmark::State& state)
+    {
+        queryAllGrid(state, sCollisionAvoidanceRange);
+    }
+
+    void queryProcessingRangeLinear(benchmark::State& state)
+    {
+        queryAllLinear(state, sProcessingRange);
+    }
+
+    void queryProcessingRangeGrid(benchmark::State& state)
+    {
+        queryAllGrid(state, sProcessingRange);
+    }
+
+    // Every actor moves a bit each frame, some of them cross grid cell borders
+    void moveAllGrid(benchmark::State& state)
+    {
+        std::vector<Actor> actors = generateActors(static_cast<std::size_t>(state.range(0)));
+        Misc::SpatialGrid<std::size_t> grid = makeGrid(actors);
+        float offset = 5;
+        for (auto _ : state)
+        {
+            for (Actor& actor : actors)
+            {
+                actor.mPosition = actor.mPosition + osg::Vec3f(offset, offset, 0);
+                grid.move(actor.mId, actor.mPosition);
+            }
+            offset = -offset;
+        }
+    }
+}
+
+BENCHMARK(queryCollisionAvoidanceRangeLinear)->Arg(100)->Arg(250)->Arg(500)->Arg(1000);
+BENCHMARK(queryCollisionAvoidanceRangeGrid)->Arg(100)->Arg(250)->Arg(500)->Arg(1000);
+BENCHMARK(queryProcessingRangeLinear)->Arg(100)->Arg(250)->Arg(500)->Arg(1000);
+BENCHMARK(queryProcessingRangeGrid)->Arg(100)->Arg(250)->Arg(500)->Arg(1000);
+BENCHMARK(moveAllGrid)->Arg(100)->Arg(250)->Arg(500)->Arg(1000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,196 @@
+#include <benchmark/benchmark.h>
+
+#include "apps/openmw/mwdialogue/filterindex.hpp"
+
+#include <components/esm3/loaddial.hpp>
+#include <components/esm3/loadinfo.hpp>
+#include <components/misc/strings/algorithm.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <list>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // Morrowind, Tribunal and Bloodmoon together have about 3 thousand dialogues with about 10 infos each on average
+    constexpr std::size_t sDialoguesCount = 3000;
+    constexpr int sMaxInfosPerDialogue = 20;
+    constexpr int sActorsCount = 2600;
+    constexpr int sRacesCount = 10;
+    constexpr int sClassesCount = 70;
+    constexpr int sFactionsCount = 25;
+    constexpr int sCellsCount = 300;
+
+    std::string makeId(std::string_view prefix, int value)
+    {
+        return std::string(prefix) + " " + std::to_string(value);
+    }
+
+    struct Speaker
+    {
+        std::string mActorId;
+        std::string mRace;
+        std::string mClass;
+        std::string mFaction;
+        std::string mPlayerCell;
+    };
+
+    template <class Random>
+    std::string generateId(Random& random, std::string_view prefix, int count)
+    {
+        return makeId(prefix, std::uniform_int_distribution<int>(0, count - 1)(random));
+    }
+
+    // Returns more specific infos first like they are ordered in the game data
+    template <class Random>
+    std::pair<int, ESM::DialInfo> generateInfo(Random& random)
+    {
+        std::uniform_int_distribution<int> condition(0, 99);
+        ESM::DialInfo info;
+        info.mFactionLess = false;
+        const int value = condition(random);
+        if (value < 35)
+            info.mActor = generateId(random, "Actor", sActorsCount);
+        else if (value < 45)
+            info.mRace = generateId(random, "Race", sRacesCount);
+        else if (value < 55)
+            info.mClass = generateId(random, "Class", sClassesCount);
+        else if (value < 80)
+            info.mFaction = generateId(random, "Faction", sFactionsCount);
+        else if (value < 85)
+            info.mCell = generateId(random, "Cell", sCellsCount);
+        return {value, std::move(info)};
+    }
+
+    std::list<ESM::Dialogue> generateDialogues()
+    {
+        std::minstd_rand random;
+        std::uniform_int_distribution<int> infosCount(1, sMaxInfosPerDialogue);
+        std::list<ESM::Dialogue> result;
+        for (std::size_t i = 0; i < sDialoguesCount; ++i)
+        {
+            ESM::Dialogue& dialogue = result.emplace_back();
+            dialogue.mId = makeId("Topic", static_cast<int>(i));
+            dialogue.mType = ESM::Dialogue::Topic;
+            std::vector<std::pair<int, ESM::DialInfo>> infos;
+            for (int j = 0, n = infosCount(random); j < n; ++j)
+                infos.push_back(generateInfo(random));
+            std::stable_sort(infos.begin(), infos.end(),
+                [] (const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+            for (auto& [order, info] : infos)
+                dialogue.mInfo.push_back(std::move(info));
+        }
+        return result;
+    }
+
+    std::vector<Speaker> generateSpeakers()
+    {
+        std::minstd_rand random;
+        std::vector<Speaker> result;
+        for (int i = 0; i < 16; ++i)
+            result.push_back(Speaker {
+                generateId(random, "Actor", sActorsCount),
+                generateId(random, "Race", sRacesCount),
+                generateId(random, "Class", sClassesCount),
+                generateId(random, "Faction", sFactionsCount),
+                generateId(random, "Cell", sCellsCount),
+            });
+        return result;
+    }
+
+    // Speaker and player cell checks done by Filter::testActor and Filter::testPlayer
+    bool matches(const ESM::DialInfo& info, const Speaker& speaker)
+    {
+        if (!info.mActor.empty() && !Misc::StringUtils::ciEqual(info.mActor, speaker.mActorId))
+            return false;
+        if (!info.mRace.empty() && !Misc::StringUtils::ciEqual(info.mRace, speaker.mRace))
+            return false;
+        if (!info.mClass.empty() && !Misc::StringUtils::ciEqual(info.mClass, speaker.mClass))
+            return false;
+        if (!info.mFaction.empty() && !Misc::StringUtils::ciEqual(info.mFaction, speaker.mFaction))
+            return false;
+        if (!info.mCell.empty() && !Misc::StringUtils::ciStartsWith(speaker.mPlayerCell, info.mCell))
+            return false;
+        return true;
+    }
+
+    void buildIndex(benchmark::State& state)
+    {
+        const std::list<ESM::Dialogue> dialogues = generateDialogues();
+        for (auto _ : state)
+        {
+            MWDialogue::FilterIndex index;
+            for (const ESM::Dialogue& dialogue : dialogues)
+                index.add(dialogue);
+            benchmark::DoNotOptimize(index);
+        }
+    }
+
+    // Like DialogueManager::updateActorKnownTopics looks for the first matching info of each topic
+    void findFirstMatchingLinear(benchmark::State& state)
+    {
+        const std::list<ESM::Dialogue> dialogues = generateDialogues();
+        const std::vector<Speaker> speakers = generateSpeakers();
+        std::size_t speakerIndex = 0;
+        std::size_t tested = 0;
+        for (auto _ : state)
+        {
+            const Speaker& speaker = speakers[speakerIndex++ % speakers.size()];
+            std::size_t found = 0;
+            for (const ESM::Dialogue& dialogue : dialogues)
+                for (const ESM::DialInfo& info : dialogue.mInfo)
+                {
+                    ++tested;
+                    if (matches(info, speaker))
+                    {
+                        ++found;
+                        break;
+                    }
+                }
+            benchmark::DoNotOptimize(found);
+        }
+        // Real Filter does much more expensive checks for each tested info
+        state.counters["tested"] = benchmark::Counter(static_cast<double>(tested), benchmark::Counter::kAvgIterations);
+    }
+
+    void findFirstMatchingIndexed(benchmark::State& state)
+    {
+        const std::list<ESM::Dialogue> dialogues = generateDialogues();
+        const std::vector<Speaker> speakers = generateSpeakers();
+        MWDialogue::FilterIndex index;
+        for (const ESM::Dialogue& dialogue : dialogues)
+            index.add(dialogue);
+        std::size_t speakerIndex = 0;
+        std::size_t tested = 0;
+        for (auto _ : state)
+        {
+            const Speaker& speaker = speakers[speakerIndex++ % speakers.size()];
+            const MWDialogue::FilterIndexKey key = index.makeKey(speaker.mActorId, speaker.mRace, speaker.mClass,
+                speaker.mFaction, speaker.mPlayerCell, false);
+            std::size_t found = 0;
+            for (const ESM::Dialogue& dialogue : dialogues)
+                for (const ESM::DialInfo* info : index.getCandidates(dialogue, key))
+                {
+                    ++tested;
+                    if (matches(*info, speaker))
+                    {
+                        ++found;
+                        break;
+                    }
+                }
+            benchmark::DoNotOptimize(found);
+        }
+        // Real Filter does much more expensive checks for each tested info
+        state.counters["tested"] = benchmark::Counter(static_cast<double>(tested), benchmark::Counter::kAvgIterations);
+    }
+}
+
+BENCHMARK(buildIndex);
+BENCHMARK(findFirstMatchingLinear);
+BENCHMARK(findFirstMatchingIndexed);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,195 @@
+#include <benchmark/benchmark.h>
+
+#include <components/compiler/context.hpp>
+#include <components/compiler/errorhandler.hpp>
+#include <components/compiler/extensions.hpp>
+#include <components/compiler/extensions0.hpp>
+#include <components/compiler/fileparser.hpp>
+#include <components/compiler/scanner.hpp>
+
+#include <components/interpreter/context.hpp>
+#include <components/interpreter/installopcodes.hpp>
+#include <components/interpreter/interpreter.hpp>
+
+#include <components/misc/strings/algorithm.hpp>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Typical local script logic: a timer driven state machine over local variables
+    const std::string sStateMachineScript = R"mwscript(Begin bench_state_machine
+short state
+short counter
+float timer
+
+set counter to 0
+while ( counter < 100 )
+    set timer to timer + 0.1
+    if ( timer > 5 )
+        set timer to 0
+        set state to state + 1
+        if ( state > 3 )
+            set state to 0
+        endif
+    elseif ( state == 2 )
+        set timer to timer * 1.5 - 0.2
+    endif
+    set counter to counter + 1
+endwhile
+
+End)mwscript";
+
+    // Most local scripts bail out early most of the frames
+    const std::string sEarlyReturnScript = R"mwscript(Begin bench_early_return
+short doOnce
+float timer
+
+if ( doOnce == 1 )
+    return
+endif
+
+set timer to timer + 1
+if ( timer < 10 )
+    return
+endif
+
+set doOnce to 1
+
+End)mwscript";
+
+    class CompilerContext : public Compiler::Context
+    {
+    public:
+        bool canDeclareLocals() const override { return true; }
+        char getGlobalType(const std::string& name) const override { return ' '; }
+        std::pair<char, bool> getMemberType(const std::string& name, const std::string& id) const override { return {' ', false}; }
+        bool isId(const std::string& name) const override { return Misc::StringUtils::ciEqual(name, "player"); }
+    };
+
+    class ErrorHandler : public Compiler::ErrorHandler
+    {
+        void report(const std::string& message, const Compiler::TokenLoc& loc, Compiler::ErrorHandler::Type type) override
+        {
+            if (type == Compiler::ErrorHandler::ErrorMessage)
+                throw std::runtime_error("Failed to compile benchmark script: " + message);
+        }
+
+        void report(const std::string& message, Compiler::ErrorHandler::Type type) override
+        {
+            report(message, {}, type);
+        }
+    };
+
+    class InterpreterContext : public Interpreter::Context
+    {
+        std::vector<int> mShorts = std::vector<int>(8);
+        std::vector<int> mLongs = std::vector<int>(8);
+        std::vector<float> mFloats = std::vector<float>(8);
+
+    public:
+        std::string_view getTarget() const override { return {}; }
+        int getLocalShort(int index) const override { return mShorts[index]; }
+        int getLocalLong(int index) const override { return mLongs[index]; }
+        float getLocalFloat(int index) const override { return mFloats[index]; }
+        void setLocalShort(int index, int value) override { mShorts[index] = value; }
+        void setLocalLong(int index, int value) override { mLongs[index] = value; }
+        void setLocalFloat(int index, float value) override { mFloats[index] = value; }
+        void messageBox(std::string_view message, const std::vector<std::string>& buttons) override {}
+        void report(const std::string& message) override {}
+        int getGlobalShort(std::string_view name) const override { return {}; }
+        int getGlobalLong(std::string_view name) const override { return {}; }
+        float getGlobalFloat(std::string_view name) const override { return {}; }
+        void setGlobalShort(std::string_view name, int value) override {}
+        void setGlobalLong(std::string_view name, int value) override {}
+        void setGlobalFloat(std::string_view name, float value) override {}
+        std::vector<std::string> getGlobals() const override { return {}; }
+        char getGlobalType(std::string_view name) const override { return ' '; }
+        std::string getActionBinding(std::string_view action) const override { return {}; }
+        std::string_view getActorName() const override { return {}; }
+        std::string_view getNPCRace() const override { return {}; }
+        std::string_view getNPCClass() const override { return {}; }
+        std::string_view getNPCFaction() const override { return {}; }
+        std::string_view getNPCRank() const override { return {}; }
+        std::string_view getPCName() const override { return {}; }
+        std::string_view getPCRace() const override { return {}; }
+        std::string_view getPCClass() const override { return {}; }
+        std::string_view getPCRank() const override { return {}; }
+        std::string_view getPCNextRank() const override { return {}; }
+        int getPCBounty() const override { return {}; }
+        std::string_view getCurrentCellName() const override { return {}; }
+        int getMemberShort(std::string_view id, std::string_view name, bool global) const override { return {}; }
+        int getMemberLong(std::string_view id, std::string_view name, bool global) const override { return {}; }
+        float getMemberFloat(std::string_view id, std::string_view name, bool global) const override { return {}; }
+        void setMemberShort(std::string_view id, std::string_view name, int value, bool global) override {}
+        void setMemberLong(std::string_view id, std::string_view name, int value, bool global) override {}
+        void setMemberFloat(std::string_view id, std::string_view name, float value, bool global) override {}
+    };
+
+    std::vector<Interpreter::Type_Code> compile(const std::string& source)
+    {
+        Compiler::Extensions extensions;
+        Compiler::registerExtensions(extensions);
+        CompilerContext compilerContext;
+        compilerContext.setExtensions(&extensions);
+        ErrorHandler errorHandler;
+        Compiler::FileParser parser(errorHandler, compilerContext);
+        std::istringstream input(source);
+        Compiler::Scanner scanner(errorHandler, input, compilerContext.getExtensions());
+        scanner.scan(parser);
+        std::vector<Interpreter::Type_Code> result;
+        parser.getCode(result);
+        return result;
+    }
+
+    void runPrepared(benchmark::State& state, const std::string& source)
+    {
+        const std::vector<Interpreter::Type_Code> code = compile(source);
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes(interpreter);
+        const Interpreter::Program program = interpreter.prepare(code.data(), static_cast<int>(code.size()));
+        InterpreterContext context;
+        for (auto _ : state)
+            interpreter.run(program, context);
+    }
+
+    void runByteCode(benchmark::State& state, const std::string& source)
+    {
+        const std::vector<Interpreter::Type_Code> code = compile(source);
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes(interpreter);
+        InterpreterContext context;
+        for (auto _ : state)
+            interpreter.run(code.data(), static_cast<int>(code.size()), context);
+    }
+
+    void runStateMachinePrepared(benchmark::State& state)
+    {
+        runPrepared(state, sStateMachineScript);
+    }
+
+    void runStateMachineByteCode(benchmark::State& state)
+    {
+        runByteCode(state, sStateMachineScript);
+    }
+
+    void runEarlyReturnPrepared(benchmark::State& state)
+    {
+        runPrepared(state, sEarlyReturnScript);
+    }
+
+    void runEarlyReturnByteCode(benchmark::State& state)
+    {
+        runByteCode(state, sEarlyReturnScript);
+    }
+}
+
+BENCHMARK(runStateMachinePrepared);
+BENCHMARK(runStateMachineByteCode);
+BENCHMARK(runEarlyReturnPrepared);
+BENCHMARK(runEarlyReturnByteCode);
+
+BENCHMARK_MAIN();
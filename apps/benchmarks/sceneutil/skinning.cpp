@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+
+#include <components/sceneutil/skinning.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace SceneUtil;
+
+    // Body parts of NPCs have about thousand vertices split into groups with the same bone weights
+    constexpr std::size_t sVerticesCount = 1000;
+    constexpr std::size_t sGroupSize = 16;
+
+    struct Mesh
+    {
+        SoAVec3Array mPositions;
+        SoAVec3Array mNormals;
+        std::vector<unsigned short> mIndices;
+        std::vector<float> mMatrices;
+    };
+
+    Mesh generateMesh()
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> distribution(-1, 1);
+        Mesh result;
+        result.mPositions.reserve(sVerticesCount);
+        result.mNormals.reserve(sVerticesCount);
+        for (std::size_t i = 0; i < sVerticesCount; ++i)
+        {
+            result.mPositions.push_back(distribution(random) * 50, distribution(random) * 50, distribution(random) * 50);
+            result.mNormals.push_back(distribution(random), distribution(random), distribution(random));
+        }
+        // Vertices of a group are spread over the whole mesh
+        result.mIndices.resize(sVerticesCount);
+        std::iota(result.mIndices.begin(), result.mIndices.end(), 0);
+        std::shuffle(result.mIndices.begin(), result.mIndices.end(), random);
+        for (std::size_t i = 0; i < sVerticesCount; i += sGroupSize)
+            std::sort(result.mIndices.begin() + i, result.mIndices.begin() + std::min(i + sGroupSize, sVerticesCount));
+        for (std::size_t i = 0; i < sVerticesCount; i += sGroupSize)
+        {
+            for (std::size_t j = 0; j < 12; ++j)
+                result.mMatrices.push_back(distribution(random));
+            result.mMatrices.insert(result.mMatrices.end(), {0, 0, 0, 1});
+        }
+        return result;
+    }
+
+    template <class TransformPoints, class TransformVectors>
+    void skin(benchmark::State& state, TransformPoints&& transformPoints, TransformVectors&& transformVectors)
+    {
+        const Mesh mesh = generateMesh();
+        std::vector<float> positions(sVerticesCount * 3);
+        std::vector<float> normals(sVerticesCount * 3);
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < sVerticesCount; i += sGroupSize)
+            {
+                const std::size_t count = std::min(sGroupSize, sVerticesCount - i);
+                const float* const matrix = mesh.mMatrices.data() + i / sGroupSize * 16;
+                transformPoints(matrix, mesh.mPositions, i, count, mesh.mIndices.data() + i, positions.data(), 3);
+                transformVectors(matrix, mesh.mNormals, i, count, mesh.mIndices.data() + i, normals.data(), 3);
+            }
+            benchmark::DoNotOptimize(positions.data());
+            benchmark::DoNotOptimize(normals.data());
+        }
+        state.SetItemsProcessed(state.iterations() * sVerticesCount);
+    }
+
+    void skinScalar(benchmark::State& state)
+    {
+        skin(state, transformPointsScalar, transformVectorsScalar);
+    }
+
+    void skinSimd(benchmark::State& state)
+    {
+        skin(state, transformPoints, transformVectors);
+    }
+}
+
+BENCHMARK(skinScalar);
+BENCHMARK(skinSimd);
+
+BENCHMARK_MAIN();
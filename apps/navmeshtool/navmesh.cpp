@@ -12,6 +12,7 @@
 #include <components/detournavigator/recastmeshprovider.hpp>
 #include <components/detournavigator/serialization.hpp>
 #include <components/detournavigator/settings.hpp>
+#include <components/detournavigator/tilegraph.hpp>
 #include <components/detournavigator/tileposition.hpp>
 #include <components/misc/progressreporter.hpp>
 #include <components/sceneutil/workqueue.hpp>
@@ -24,6 +25,9 @@
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <map>
+#include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 #include <random>
@@ -42,8 +46,11 @@ namespace NavMeshTool
         using DetourNavigator::MeshSource;
         using DetourNavigator::Settings;
         using DetourNavigator::ShapeId;
+        using DetourNavigator::TileGraph;
+        using DetourNavigator::TileGraphNode;
         using DetourNavigator::TileId;
         using DetourNavigator::TilePosition;
+        using DetourNavigator::TileSides;
         using DetourNavigator::TileVersion;
         using DetourNavigator::TilesPositionsRange;
         using Sqlite3::Transaction;
@@ -75,6 +82,12 @@ namespace NavMeshTool
             }
         };
 
+        struct TileGraphTiles
+        {
+            std::vector<TileGraphNode> mNodes;
+            std::vector<std::pair<TilePosition, TileId>> mUnchanged;
+        };
+
         class NavMeshTileConsumer final : public DetourNavigator::NavMeshTileConsumer
         {
         public:
@@ -134,10 +147,12 @@ namespace NavMeshTool
 
             void identity(std::string_view worldspace, const TilePosition& tilePosition, std::int64_t tileId) override
             {
-                if (mRemoveUnusedTiles)
                 {
                     std::lock_guard lock(mMutex);
-                    mDeleted += static_cast<std::size_t>(mDb.deleteTilesAtExcept(worldspace, tilePosition, TileId {tileId}));
+                    if (mRemoveUnusedTiles)
+                        mDeleted += static_cast<std::size_t>(mDb.deleteTilesAtExcept(worldspace, tilePosition, TileId {tileId}));
+                    // Tile data is read for the tile graph after generation to not block other workers
+                    getTileGraphTiles(worldspace).mUnchanged.emplace_back(tilePosition, TileId {tileId});
                 }
                 report();
             }
@@ -145,6 +160,7 @@ namespace NavMeshTool
             void insert(std::string_view worldspace, const TilePosition& tilePosition,
                 std::int64_t version, const std::vector<std::byte>& input, PreparedNavMeshData& data) override
             {
+                const TileSides sides = DetourNavigator::getPortalSides(data.mPolyMesh);
                 {
                     std::lock_guard lock(mMutex);
                     if (mRemoveUnusedTiles)
@@ -152,6 +168,7 @@ namespace NavMeshTool
                     data.mUserId = static_cast<unsigned>(mNextTileId);
                     mDb.insertTile(mNextTileId, worldspace, tilePosition, TileVersion {version}, input, serialize(data));
                     ++mNextTileId;
+                    getTileGraphTiles(worldspace).mNodes.push_back(TileGraphNode {tilePosition, sides});
                 }
                 ++mInserted;
                 report();
@@ -161,11 +178,13 @@ namespace NavMeshTool
                 std::int64_t tileId, std::int64_t version, PreparedNavMeshData& data) override
             {
                 data.mUserId = static_cast<unsigned>(tileId);
+                const TileSides sides = DetourNavigator::getPortalSides(data.mPolyMesh);
                 {
                     std::lock_guard lock(mMutex);
                     if (mRemoveUnusedTiles)
                         mDeleted += static_cast<std::size_t>(mDb.deleteTilesAtExcept(worldspace, tilePosition, TileId {tileId}));
                     mDb.updateTile(TileId {tileId}, TileVersion {version}, serialize(data));
+                    getTileGraphTiles(worldspace).mNodes.push_back(TileGraphNode {tilePosition, sides});
                 }
                 ++mUpdated;
                 report();
@@ -209,6 +228,37 @@ namespace NavMeshTool
                 mTransaction.commit();
             }
 
+            // Must be called when all tiles are provided
+            void writeTileGraphs(const DetourNavigator::RecastSettings& settings, const AgentBounds& agentBounds)
+            {
+                const std::vector<std::byte> input = serialize(settings, agentBounds);
+                for (auto& [worldspace, tiles] : mTileGraphTiles)
+                {
+                    Log(Debug::Info) << "Reading " << tiles.mUnchanged.size() << " unchanged tiles for tile graph"
+                        " for worldspace \"" << worldspace << "\"...";
+                    for (const auto& [tilePosition, tileId] : tiles.mUnchanged)
+                    {
+                        std::optional<DetourNavigator::TileData> tileData;
+                        {
+                            const std::lock_guard lock(mMutex);
+                            tileData = mDb.getTileDataById(tileId);
+                        }
+                        PreparedNavMeshData data;
+                        if (tileData.has_value() && deserialize(tileData->mData, data))
+                            tiles.mNodes.push_back(TileGraphNode {tilePosition,
+                                DetourNavigator::getPortalSides(data.mPolyMesh)});
+                    }
+
+                    const TileGraph graph(std::move(tiles.mNodes));
+                    Log(Debug::Info) << "Writing tile graph with " << graph.size() << " nodes for worldspace \""
+                        << worldspace << "\"...";
+                    const std::lock_guard lock(mMutex);
+                    mDb.replaceTileGraph(worldspace, input, TileVersion {DetourNavigator::navMeshFormatVersion},
+                        serialize(graph));
+                }
+                mTileGraphTiles.clear();
+            }
+
             void vacuum()
             {
                 const std::lock_guard lock(mMutex);
@@ -240,6 +290,15 @@ namespace NavMeshTool
             Misc::ProgressReporter<LogGeneratedTiles> mReporter;
             ShapeId mNextShapeId;
             std::mutex mReportMutex;
+            std::map<std::string, TileGraphTiles, std::less<>> mTileGraphTiles;
+
+            TileGraphTiles& getTileGraphTiles(std::string_view worldspace)
+            {
+                auto it = mTileGraphTiles.find(worldspace);
+                if (it == mTileGraphTiles.end())
+                    it = mTileGraphTiles.emplace(std::string(worldspace), TileGraphTiles {}).first;
+                return it->second;
+            }
 
             void report()
             {
@@ -301,7 +360,10 @@ namespace NavMeshTool
 
         const Status status = navMeshTileConsumer->wait();
         if (status == Status::Ok)
+        {
             navMeshTileConsumer->commit();
+            navMeshTileConsumer->writeTileGraphs(settings.mRecast, agentBounds);
+        }
 
         const auto inserted = navMeshTileConsumer->getInserted();
         const auto updated = navMeshTileConsumer->getUpdated();
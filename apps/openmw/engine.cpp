@@ -3,6 +3,7 @@
 #include <iomanip>
 #include <chrono>
 #include <thread>
+#include <algorithm>
 #include <filesystem>
 
 #include <boost/filesystem/fstream.hpp>
@@ -747,7 +748,8 @@ void OMW::Engine::prepareEngine()
 
     mVFS = std::make_unique<VFS::Manager>(mFSStrict);
 
-    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true);
+    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true,
+        Settings::Manager::getBool("memory mapped archives", "General"));
 
     mResourceSystem = std::make_unique<Resource::ResourceSystem>(mVFS.get());
     mResourceSystem->getSceneManager()->getShaderManager().setMaxTextureUnits(mGlMaxTextureImageUnits);
@@ -882,6 +884,11 @@ void OMW::Engine::prepareEngine()
         mScriptBlacklistUse ? mScriptBlacklist : std::vector<std::string>());
     mEnvironment.setScriptManager(*mScriptManager);
 
+    if (Settings::Manager::getBool("script cache", "General"))
+        mScriptManager->loadCache(mCfgMgr.getUserDataPath() / "scripts.cache", mWorld->getContentFileStamps());
+    if (const std::size_t threadsCount = Settings::Manager::getThreadsCount("script precompile threads", "General"); threadsCount > 0)
+        mScriptManager->startPrecompiling(threadsCount);
+
     // Create game mechanics system
     mMechanicsManager = std::make_unique<MWMechanics::MechanicsManager>();
     mEnvironment.setMechanicsManager(*mMechanicsManager);
@@ -6,6 +6,7 @@
 
 #include "world.hpp"
 #include "mechanicsmanager.hpp"
+#include "luamanager.hpp"
 
 MWBase::Environment *MWBase::Environment::sThis = nullptr;
 
@@ -24,4 +25,5 @@ void MWBase::Environment::reportStats(unsigned int frameNumber, osg::Stats& stat
 {
     mMechanicsManager->reportStats(frameNumber, stats);
     mWorld->reportStats(frameNumber, stats);
+    mLuaManager->reportStats(frameNumber, stats);
 }
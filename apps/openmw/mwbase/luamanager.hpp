@@ -19,6 +19,11 @@ namespace Loading
     class Listener;
 }
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace ESM
 {
     class ESMReader;
@@ -98,6 +103,8 @@ namespace MWBase
         virtual void reloadAllScripts() = 0;
 
         virtual void handleConsoleCommand(const std::string& consoleMode, const std::string& command, const MWWorld::Ptr& selectedPtr) = 0;
+
+        virtual void reportStats(unsigned int frameNumber, osg::Stats& stats) const = 0;
     };
 
 }
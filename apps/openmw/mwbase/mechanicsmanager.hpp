@@ -64,6 +64,9 @@ namespace MWBase
             virtual void updateCell(const MWWorld::Ptr &old, const MWWorld::Ptr &ptr) = 0;
             ///< Moves an object to a new cell
 
+            virtual void updatePosition(const MWWorld::Ptr& ptr) = 0;
+            ///< Notify that the object has been moved
+
             virtual void drop (const MWWorld::CellStore *cellStore) = 0;
             ///< Deregister all objects in the given cell.
 
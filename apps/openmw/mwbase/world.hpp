@@ -75,6 +75,7 @@ namespace MWRender
 namespace MWMechanics
 {
     struct Movement;
+    class PathgridGraph;
 }
 
 namespace DetourNavigator
@@ -648,6 +649,9 @@ namespace MWBase
 
             virtual DetourNavigator::Navigator* getNavigator() const = 0;
 
+            /// Return pathgrid graph for given cell, empty graph if cell has no pathgrid
+            virtual const MWMechanics::PathgridGraph& getPathgridGraph(const MWWorld::CellStore* cell) = 0;
+
             virtual void updateActorPath(const MWWorld::ConstPtr& actor, const std::deque<osg::Vec3f>& path,
                 const DetourNavigator::AgentBounds& agentBounds, const osg::Vec3f& start, const osg::Vec3f& end) const = 0;
 
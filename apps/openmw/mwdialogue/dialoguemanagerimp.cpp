@@ -61,6 +61,9 @@ namespace MWDialogue
         mIsInChoice = false;
         mGoodbye = false;
         mCompilerContext.setExtensions (&extensions);
+
+        for (const ESM::Dialogue& dialogue : MWBase::Environment::get().getWorld()->getStore().get<ESM::Dialogue>())
+            mFilterIndex.add(dialogue);
     }
 
     void DialogueManager::clear()
@@ -155,7 +158,7 @@ namespace MWDialogue
         const MWWorld::Store<ESM::Dialogue> &dialogs =
             MWBase::Environment::get().getWorld()->getStore().get<ESM::Dialogue>();
 
-        Filter filter (actor, mChoice, mTalkedTo);
+        Filter filter (actor, mChoice, mTalkedTo, &mFilterIndex);
 
         for (MWWorld::Store<ESM::Dialogue>::iterator it = dialogs.begin(); it != dialogs.end(); ++it)
         {
@@ -283,7 +286,7 @@ namespace MWDialogue
 
     void DialogueManager::executeTopic (const std::string& topic, ResponseCallback* callback)
     {
-        Filter filter (mActor, mChoice, mTalkedTo);
+        Filter filter (mActor, mChoice, mTalkedTo, &mFilterIndex);
 
         const MWWorld::Store<ESM::Dialogue> &dialogues =
             MWBase::Environment::get().getWorld()->getStore().get<ESM::Dialogue>();
@@ -358,7 +361,7 @@ namespace MWDialogue
 
         const auto& dialogs = MWBase::Environment::get().getWorld()->getStore().get<ESM::Dialogue>();
 
-        Filter filter (mActor, -1, mTalkedTo);
+        Filter filter (mActor, -1, mTalkedTo, &mFilterIndex);
 
         for (const auto& dialog : dialogs)
         {
@@ -472,7 +475,7 @@ namespace MWDialogue
         const ESM::Dialogue* dialogue = searchDialogue(mLastTopic);
         if (dialogue)
         {
-            Filter filter (mActor, mChoice, mTalkedTo);
+            Filter filter (mActor, mChoice, mTalkedTo, &mFilterIndex);
 
             if (dialogue->mType == ESM::Dialogue::Topic || dialogue->mType == ESM::Dialogue::Greeting)
             {
@@ -602,7 +605,7 @@ namespace MWDialogue
 
     bool DialogueManager::checkServiceRefused(ResponseCallback* callback, ServiceType service)
     {
-        Filter filter (mActor, service, mTalkedTo);
+        Filter filter (mActor, service, mTalkedTo, &mFilterIndex);
 
         const MWWorld::Store<ESM::Dialogue> &dialogues =
             MWBase::Environment::get().getWorld()->getStore().get<ESM::Dialogue>();
@@ -654,7 +657,7 @@ namespace MWDialogue
         const ESM::Dialogue *dial = store.get<ESM::Dialogue>().find(topic);
 
         const MWMechanics::CreatureStats& creatureStats = actor.getClass().getCreatureStats(actor);
-        Filter filter(actor, 0, creatureStats.hasTalkedToPlayer());
+        Filter filter(actor, 0, creatureStats.hasTalkedToPlayer(), &mFilterIndex);
         const ESM::DialInfo *info = filter.search(*dial, false);
         if(info != nullptr)
         {
@@ -16,6 +16,8 @@
 
 #include "../mwscript/compilercontext.hpp"
 
+#include "filterindex.hpp"
+
 namespace ESM
 {
     struct Dialogue;
@@ -42,6 +44,7 @@ namespace MWDialogue
             Translation::Storage& mTranslationDataStorage;
             MWScript::CompilerContext mCompilerContext;
             Compiler::StreamErrorHandler mErrorHandler;
+            FilterIndex mFilterIndex;
 
             MWWorld::Ptr mActor;
             bool mTalkedTo;
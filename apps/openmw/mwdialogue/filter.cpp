@@ -597,9 +597,47 @@ bool MWDialogue::Filter::hasFactionRankReputationRequirements(const MWWorld::Ptr
     return stats.getFactionReputation (factionId)>=faction.mData.mRankData[rank].mFactReaction;
 }
 
-MWDialogue::Filter::Filter (const MWWorld::Ptr& actor, int choice, bool talkedToPlayer)
-: mActor (actor), mChoice (choice), mTalkedToPlayer (talkedToPlayer)
-{}
+MWDialogue::Filter::Filter (const MWWorld::Ptr& actor, int choice, bool talkedToPlayer, const FilterIndex* index)
+: mActor (actor), mChoice (choice), mTalkedToPlayer (talkedToPlayer), mIndex (index)
+{
+    if (mIndex == nullptr)
+        return;
+
+    const bool isCreature = (mActor.getType() != ESM::NPC::sRecordId);
+    std::string_view race;
+    std::string_view classId;
+    std::string_view faction;
+    if (!isCreature)
+    {
+        const ESM::NPC* npc = mActor.get<ESM::NPC>()->mBase;
+        race = npc->mRace;
+        classId = npc->mClass;
+        faction = mActor.getClass().getPrimaryFaction(mActor);
+    }
+
+    // Player cell name is resolved by getCandidates only for dialogues having cell conditions
+    mIndexKey = mIndex->makeKey(mActor.getCellRef().getRefId(), race, classId, faction, {}, isCreature);
+}
+
+std::vector<const ESM::DialInfo*> MWDialogue::Filter::getCandidates (const ESM::Dialogue& dialogue) const
+{
+    if (mIndex != nullptr)
+    {
+        if (!mHasPlayerCell && mIndex->hasCellConditions(dialogue))
+        {
+            const MWWorld::Ptr player = MWMechanics::getPlayer();
+            mIndex->setPlayerCell(MWBase::Environment::get().getWorld()->getCellName(player.getCell()), mIndexKey);
+            mHasPlayerCell = true;
+        }
+        return mIndex->getCandidates(dialogue, mIndexKey);
+    }
+
+    std::vector<const ESM::DialInfo*> infos;
+    infos.reserve(dialogue.mInfo.size());
+    for (const ESM::DialInfo& info : dialogue.mInfo)
+        infos.push_back(&info);
+    return infos;
+}
 
 const ESM::DialInfo* MWDialogue::Filter::search (const ESM::Dialogue& dialogue, const bool fallbackToInfoRefusal) const
 {
@@ -630,13 +668,12 @@ std::vector<const ESM::DialInfo *> MWDialogue::Filter::list (const ESM::Dialogue
     bool infoRefusal = false;
 
     // Iterate over topic responses to find a matching one
-    for (ESM::Dialogue::InfoContainer::const_iterator iter = dialogue.mInfo.begin();
-        iter!=dialogue.mInfo.end(); ++iter)
+    for (const ESM::DialInfo* info : getCandidates (dialogue))
     {
-        if (testActor (*iter) && testPlayer (*iter) && testSelectStructs (*iter))
+        if (testActor (*info) && testPlayer (*info) && testSelectStructs (*info))
         {
-            if (testDisposition (*iter, invertDisposition)) {
-                infos.push_back(&*iter);
+            if (testDisposition (*info, invertDisposition)) {
+                infos.push_back(info);
                 if (!searchAll)
                     break;
             }
@@ -655,10 +692,9 @@ std::vector<const ESM::DialInfo *> MWDialogue::Filter::list (const ESM::Dialogue
 
         const ESM::Dialogue& infoRefusalDialogue = *dialogues.find ("Info Refusal");
 
-        for (ESM::Dialogue::InfoContainer::const_iterator iter = infoRefusalDialogue.mInfo.begin();
-            iter!=infoRefusalDialogue.mInfo.end(); ++iter)
-            if (testActor (*iter) && testPlayer (*iter) && testSelectStructs (*iter) && testDisposition(*iter, invertDisposition)) {
-                infos.push_back(&*iter);
+        for (const ESM::DialInfo* info : getCandidates (infoRefusalDialogue))
+            if (testActor (*info) && testPlayer (*info) && testSelectStructs (*info) && testDisposition(*info, invertDisposition)) {
+                infos.push_back(info);
                 if (!searchAll)
                     break;
             }
@@ -5,6 +5,8 @@
 
 #include "../mwworld/ptr.hpp"
 
+#include "filterindex.hpp"
+
 namespace ESM
 {
     struct DialInfo;
@@ -20,6 +22,12 @@ namespace MWDialogue
             MWWorld::Ptr mActor;
             int mChoice;
             bool mTalkedToPlayer;
+            const FilterIndex* mIndex;
+            mutable FilterIndexKey mIndexKey;
+            mutable bool mHasPlayerCell = false;
+
+            std::vector<const ESM::DialInfo*> getCandidates (const ESM::Dialogue& dialogue) const;
+            ///< Infos that may pass testActor and testPlayer, all infos when there is no index.
 
             bool testActor (const ESM::DialInfo& info) const;
             ///< Is this the right actor for this \a info?
@@ -51,7 +59,8 @@ namespace MWDialogue
 
         public:
 
-            Filter (const MWWorld::Ptr& actor, int choice, bool talkedToPlayer);
+            Filter (const MWWorld::Ptr& actor, int choice, bool talkedToPlayer, const FilterIndex* index = nullptr);
+            ///< \param index is used to skip infos not matching the actor or player cell without testing them.
 
             std::vector<const ESM::DialInfo *> list (const ESM::Dialogue& dialogue,
                 bool fallbackToInfoRefusal, bool searchAll, bool invertDisposition=false) const;
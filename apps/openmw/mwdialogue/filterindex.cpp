@@ -0,0 +1,132 @@
+#include "filterindex.hpp"
+
+#include <components/esm3/loaddial.hpp>
+#include <components/misc/strings/algorithm.hpp>
+#include <components/misc/strings/lower.hpp>
+
+#include <algorithm>
+
+std::uint32_t MWDialogue::FilterIndex::addId(std::string_view value)
+{
+    const auto id = static_cast<std::uint32_t>(mIds.size() + 1);
+    return mIds.emplace(Misc::StringUtils::lowerCase(value), id).first->second;
+}
+
+std::uint32_t MWDialogue::FilterIndex::getId(std::string_view value) const
+{
+    if (value.empty())
+        return 0;
+    const auto it = mIds.find(Misc::StringUtils::lowerCase(value));
+    if (it == mIds.end())
+        return 0;
+    return it->second;
+}
+
+void MWDialogue::FilterIndex::add(const ESM::Dialogue& dialogue)
+{
+    DialogueIndex& index = mDialogues[&dialogue];
+    index = DialogueIndex {};
+    index.mInfos.reserve(dialogue.mInfo.size());
+    index.mConditions.reserve(dialogue.mInfo.size());
+
+    // Same order as the checks in Filter::testActor and Filter::testPlayer
+    for (const ESM::DialInfo& info : dialogue.mInfo)
+    {
+        Condition condition {ConditionType::None, 0};
+        if (!info.mActor.empty())
+            condition = Condition {ConditionType::Actor, addId(info.mActor)};
+        else if (!info.mRace.empty())
+            condition = Condition {ConditionType::Race, addId(info.mRace)};
+        else if (!info.mClass.empty())
+            condition = Condition {ConditionType::Class, addId(info.mClass)};
+        else if (!info.mFactionLess && !info.mFaction.empty())
+            condition = Condition {ConditionType::Faction, addId(info.mFaction)};
+        else if (!info.mCell.empty())
+        {
+            condition = Condition {ConditionType::Cell, addId(info.mCell)};
+            const auto cell = std::find_if(mCells.begin(), mCells.end(),
+                [&] (const auto& v) { return v.second == condition.mValue; });
+            if (cell == mCells.end())
+                mCells.emplace_back(Misc::StringUtils::lowerCase(info.mCell), condition.mValue);
+            index.mHasCellConditions = true;
+        }
+        index.mInfos.push_back(&info);
+        index.mConditions.push_back(condition);
+    }
+}
+
+MWDialogue::FilterIndexKey MWDialogue::FilterIndex::makeKey(std::string_view actorId, std::string_view race,
+    std::string_view classId, std::string_view faction, std::string_view playerCell, bool isCreature) const
+{
+    FilterIndexKey result;
+    result.mActorId = getId(actorId);
+    result.mRace = getId(race);
+    result.mClass = getId(classId);
+    result.mFaction = getId(faction);
+    result.mIsCreature = isCreature;
+    setPlayerCell(playerCell, result);
+    return result;
+}
+
+void MWDialogue::FilterIndex::setPlayerCell(std::string_view playerCell, FilterIndexKey& key) const
+{
+    key.mPlayerCells.clear();
+    // Cell conditions are prefixes of the player cell name
+    for (const auto& [cell, id] : mCells)
+        if (Misc::StringUtils::ciStartsWith(playerCell, cell))
+            key.mPlayerCells.push_back(id);
+    std::sort(key.mPlayerCells.begin(), key.mPlayerCells.end());
+}
+
+bool MWDialogue::FilterIndex::hasCellConditions(const ESM::Dialogue& dialogue) const
+{
+    const auto it = mDialogues.find(&dialogue);
+    return it != mDialogues.end() && it->second.mHasCellConditions;
+}
+
+bool MWDialogue::FilterIndex::matches(const Condition& condition, const FilterIndexKey& key) const
+{
+    // Creatures have only topics specific to their id
+    if (condition.mType == ConditionType::Actor)
+        return condition.mValue == key.mActorId;
+    if (key.mIsCreature)
+        return false;
+    switch (condition.mType)
+    {
+        case ConditionType::None:
+            return true;
+        case ConditionType::Actor:
+            break;
+        case ConditionType::Race:
+            return condition.mValue == key.mRace;
+        case ConditionType::Class:
+            return condition.mValue == key.mClass;
+        case ConditionType::Faction:
+            return condition.mValue == key.mFaction;
+        case ConditionType::Cell:
+            return std::binary_search(key.mPlayerCells.begin(), key.mPlayerCells.end(), condition.mValue);
+    }
+    return false;
+}
+
+std::vector<const ESM::DialInfo*> MWDialogue::FilterIndex::getCandidates(const ESM::Dialogue& dialogue,
+    const FilterIndexKey& key) const
+{
+    std::vector<const ESM::DialInfo*> result;
+
+    const auto it = mDialogues.find(&dialogue);
+    if (it == mDialogues.end())
+    {
+        result.reserve(dialogue.mInfo.size());
+        for (const ESM::DialInfo& info : dialogue.mInfo)
+            result.push_back(&info);
+        return result;
+    }
+
+    const DialogueIndex& index = it->second;
+    for (std::size_t i = 0; i < index.mConditions.size(); ++i)
+        if (matches(index.mConditions[i], key))
+            result.push_back(index.mInfos[i]);
+
+    return result;
+}
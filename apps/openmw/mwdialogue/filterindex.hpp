@@ -0,0 +1,92 @@
+#ifndef GAME_MWDIALOGUE_FILTERINDEX_H
+#define GAME_MWDIALOGUE_FILTERINDEX_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ESM
+{
+    struct DialInfo;
+    struct Dialogue;
+}
+
+namespace MWDialogue
+{
+    /// Speaker and player properties resolved to FilterIndex ids, created by FilterIndex::makeKey.
+    struct FilterIndexKey
+    {
+        std::uint32_t mActorId = 0;
+        std::uint32_t mRace = 0;
+        std::uint32_t mClass = 0;
+        std::uint32_t mFaction = 0;
+        std::vector<std::uint32_t> mPlayerCells; // sorted ids of all cell conditions matching the player cell
+        bool mIsCreature = false;
+    };
+
+    /// Precompiled info conditions not depending on the runtime state: speaker id, race, class, faction and player
+    /// cell. Condition strings are replaced by integer ids at load time so infos not matching the speaker are skipped
+    /// without string comparisons. Only the most selective condition of each info is used, so the candidates still
+    /// have to be tested by Filter. Candidates keep the dialogue order since the first matching info is used.
+    class FilterIndex
+    {
+        public:
+            /// Index infos of the dialogue. Infos must not change while the index is used.
+            void add(const ESM::Dialogue& dialogue);
+
+            FilterIndexKey makeKey(std::string_view actorId, std::string_view race, std::string_view classId,
+                std::string_view faction, std::string_view playerCell, bool isCreature) const;
+
+            /// Replaces player cells of the key. Allows to resolve the player cell only for dialogues having infos
+            /// conditioned on it.
+            void setPlayerCell(std::string_view playerCell, FilterIndexKey& key) const;
+
+            /// Returns true when candidates of the dialogue depend on the player cell of the key.
+            bool hasCellConditions(const ESM::Dialogue& dialogue) const;
+
+            /// Returns infos of the dialogue that may match the key in the dialogue order, all infos for not indexed
+            /// dialogue.
+            std::vector<const ESM::DialInfo*> getCandidates(const ESM::Dialogue& dialogue,
+                const FilterIndexKey& key) const;
+
+        private:
+            enum class ConditionType : std::uint8_t
+            {
+                None,
+                Actor,
+                Race,
+                Class,
+                Faction,
+                Cell,
+            };
+
+            struct Condition
+            {
+                ConditionType mType;
+                std::uint32_t mValue;
+            };
+
+            struct DialogueIndex
+            {
+                std::vector<const ESM::DialInfo*> mInfos;
+                std::vector<Condition> mConditions;
+                bool mHasCellConditions = false;
+            };
+
+            // Lower case string to id, 0 is reserved for strings not used by any condition
+            std::unordered_map<std::string, std::uint32_t> mIds;
+            std::vector<std::pair<std::string, std::uint32_t>> mCells;
+            std::unordered_map<const ESM::Dialogue*, DialogueIndex> mDialogues;
+
+            std::uint32_t addId(std::string_view value);
+
+            std::uint32_t getId(std::string_view value) const;
+
+            bool matches(const Condition& condition, const FilterIndexKey& key) const;
+    };
+}
+
+#endif
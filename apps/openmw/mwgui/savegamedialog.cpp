@@ -428,8 +428,17 @@ namespace MWGui
         mInfoText->setCaptionWithReplacing(text.str());
 
 
-        // Decode screenshot
-        const std::vector<char>& data = mCurrentSlot->mProfile.mScreenshot;
+        // Decode screenshot, slots found on disk don't keep it in memory
+        std::vector<char> data;
+        try
+        {
+            data = MWState::loadScreenshot(*mCurrentSlot);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "Failed to read savegame screenshot from '" << mCurrentSlot->mPath.filename() << "': " << e.what();
+            return;
+        }
         if (!data.size())
         {
             Log(Debug::Warning) << "Selected save file '" << mCurrentSlot->mPath.filename() << "' has no savegame screenshot";
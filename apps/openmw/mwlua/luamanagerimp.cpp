@@ -1,6 +1,11 @@
 #include "luamanagerimp.hpp"
 
+#include <algorithm>
 #include <filesystem>
+#include <iomanip>
+#include <sstream>
+
+#include <osg/Stats>
 
 #include <components/debug/debuglog.hpp>
 
@@ -30,14 +35,27 @@
 
 namespace MWLua
 {
+    namespace
+    {
+        LuaUtil::LuaStateSettings makeLuaStateSettings()
+        {
+            LuaUtil::LuaStateSettings settings;
+            settings.mProfilerEnabled = Settings::Manager::getBool("lua profiler", "Lua");
+            settings.mScriptMemoryLimit
+                = static_cast<std::int64_t>(std::max(0, Settings::Manager::getInt("lua script memory limit", "Lua"))) * 1024 * 1024;
+            return settings;
+        }
+    }
 
     LuaManager::LuaManager(const VFS::Manager* vfs, const std::string& libsDir)
-        : mLua(vfs, &mConfiguration)
+        : mLua(vfs, &mConfiguration, makeLuaStateSettings())
         , mUiResourceManager(vfs)
         , mL10n(vfs, &mLua)
     {
         Log(Debug::Info) << "Lua version: " << LuaUtil::getLuaVersion();
         mLua.addInternalLibSearchPath(libsDir);
+        mProfilerLogInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<float>(Settings::Manager::getFloat("lua profiler log interval", "Lua")));
 
         mGlobalSerializer = createUserdataSerializer(false, mWorldView.getObjectRegistry());
         mLocalSerializer = createUserdataSerializer(true, mWorldView.getObjectRegistry());
@@ -130,6 +148,7 @@ namespace MWLua
     void LuaManager::update()
     {
         static const bool luaDebug = Settings::Manager::getBool("lua debug", "Lua");
+        updateProfiler();
         if (mPlayer.isEmpty())
             return;  // The game is not started yet.
 
@@ -238,6 +257,60 @@ namespace MWLua
             mGlobalScripts.update(frameDuration);
     }
 
+    void LuaManager::updateProfiler()
+    {
+        mMemoryUsage = mLua.getTotalMemoryUsage();
+        if (!mLua.isProfilerEnabled())
+            return;
+        // Includes handlers called by the previous update and synchronizedUpdate
+        mMaxScriptFrameTime = mLua.takeMaxFrameTime();
+        const auto now = std::chrono::steady_clock::now();
+        if (mProfilerLogInterval > std::chrono::steady_clock::duration::zero() && now - mLastProfilerLog >= mProfilerLogInterval)
+        {
+            logProfilerStats();
+            mLastProfilerLog = now;
+        }
+    }
+
+    void LuaManager::logProfilerStats()
+    {
+        const std::vector<LuaUtil::LuaState::ScriptStats>& scriptStats = mLua.getScriptStats();
+
+        std::vector<std::pair<double, std::size_t>> order;
+        for (std::size_t i = 0; i < scriptStats.size(); ++i)
+        {
+            double time = 0;
+            for (const auto& [_, handler] : scriptStats[i].mHandlers)
+                time += handler.mTime;
+            if (time > 0 || scriptStats[i].mMemoryUsage > 0)
+                order.emplace_back(time, i);
+        }
+        std::sort(order.begin(), order.end(), [] (const auto& l, const auto& r) { return l.first > r.first; });
+
+        Log(Debug::Info) << "Lua profiler: " << order.size() << " scripts, "
+                         << mLua.getTotalMemoryUsage() / 1024 << " KiB total memory";
+        for (const auto& [time, scriptId] : order)
+        {
+            const LuaUtil::LuaState::ScriptStats& stats = scriptStats[scriptId];
+            std::ostringstream stream;
+            stream << std::fixed << std::setprecision(3);
+            stream << "  " << mConfiguration[scriptId].mScriptPath << ": " << time * 1000 << " ms, "
+                   << stats.mMemoryUsage / 1024 << " KiB";
+            for (const auto& [name, handler] : stats.mHandlers)
+                stream << "; " << name << " " << handler.mTime * 1000 << " ms/" << handler.mCalls << " calls";
+            Log(Debug::Info) << stream.str();
+        }
+
+        mLua.resetHandlersStats();
+    }
+
+    void LuaManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "Lua Memory", mMemoryUsage / (1024.0 * 1024.0));
+        if (mLua.isProfilerEnabled())
+            stats.setAttribute(frameNumber, "Lua Max Script", mMaxScriptFrameTime * 1000.0);
+    }
+
     void LuaManager::synchronizedUpdate()
     {
         if (mPlayer.isEmpty())
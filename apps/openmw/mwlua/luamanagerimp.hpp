@@ -1,6 +1,7 @@
 #ifndef MWLUA_LUAMANAGERIMP_H
 #define MWLUA_LUAMANAGERIMP_H
 
+#include <chrono>
 #include <map>
 #include <set>
 
@@ -125,8 +126,12 @@ namespace MWLua
 
         bool isProcessingInputEvents() const { return mProcessingInputEvents; }
 
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const override;
+
     private:
         void initConfiguration();
+        void updateProfiler();
+        void logProfilerStats();
         LocalScripts* createLocalScripts(const MWWorld::Ptr& ptr,
                                          std::optional<LuaUtil::ScriptIdsWithInitializationData> autoStartConf = std::nullopt);
 
@@ -189,6 +194,12 @@ namespace MWLua
 
         LuaUtil::LuaStorage mGlobalStorage{mLua.sol()};
         LuaUtil::LuaStorage mPlayerStorage{mLua.sol()};
+
+        // Updated by the Lua thread, reported by the main thread while the Lua thread is idle.
+        std::int64_t mMemoryUsage = 0;
+        double mMaxScriptFrameTime = 0;
+        std::chrono::steady_clock::duration mProfilerLogInterval {};
+        std::chrono::steady_clock::time_point mLastProfilerLog = std::chrono::steady_clock::now();
     };
 
 }
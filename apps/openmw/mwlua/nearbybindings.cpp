@@ -20,6 +20,27 @@ namespace sol
 
 namespace MWLua
 {
+    namespace
+    {
+        MWPhysics::RayCastingRequest makeRayCastingRequest(const osg::Vec3f& from, const osg::Vec3f& to,
+            const sol::optional<sol::table>& options)
+        {
+            MWPhysics::RayCastingRequest request;
+            request.mFrom = from;
+            request.mTo = to;
+            if (options)
+            {
+                sol::optional<LObject> ignoreObj = options->get<sol::optional<LObject>>("ignore");
+                if (ignoreObj) request.mIgnore = ignoreObj->ptr();
+                request.mMask = options->get<sol::optional<int>>("collisionType").value_or(request.mMask);
+                request.mRadius = options->get<sol::optional<float>>("radius").value_or(0);
+            }
+            if (request.mRadius > 0 && !request.mIgnore.isEmpty())
+                throw std::logic_error("Currently castRay doesn't support `ignore` when radius > 0");
+            return request;
+        }
+    }
+
     sol::table initNearbyPackage(const Context& context)
     {
         sol::table api(context.mLua->sol(), sol::create);
@@ -65,24 +86,23 @@ namespace MWLua
 
         api["castRay"] = [](const osg::Vec3f& from, const osg::Vec3f& to, sol::optional<sol::table> options)
         {
-            MWWorld::Ptr ignore;
-            int collisionType = MWPhysics::CollisionType_Default;
-            float radius = 0;
-            if (options)
-            {
-                sol::optional<LObject> ignoreObj = options->get<sol::optional<LObject>>("ignore");
-                if (ignoreObj) ignore = ignoreObj->ptr();
-                collisionType = options->get<sol::optional<int>>("collisionType").value_or(collisionType);
-                radius = options->get<sol::optional<float>>("radius").value_or(0);
-            }
+            const MWPhysics::RayCastingRequest request = makeRayCastingRequest(from, to, options);
             const MWPhysics::RayCastingInterface* rayCasting = MWBase::Environment::get().getWorld()->getRayCasting();
-            if (radius <= 0)
-                return rayCasting->castRay(from, to, ignore, std::vector<MWWorld::Ptr>(), collisionType);
+            if (request.mRadius <= 0)
+                return rayCasting->castRay(from, to, request.mIgnore, std::vector<MWWorld::Ptr>(), request.mMask);
             else
+                return rayCasting->castSphere(from, to, request.mRadius, request.mMask);
+        };
+        api["castRays"] = [](const sol::table& rays)
+        {
+            std::vector<MWPhysics::RayCastingRequest> requests;
+            for (std::size_t i = 1, n = rays.size(); i <= n; ++i)
             {
-                if (!ignore.isEmpty()) throw std::logic_error("Currently castRay doesn't support `ignore` when radius > 0");
-                return rayCasting->castSphere(from, to, radius, collisionType);
+                const sol::table ray = rays[i];
+                requests.push_back(makeRayCastingRequest(ray.get<osg::Vec3f>("from"), ray.get<osg::Vec3f>("to"), ray));
             }
+            const MWPhysics::RayCastingInterface* rayCasting = MWBase::Environment::get().getWorld()->getRayCasting();
+            return sol::as_table(rayCasting->castRays(requests));
         };
         // TODO: async raycasting
         /*api["asyncCastRay"] = [luaManager = context.mLuaManager](
@@ -1,6 +1,7 @@
 #ifndef OPENMW_MECHANICS_ACTOR_H
 #define OPENMW_MECHANICS_ACTOR_H
 
+#include <limits>
 #include <memory>
 
 #include "character.hpp"
@@ -26,6 +27,8 @@ namespace MWMechanics
     class Actor
     {
     public:
+        static constexpr std::size_t sNotPacked = std::numeric_limits<std::size_t>::max();
+
         Actor(const MWWorld::Ptr& ptr, MWRender::Animation* animation)
             : mCharacterController(ptr, animation)
             , mPositionAdjusted(false)
@@ -59,6 +62,10 @@ namespace MWMechanics
         void setPositionAdjusted(bool adjusted) { mPositionAdjusted = adjusted; }
         bool getPositionAdjusted() const { return mPositionAdjusted; }
 
+        /// Index in the packed per-frame state of MWMechanics::Actors
+        std::size_t getPackedIndex() const { return mPackedIndex; }
+        void setPackedIndex(std::size_t index) { mPackedIndex = index; }
+
     private:
         CharacterController mCharacterController;
         int mGreetingTimer{0};
@@ -67,6 +74,7 @@ namespace MWMechanics
         bool mIsTurningToPlayer{false};
         Misc::DeviatingPeriodicTimer mEngageCombat{1.0f, 0.25f, Misc::Rng::deviate(0, 0.25f, MWBase::Environment::get().getWorld()->getPrng())};
         bool mPositionAdjusted;
+        std::size_t mPackedIndex = sNotPacked;
     };
 
 }
@@ -1,5 +1,6 @@
 #include "actors.hpp"
 
+#include <algorithm>
 #include <optional>
 
 #include <components/esm3/esmreader.hpp>
@@ -49,6 +50,15 @@
 namespace
 {
 
+// Collision avoidance looks up at most 4 cells while processing range queries still skip a part of the active area
+constexpr float proximityGridCellSize = 2048.f;
+
+bool isInProcessingRange(const osg::Vec3f& position, const osg::Vec3f& playerPosition, float processingRange)
+{
+    // AI processing is only done within given distance to the player.
+    return (playerPosition - position).length2() <= processingRange * processingRange;
+}
+
 bool isConscious(const MWWorld::Ptr& ptr)
 {
     const MWMechanics::CreatureStats& stats = ptr.getClass().getCreatureStats(ptr);
@@ -236,6 +246,19 @@ namespace MWMechanics
             return (distanceToNextPathPoint - package.getNextPathPointTolerance(speed, duration, halfExtents)) / speed;
         }
 
+        float getMaxHeadTrackDistance(const MWWorld::Ptr& actor)
+        {
+            static const float fMaxHeadTrackDistance = MWBase::Environment::get().getWorld()->getStore()
+                .get<ESM::GameSetting>().find("fMaxHeadTrackDistance")->mValue.getFloat();
+            static const float fInteriorHeadTrackMult = MWBase::Environment::get().getWorld()->getStore()
+                .get<ESM::GameSetting>().find("fInteriorHeadTrackMult")->mValue.getFloat();
+            float maxDistance = fMaxHeadTrackDistance;
+            const ESM::Cell* currentCell = actor.getCell()->getCell();
+            if (!currentCell->isExterior() && !(currentCell->mData.mFlags & ESM::Cell::QuasiEx))
+                maxDistance *= fInteriorHeadTrackMult;
+            return maxDistance;
+        }
+
         void updateHeadTracking(const MWWorld::Ptr& actor, const MWWorld::Ptr& targetActor,
             MWWorld::Ptr& headTrackTarget, float& sqrHeadTrackDistance, bool inCombatOrPursue)
         {
@@ -249,14 +272,7 @@ namespace MWMechanics
             if (isTargetMagicallyHidden(targetActor))
                 return;
 
-            static const float fMaxHeadTrackDistance = MWBase::Environment::get().getWorld()->getStore()
-                .get<ESM::GameSetting>().find("fMaxHeadTrackDistance")->mValue.getFloat();
-            static const float fInteriorHeadTrackMult = MWBase::Environment::get().getWorld()->getStore()
-                .get<ESM::GameSetting>().find("fInteriorHeadTrackMult")->mValue.getFloat();
-            float maxDistance = fMaxHeadTrackDistance;
-            const ESM::Cell* currentCell = actor.getCell()->getCell();
-            if (!currentCell->isExterior() && !(currentCell->mData.mFlags & ESM::Cell::QuasiEx))
-                maxDistance *= fInteriorHeadTrackMult;
+            const float maxDistance = getMaxHeadTrackDistance(actor);
 
             const osg::Vec3f actor1Pos(actorRefData.getPosition().asVec3());
             const osg::Vec3f actor2Pos(targetActor.getRefData().getPosition().asVec3());
@@ -280,7 +296,8 @@ namespace MWMechanics
             }
         }
 
-        void updateHeadTracking(const MWWorld::Ptr& ptr, const std::list<Actor>& actors, bool isPlayer, CharacterController& ctrl)
+        void updateHeadTracking(const MWWorld::Ptr& ptr, const std::vector<MWWorld::Ptr>& candidates, bool isPlayer,
+            CharacterController& ctrl)
         {
             float sqrHeadTrackDistance = std::numeric_limits<float>::max();
             MWWorld::Ptr headTrackTarget;
@@ -306,13 +323,8 @@ namespace MWMechanics
                 else
                 {
                     // Find something nearby.
-                    for (const Actor& otherActor : actors)
-                    {
-                        if (otherActor.getPtr() == ptr)
-                            continue;
-
-                        updateHeadTracking(ptr, otherActor.getPtr(), headTrackTarget, sqrHeadTrackDistance, inCombatOrPursue);
-                    }
+                    for (const MWWorld::Ptr& candidate : candidates)
+                        updateHeadTracking(ptr, candidate, headTrackTarget, sqrHeadTrackDistance, inCombatOrPursue);
                 }
             }
 
@@ -1092,7 +1104,9 @@ namespace MWMechanics
         }
     }
 
-    Actors::Actors() : mSmoothMovement(Settings::Manager::getBool("smooth movement", "Game"))
+    Actors::Actors()
+        : mGrid(proximityGridCellSize)
+        , mSmoothMovement(Settings::Manager::getBool("smooth movement", "Game"))
     {
         mTimerDisposeSummonsCorpses = 0.2f; // We should add a delay between summoned creature death and its corpse despawning
 
@@ -1122,6 +1136,8 @@ namespace MWMechanics
             return;
         const auto it = mActors.emplace(mActors.end(), ptr, anim);
         mIndex.emplace(ptr.mRef, it);
+        mGrid.insert(&*it, ptr.getRefData().getPosition().asVec3());
+        addPackedActor(*it);
 
         if (updateImmediately)
             it->getCharacterController().update(0);
@@ -1170,6 +1186,8 @@ namespace MWMechanics
         {
             if(!keepActive)
                 removeTemporaryEffects(iter->second->getPtr());
+            mGrid.erase(&*iter->second);
+            removePackedActor(*iter->second);
             mActors.erase(iter->second);
             mIndex.erase(iter);
         }
@@ -1221,6 +1239,21 @@ namespace MWMechanics
             iter->second->updatePtr(ptr);
     }
 
+    void Actors::updatePosition(const MWWorld::Ptr& ptr)
+    {
+        const auto iter = mIndex.find(ptr.mRef);
+        if (iter == mIndex.end())
+            return;
+        const osg::Vec3f position = ptr.getRefData().getPosition().asVec3();
+        mGrid.move(&*iter->second, position);
+        const std::size_t packedIndex = iter->second->getPackedIndex();
+        // Picked up by the next packActors
+        if (packedIndex == Actor::sNotPacked)
+            return;
+        mPacked.mPositions[packedIndex] = position;
+        mPacked.mInProcessingRange[packedIndex] = isInProcessingRange(position, mPacked.mPlayerPosition, mActorsProcessingRange);
+    }
+
     void Actors::dropActors (const MWWorld::CellStore *cellStore, const MWWorld::Ptr& ignore)
     {
         for (auto iter = mActors.begin(); iter != mActors.end();)
@@ -1229,6 +1262,8 @@ namespace MWMechanics
             {
                 removeTemporaryEffects(iter->getPtr());
                 mIndex.erase(iter->getPtr().mRef);
+                mGrid.erase(&*iter);
+                removePackedActor(*iter);
                 iter = mActors.erase(iter);
             }
             else
@@ -1352,12 +1387,12 @@ namespace MWMechanics
             osg::Vec2f movementCorrection(0, 0);
             float angleToApproachingActor = 0;
 
-            // Iterate through all other actors and predict collisions.
-            for (const Actor& otherActor : mActors)
+            // Iterate through other actors close enough and predict collisions.
+            mGrid.forEachInRadius(basePos, maxDistToCheck, [&] (const Actor* otherActor, const osg::Vec3f& /*otherPos*/)
             {
-                const MWWorld::Ptr& otherPtr = otherActor.getPtr();
+                const MWWorld::Ptr& otherPtr = otherActor->getPtr();
                 if (otherPtr == ptr || otherPtr == currentTarget)
-                    continue;
+                    return;
 
                 const osg::Vec3f otherHalfExtents = world->getHalfExtents(otherPtr);
                 const osg::Vec3f deltaPos = otherPtr.getRefData().getPosition().asVec3() - basePos;
@@ -1366,11 +1401,11 @@ namespace MWMechanics
 
                 // Ignore actors which are not close enough or come from behind.
                 if (dist > maxDistToCheck || relPos.y() < 0)
-                    continue;
+                    return;
 
                 // Don't check for a collision if vertical distance is greater then the actor's height.
                 if (deltaPos.z() > halfExtents.z() * 2 || deltaPos.z() < -otherHalfExtents.z() * 2)
-                    continue;
+                    return;
 
                 const osg::Vec3f speed = otherPtr.getClass().getMovementSettings(otherPtr).asVec3()
                         * otherPtr.getClass().getMaxSpeed(otherPtr);
@@ -1385,17 +1420,17 @@ namespace MWMechanics
                 const float v2 = relSpeed.length2();
                 const float Dh = vr * vr - v2 * (relPos.length2() - collisionDist * collisionDist);
                 if (Dh <= 0 || v2 == 0)
-                    continue; // No solution; distance is always >= collisionDist.
+                    return; // No solution; distance is always >= collisionDist.
                 const float t = (-vr - std::sqrt(Dh)) / v2;
 
                 if (t < 0 || t > timeToCollision)
-                    continue;
+                    return;
 
                 // Check visibility and awareness last as it's expensive.
                 if (!MWBase::Environment::get().getWorld()->getLOS(otherPtr, ptr))
-                    continue;
+                    return;
                 if (!MWBase::Environment::get().getMechanicsManager()->awarenessCheck(otherPtr, ptr))
-                    continue;
+                    return;
 
                 timeToCollision = t;
                 angleToApproachingActor = std::atan2(deltaPos.x(), deltaPos.y());
@@ -1406,7 +1441,7 @@ namespace MWMechanics
                 if (otherPtr.getClass().getCreatureStats(otherPtr).isDead())
                     // In case of dead body still try to go around (it looks natural), but reduce the correction twice.
                     movementCorrection.y() *= 0.5f;
-            }
+            });
 
             if (timeToCollision < timeToCheck)
             {
@@ -1465,17 +1500,18 @@ namespace MWMechanics
             }
             const bool godmode = MWBase::Environment::get().getWorld()->getGodModeState();
 
+            packActors(playerPos, aiActive && mTimerUpdateHeadTrack == 0);
+
              // AI and magic effects update
             for (Actor& actor : mActors)
             {
+                const std::size_t packedIndex = actor.getPackedIndex();
                 const bool isPlayer = actor.getPtr() == player;
                 CharacterController& ctrl = actor.getCharacterController();
                 MWBase::LuaManager::ActorControls* luaControls =
                     MWBase::Environment::get().getLuaManager()->getActorControls(actor.getPtr());
 
-                const float distSqr = (playerPos - actor.getPtr().getRefData().getPosition().asVec3()).length2();
-                // AI processing is only done within given distance to the player.
-                const bool inProcessingRange = distSqr <= mActorsProcessingRange*mActorsProcessingRange;
+                const bool inProcessingRange = mPacked.mInProcessingRange[packedIndex] != 0;
 
                 // If dead or no longer in combat, no longer store any actors who attempted to hit us. Also remove for the player.
                 if (!isPlayer && (actor.getPtr().getClass().getCreatureStats(actor.getPtr()).isDead()
@@ -1522,15 +1558,35 @@ namespace MWMechanics
                             if (!isPlayer)
                                 adjustCommandedActor(actor.getPtr());
 
-                            for (const Actor& otherActor : mActors)
+                            if (!isPlayer) // player is not AI-controlled
                             {
-                                if (otherActor.getPtr() == actor.getPtr() || isPlayer) // player is not AI-controlled
-                                    continue;
-                                engageCombat(actor.getPtr(), otherActor.getPtr(), cachedAllies, otherActor.getPtr() == player);
+                                // engageCombat ignores actors further than the processing range, so these are the
+                                // same actors in the same order as in mActors, and the random rolls are the same
+                                std::vector<const Actor*> neighbors;
+                                mGrid.forEachInRadius(actor.getPtr().getRefData().getPosition().asVec3(),
+                                    mActorsProcessingRange, [&] (const Actor* otherActor, const osg::Vec3f& /*otherPos*/)
+                                {
+                                    if (otherActor != &actor)
+                                        neighbors.push_back(otherActor);
+                                });
+                                std::sort(neighbors.begin(), neighbors.end(), [] (const Actor* lhs, const Actor* rhs)
+                                {
+                                    return lhs->getPackedIndex() < rhs->getPackedIndex();
+                                });
+                                for (const Actor* neighbor : neighbors)
+                                    engageCombat(actor.getPtr(), neighbor->getPtr(), cachedAllies, neighbor->getPtr() == player);
                             }
                         }
                         if (mTimerUpdateHeadTrack == 0)
-                            updateHeadTracking(actor.getPtr(), mActors, isPlayer, ctrl);
+                        {
+                            // Candidates might have been removed by the update of other actors.
+                            // Actors added during the update, like summoned creatures, have none until the next one.
+                            auto& candidates = mPacked.mHeadTrackCandidates[packedIndex];
+                            candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                [&] (const MWWorld::Ptr& candidate) { return mIndex.find(candidate.mRef) == mIndex.end(); }),
+                                candidates.end());
+                            updateHeadTracking(actor.getPtr(), candidates, isPlayer, ctrl);
+                        }
 
                         if (actor.getPtr().getClass().isNpc() && !isPlayer)
                             updateCrimePursuit(actor.getPtr(), duration);
@@ -1579,7 +1635,7 @@ namespace MWMechanics
             CharacterController* playerCharacter = nullptr;
             for (Actor& actor : mActors)
             {
-                const float dist = (playerPos - actor.getPtr().getRefData().getPosition().asVec3()).length();
+                const float dist = (playerPos - mPacked.mPositions[actor.getPackedIndex()]).length();
                 const bool isPlayer = actor.getPtr() == player;
                 CreatureStats &stats = actor.getPtr().getClass().getCreatureStats(actor.getPtr());
                 // Actors with active AI should be able to move.
@@ -1664,6 +1720,95 @@ namespace MWMechanics
         updateCombatMusic();
     }
 
+    void Actors::packActors(const osg::Vec3f& playerPos, bool headTracking)
+    {
+        mPacked.mPlayerPosition = playerPos;
+        mPacked.mActors.clear();
+        for (Actor& actor : mActors)
+        {
+            actor.setPackedIndex(mPacked.mActors.size());
+            mPacked.mActors.push_back(&actor);
+        }
+
+        const std::size_t size = mPacked.mActors.size();
+        mPacked.mPositions.resize(size);
+        mPacked.mInProcessingRange.resize(size);
+        mPacked.mDead.resize(size);
+        mPacked.mHeadTrackCandidates.resize(size);
+
+        for (std::size_t i = 0; i < size; ++i)
+            packActor(i);
+
+        if (!headTracking)
+            return;
+
+        // Uses only positions and orientations which don't change during the update,
+        // so the result doesn't depend on when it's computed
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (mPacked.mInProcessingRange[i] != 0)
+                getHeadTrackCandidates(i, mPacked.mHeadTrackCandidates[i]);
+            else
+                mPacked.mHeadTrackCandidates[i].clear();
+        }
+    }
+
+    void Actors::packActor(std::size_t index)
+    {
+        const MWWorld::Ptr& ptr = mPacked.mActors[index]->getPtr();
+        const osg::Vec3f position = ptr.getRefData().getPosition().asVec3();
+        mPacked.mPositions[index] = position;
+        mPacked.mInProcessingRange[index] = isInProcessingRange(position, mPacked.mPlayerPosition, mActorsProcessingRange);
+        mPacked.mDead[index] = ptr.getClass().getCreatureStats(ptr).isDead();
+    }
+
+    void Actors::addPackedActor(Actor& actor)
+    {
+        actor.setPackedIndex(mPacked.mActors.size());
+        mPacked.mActors.push_back(&actor);
+        mPacked.mPositions.emplace_back();
+        mPacked.mInProcessingRange.push_back(0);
+        mPacked.mDead.push_back(0);
+        mPacked.mHeadTrackCandidates.emplace_back();
+        packActor(actor.getPackedIndex());
+    }
+
+    void Actors::removePackedActor(const Actor& actor)
+    {
+        if (actor.getPackedIndex() == Actor::sNotPacked)
+            return;
+        mPacked.mActors[actor.getPackedIndex()] = nullptr;
+    }
+
+    void Actors::getHeadTrackCandidates(std::size_t index, std::vector<MWWorld::Ptr>& out) const
+    {
+        out.clear();
+
+        const MWWorld::Ptr& ptr = mPacked.mActors[index]->getPtr();
+        const auto& refData = ptr.getRefData();
+        if (!refData.getBaseNode())
+            return;
+
+        const float maxDistance = getMaxHeadTrackDistance(ptr);
+        const osg::Vec3f& position = mPacked.mPositions[index];
+        osg::Vec3f direction = refData.getBaseNode()->getAttitude() * osg::Vec3f(0,1,0);
+        direction.z() = 0;
+
+        for (std::size_t i = 0, size = mPacked.mActors.size(); i < size; ++i)
+        {
+            if (i == index || mPacked.mDead[i] != 0)
+                continue;
+
+            osg::Vec3f targetDirection = mPacked.mPositions[i] - position;
+            if (targetDirection.length2() > maxDistance * maxDistance)
+                continue;
+
+            targetDirection.z() = 0;
+            if (direction * targetDirection > 0)
+                out.push_back(mPacked.mActors[i]->getPtr());
+        }
+    }
+
     void Actors::notifyDied(const MWWorld::Ptr &actor)
     {
         actor.getClass().getCreatureStats(actor).notifyDied();
@@ -1967,22 +2112,15 @@ namespace MWMechanics
 
     void Actors::getObjectsInRange(const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& out) const
     {
-        for (const Actor& actor : mActors)
+        mGrid.forEachInRadius(position, radius, [&] (const Actor* actor, const osg::Vec3f& /*actorPosition*/)
         {
-            if ((actor.getPtr().getRefData().getPosition().asVec3() - position).length2() <= radius*radius)
-                out.push_back(actor.getPtr());
-        }
+            out.push_back(actor->getPtr());
+        });
     }
 
     bool Actors::isAnyObjectInRange(const osg::Vec3f& position, float radius) const
     {
-        for (const Actor& actor : mActors)
-        {
-            if ((actor.getPtr().getRefData().getPosition().asVec3() - position).length2() <= radius*radius)
-                return true;
-        }
-
-        return false;
+        return mGrid.anyInRadius(position, radius, [] (const Actor*, const osg::Vec3f&) { return true; });
     }
 
     std::vector<MWWorld::Ptr> Actors::getActorsSidingWith(const MWWorld::Ptr& actorPtr, bool excludeInfighting) const
@@ -2197,6 +2335,8 @@ namespace MWMechanics
     void Actors::clear()
     {
         mIndex.clear();
+        mGrid.clear();
+        mPacked = PackedActors {};
         mActors.clear();
         mDeathCount.clear();
     }
@@ -7,6 +7,8 @@
 #include <list>
 #include <map>
 
+#include <components/misc/spatialgrid.hpp>
+
 #include "actor.hpp"
 
 namespace ESM
@@ -77,6 +79,9 @@ namespace MWMechanics
             void updateActor(const MWWorld::Ptr &old, const MWWorld::Ptr& ptr) const;
             ///< Updates an actor with a new Ptr
 
+            void updatePosition(const MWWorld::Ptr& ptr);
+            ///< Updates the actor location in the proximity index
+
             void dropActors (const MWWorld::CellStore *cellStore, const MWWorld::Ptr& ignore);
             ///< Deregister all actors (except for \a ignore) in the given cell.
 
@@ -179,9 +184,24 @@ namespace MWMechanics
                 Battle
             };
 
+            /// Hot per-frame actor state packed into arrays for the passes over all actors.
+            /// Rebuilt in mActors order at the start of each update and kept in sync with added and removed
+            /// actors and their positions until the next one. Removed actors leave null slots.
+            struct PackedActors
+            {
+                std::vector<Actor*> mActors;
+                std::vector<osg::Vec3f> mPositions;
+                std::vector<unsigned char> mInProcessingRange;
+                std::vector<unsigned char> mDead;
+                std::vector<std::vector<MWWorld::Ptr>> mHeadTrackCandidates;
+                osg::Vec3f mPlayerPosition;
+            };
+
             std::map<std::string, int> mDeathCount;
             std::list<Actor> mActors;
             std::map<const MWWorld::LiveCellRefBase*, std::list<Actor>::iterator> mIndex;
+            Misc::SpatialGrid<const Actor*> mGrid;
+            PackedActors mPacked;
             float mTimerDisposeSummonsCorpses;
             float mTimerUpdateHeadTrack = 0;
             float mTimerUpdateEquippedLight = 0;
@@ -202,6 +222,19 @@ namespace MWMechanics
 
             void killDeadActors ();
 
+            /// Rebuilds mPacked
+            void packActors(const osg::Vec3f& playerPos, bool headTracking);
+
+            /// Fills the packed state slot of the actor
+            void packActor(std::size_t index);
+
+            void addPackedActor(Actor& actor);
+
+            void removePackedActor(const Actor& actor);
+
+            /// Selects the actors close enough and in front of the actor to be head tracked.
+            void getHeadTrackCandidates(std::size_t index, std::vector<MWWorld::Ptr>& out) const;
+
             void purgeSpellEffects(int casterActorId) const;
 
             void predictAndAvoidCollisions(float duration) const;
@@ -273,7 +273,7 @@ namespace MWMechanics
             const auto agentBounds = world->getPathfindingAgentBounds(actor);
             const auto navigatorFlags = getNavigatorFlags(actor);
             const auto areaCosts = getAreaCosts(actor);
-            const auto pathGridGraph = getPathGridGraph(actor.getCell());
+            const auto& pathGridGraph = getPathGridGraph(actor.getCell());
             mPathFinder.buildPath(actor, vActorPos, vTargetPos, actor.getCell(), pathGridGraph, agentBounds,
                                   navigatorFlags, areaCosts, storage.mAttackRange, PathType::Full);
 
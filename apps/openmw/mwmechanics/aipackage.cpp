@@ -99,6 +99,7 @@ void MWMechanics::AiPackage::reset()
     // reset all members
     mReaction.reset();
     mIsShortcutting = false;
+    mDestInLOS = false;
     mShortcutProhibited = false;
     mShortcutFailPos = osg::Vec3f();
     mCachedTarget = MWWorld::Ptr();
@@ -134,6 +135,10 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
     const bool isDestReached = (distToTarget <= destTolerance);
     const bool actorCanMoveByZ = canActorMoveByZAxis(actor);
 
+    // Path requested before may be found by now
+    if (mPathFinder.isPathPending() && mPathFinder.applyPendingPath(actor, getPathGridGraph(actor.getCell())))
+        onPathBuilt(position, dest);
+
     if (!isDestReached && timerStatus == Misc::TimerStatus::Elapsed)
     {
         if (canOpenDoors(actor))
@@ -148,25 +153,14 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
 
         if (!mIsShortcutting)
         {
-            if (wasShortcutting || doesPathNeedRecalc(dest, actor)) // if need to rebuild path
+            // if need to rebuild path and it's not being built already
+            if (!mPathFinder.isPathPending() && (wasShortcutting || doesPathNeedRecalc(dest, actor)))
             {
-                mPathFinder.buildLimitedPath(actor, position, dest, actor.getCell(), getPathGridGraph(actor.getCell()),
+                mPathFinder.requestLimitedPath(actor, position, dest, actor.getCell(), getPathGridGraph(actor.getCell()),
                     agentBounds, getNavigatorFlags(actor), getAreaCosts(actor), endTolerance, pathType);
-                mRotateOnTheRunChecks = 3;
-
-                // give priority to go directly on target if there is minimal opportunity
-                if (destInLOS && mPathFinder.getPath().size() > 1)
-                {
-                    // get point just before dest
-                    auto pPointBeforeDest = mPathFinder.getPath().rbegin() + 1;
-
-                    // if start point is closer to the target then last point of path (excluding target itself) then go straight on the target
-                    if (distance(position, dest) <= distance(dest, *pPointBeforeDest))
-                    {
-                        mPathFinder.clearPath();
-                        mPathFinder.addPointToPath(dest);
-                    }
-                }
+                mDestInLOS = destInLOS;
+                if (!mPathFinder.isPathPending())
+                    onPathBuilt(position, dest);
             }
 
             if (!mPathFinder.getPath().empty()) //Path has points in it
@@ -314,16 +308,7 @@ void MWMechanics::AiPackage::openDoors(const MWWorld::Ptr& actor)
 
 const MWMechanics::PathgridGraph& MWMechanics::AiPackage::getPathGridGraph(const MWWorld::CellStore *cell)
 {
-    const ESM::CellId& id = cell->getCell()->getCellId();
-    // static cache is OK for now, pathgrids can never change during runtime
-    typedef std::map<ESM::CellId, std::unique_ptr<MWMechanics::PathgridGraph> > CacheMap;
-    static CacheMap cache;
-    CacheMap::iterator found = cache.find(id);
-    if (found == cache.end())
-    {
-        cache.insert(std::make_pair(id, std::make_unique<MWMechanics::PathgridGraph>(MWMechanics::PathgridGraph(cell))));
-    }
-    return *cache[id].get();
+    return MWBase::Environment::get().getWorld()->getPathgridGraph(cell);
 }
 
 bool MWMechanics::AiPackage::shortcutPath(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
@@ -388,6 +373,25 @@ bool MWMechanics::AiPackage::checkWayIsClearForActor(const osg::Vec3f& startPoin
     return false;
 }
 
+void MWMechanics::AiPackage::onPathBuilt(const osg::Vec3f& position, const osg::Vec3f& dest)
+{
+    mRotateOnTheRunChecks = 3;
+
+    // give priority to go directly on target if there is minimal opportunity
+    if (mDestInLOS && mPathFinder.getPath().size() > 1)
+    {
+        // get point just before dest
+        auto pPointBeforeDest = mPathFinder.getPath().rbegin() + 1;
+
+        // if start point is closer to the target then last point of path (excluding target itself) then go straight on the target
+        if (distance(position, dest) <= distance(dest, *pPointBeforeDest))
+        {
+            mPathFinder.clearPath();
+            mPathFinder.addPointToPath(dest);
+        }
+    }
+}
+
 bool MWMechanics::AiPackage::doesPathNeedRecalc(const osg::Vec3f& newDest, const MWWorld::Ptr& actor) const
 {
     return mPathFinder.getPath().empty()
@@ -170,9 +170,12 @@ namespace MWMechanics
             bool mShortcutProhibited; // shortcutting may be prohibited after unsuccessful attempt
             osg::Vec3f mShortcutFailPos; // position of last shortcut fail
             float mLastDestinationTolerance = 0;
+            bool mDestInLOS = false; // if destination was in line of sight when path was requested
 
         private:
             bool isNearInactiveCell(osg::Vec3f position);
+
+            void onPathBuilt(const osg::Vec3f& position, const osg::Vec3f& dest);
     };
 }
 
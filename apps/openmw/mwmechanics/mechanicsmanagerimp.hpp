@@ -50,6 +50,9 @@ namespace MWMechanics
             void updateCell(const MWWorld::Ptr &old, const MWWorld::Ptr &ptr) override;
             ///< Moves an object to a new cell
 
+            void updatePosition(const MWWorld::Ptr& ptr) override;
+            ///< Notify that the object has been moved
+
             void drop(const MWWorld::CellStore *cellStore) override;
             ///< Deregister all objects in the given cell.
 
@@ -6,6 +6,7 @@
 #include <osg/io_utils>
 
 #include <components/detournavigator/navigatorutils.hpp>
+#include <components/detournavigator/pathrequestqueue.hpp>
 #include <components/detournavigator/debug.hpp>
 #include <components/debug/debuglog.hpp>
 #include <components/misc/coordinateconverter.hpp>
@@ -84,6 +85,31 @@ namespace
         return 2 * std::max(realHalfExtents.x(), realHalfExtents.y());
     }
 
+    void logBuildPathError(const MWWorld::ConstPtr& actor, DetourNavigator::Status status,
+        const osg::Vec3f& startPoint, const osg::Vec3f& endPoint, DetourNavigator::Flags flags)
+    {
+        Log(Debug::Debug) << "Build path by navigator error: \"" << DetourNavigator::getMessage(status)
+            << "\" for \"" << actor.getClass().getName(actor) << "\" (" << actor.getBase()
+            << ") from " << startPoint << " to " << endPoint << " with flags ("
+            << DetourNavigator::WriteFlags {flags} << ")";
+    }
+
+    float getMaxPathDistance(const DetourNavigator::Navigator& navigator)
+    {
+        return std::min(navigator.getMaxNavmeshAreaRealRadius(), static_cast<float>(Constants::CellSizeInUnits));
+    }
+
+    osg::Vec3f getLimitedPathEnd(const DetourNavigator::Navigator& navigator, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint)
+    {
+        const auto maxDistance = getMaxPathDistance(navigator);
+        const auto startToEnd = endPoint - startPoint;
+        const auto distance = startToEnd.length();
+        if (distance <= maxDistance)
+            return endPoint;
+        return startPoint + startToEnd * maxDistance / distance;
+    }
+
     float getHeight(const MWWorld::ConstPtr& actor)
     {
         const auto world = MWBase::Environment::get().getWorld();
@@ -362,6 +388,7 @@ namespace MWMechanics
     void PathFinder::buildStraightPath(const osg::Vec3f& endPoint)
     {
         mPath.clear();
+        mPendingPath = nullptr;
         mPath.push_back(endPoint);
         mConstructed = true;
     }
@@ -370,6 +397,7 @@ namespace MWMechanics
         const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph)
     {
         mPath.clear();
+        mPendingPath = nullptr;
         mCell = cell;
 
         buildPathByPathgridImpl(startPoint, endPoint, pathgridGraph, std::back_inserter(mPath));
@@ -382,6 +410,7 @@ namespace MWMechanics
         const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType)
     {
         mPath.clear();
+        mPendingPath = nullptr;
 
         // If it's not possible to build path over navmesh due to disabled navmesh generation fallback to straight path
         DetourNavigator::Status status = buildPathByNavigatorImpl(actor, startPoint, endPoint, agentBounds, flags,
@@ -402,6 +431,7 @@ namespace MWMechanics
         PathType pathType)
     {
         mPath.clear();
+        mPendingPath = nullptr;
         mCell = cell;
 
         DetourNavigator::Status status = DetourNavigator::Status::NavMeshNotFound;
@@ -446,12 +476,7 @@ namespace MWMechanics
             return DetourNavigator::Status::Success;
 
         if (status != DetourNavigator::Status::Success)
-        {
-            Log(Debug::Debug) << "Build path by navigator error: \"" << DetourNavigator::getMessage(status)
-                << "\" for \"" << actor.getClass().getName(actor) << "\" (" << actor.getBase()
-                << ") from " << startPoint << " to " << endPoint << " with flags ("
-                << DetourNavigator::WriteFlags {flags} << ")";
-        }
+            logBuildPathError(actor, status, startPoint, endPoint, flags);
 
         return status;
     }
@@ -481,10 +506,7 @@ namespace MWMechanics
 
         if (status != DetourNavigator::Status::Success)
         {
-            Log(Debug::Debug) << "Build path by navigator error: \"" << DetourNavigator::getMessage(status)
-                << "\" for \"" << actor.getClass().getName(actor) << "\" (" << actor.getBase()
-                << ") from " << startPoint << " to " << mPath.front() << " with flags ("
-                << DetourNavigator::WriteFlags {flags} << ")";
+            logBuildPathError(actor, status, startPoint, mPath.front(), flags);
             return;
         }
 
@@ -503,16 +525,71 @@ namespace MWMechanics
         const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType)
     {
         const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
-        const auto maxDistance = std::min(
-            navigator->getMaxNavmeshAreaRealRadius(),
-            static_cast<float>(Constants::CellSizeInUnits)
-        );
-        const auto startToEnd = endPoint - startPoint;
-        const auto distance = startToEnd.length();
-        if (distance <= maxDistance)
-            return buildPath(actor, startPoint, endPoint, cell, pathgridGraph, agentBounds, flags, areaCosts,
-                             endTolerance, pathType);
-        const auto end = startPoint + startToEnd * maxDistance / distance;
+        const auto end = getLimitedPathEnd(*navigator, startPoint, endPoint);
         buildPath(actor, startPoint, end, cell, pathgridGraph, agentBounds, flags, areaCosts, endTolerance, pathType);
     }
+
+    void PathFinder::requestLimitedPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint, const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph,
+        const DetourNavigator::AgentBounds& agentBounds, const DetourNavigator::Flags flags,
+        const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType)
+    {
+        if (actor.getClass().isPureWaterCreature(actor) || actor.getClass().isPureFlyingCreature(actor))
+            return buildLimitedPath(actor, startPoint, endPoint, cell, pathgridGraph, agentBounds, flags, areaCosts,
+                                    endTolerance, pathType);
+
+        const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
+        DetourNavigator::PathQuery query;
+        query.mAgentBounds = agentBounds;
+        query.mStepSize = getPathStepSize(actor);
+        query.mStart = startPoint;
+        // The end is limited by the coarse tile route in background
+        query.mEnd = endPoint;
+        query.mMaxDistance = getMaxPathDistance(*navigator);
+        query.mIncludeFlags = flags;
+        if ((flags & DetourNavigator::Flag_usePathgrid) == 0)
+            query.mFallbackIncludeFlags = flags | DetourNavigator::Flag_usePathgrid;
+        query.mAcceptPartialPath = pathType == PathType::Partial;
+        query.mAreaCosts = areaCosts;
+        query.mEndTolerance = endTolerance;
+
+        mPendingPath = navigator->requestPath(query);
+        mPendingCell = cell;
+
+        // Result is ready at once when there is no navmesh
+        applyPendingPath(actor, pathgridGraph);
+    }
+
+    bool PathFinder::applyPendingPath(const MWWorld::ConstPtr& actor, const PathgridGraph& pathgridGraph)
+    {
+        if (mPendingPath == nullptr || !mPendingPath->isReady())
+            return false;
+
+        const std::shared_ptr<const DetourNavigator::PathRequest> request = std::move(mPendingPath);
+        mPendingPath = nullptr;
+
+        const DetourNavigator::PathQuery& query = request->getQuery();
+        DetourNavigator::Status status = request->getStatus();
+        if (query.mAcceptPartialPath && status == DetourNavigator::Status::PartialPath)
+            status = DetourNavigator::Status::Success;
+
+        mPath.clear();
+        mCell = mPendingCell;
+
+        if (status == DetourNavigator::Status::Success)
+            mPath.assign(request->getPath().begin(), request->getPath().end());
+        else
+            logBuildPathError(actor, status, query.mStart, request->getEnd(),
+                query.mFallbackIncludeFlags != DetourNavigator::Flag_none ? query.mFallbackIncludeFlags : query.mIncludeFlags);
+
+        if (mPath.empty())
+            buildPathByPathgridImpl(query.mStart, request->getEnd(), pathgridGraph, std::back_inserter(mPath));
+
+        if (status == DetourNavigator::Status::NavMeshNotFound && mPath.empty())
+            mPath.push_back(request->getEnd());
+
+        mConstructed = !mPath.empty();
+
+        return true;
+    }
 }
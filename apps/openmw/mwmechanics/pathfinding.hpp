@@ -4,6 +4,7 @@
 #include <deque>
 #include <cassert>
 #include <iterator>
+#include <memory>
 
 #include <components/detournavigator/flags.hpp>
 #include <components/detournavigator/areatype.hpp>
@@ -21,6 +22,7 @@ namespace MWWorld
 namespace DetourNavigator
 {
     struct AgentBounds;
+    class PathRequest;
 }
 
 namespace MWMechanics
@@ -95,6 +97,7 @@ namespace MWMechanics
                 mConstructed = false;
                 mPath.clear();
                 mCell = nullptr;
+                mPendingPath = nullptr;
             }
 
             void buildStraightPath(const osg::Vec3f& endPoint);
@@ -120,6 +123,23 @@ namespace MWMechanics
                 const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
                 PathType pathType);
 
+            /// Same as buildLimitedPath but path over navmesh is found in background by the navigator.
+            /// Current path is kept until the found one is applied by applyPendingPath.
+            void requestLimitedPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
+                const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph, const DetourNavigator::AgentBounds& agentBounds,
+                const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
+                PathType pathType);
+
+            bool isPathPending() const
+            {
+                return mPendingPath != nullptr;
+            }
+
+            /// Replaces current path by the requested one when it's found
+            /// @param pathgridGraph is used when there is no path over navmesh
+            /// @return true when path is replaced
+            bool applyPendingPath(const MWWorld::ConstPtr& actor, const PathgridGraph& pathgridGraph);
+
             /// Remove front point if exist and within tolerance
             void update(const osg::Vec3f& position, float pointTolerance, float destinationTolerance,
                         bool shortenIfAlmostStraight, bool canMoveByZ, const DetourNavigator::AgentBounds& agentBounds,
@@ -221,6 +241,9 @@ namespace MWMechanics
 
             const MWWorld::CellStore* mCell;
 
+            std::shared_ptr<const DetourNavigator::PathRequest> mPendingPath;
+            const MWWorld::CellStore* mPendingCell = nullptr;
+
             void buildPathByPathgridImpl(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
                 const PathgridGraph& pathgridGraph, std::back_insert_iterator<std::deque<osg::Vec3f>> out);
 
@@ -1,13 +1,16 @@
 #include "pathgrid.hpp"
 
-#include "../mwbase/world.hpp"
-#include "../mwbase/environment.hpp"
-
-#include "../mwworld/cellstore.hpp"
-#include "../mwworld/esmstore.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <list>
 
 namespace
 {
+    // Shortest paths between all pairs of points are precomputed for pathgrids up to this size,
+    // it takes size^2 memory and size^3 time.
+    constexpr std::size_t maxPointsToPrecomputePaths = 128;
+
     // See https://theory.stanford.edu/~amitp/GameProgramming/Heuristics.html
     //
     // One of the smallest cost in Seyda Neen is between points 77 & 78:
@@ -49,17 +52,6 @@ namespace
 
 namespace MWMechanics
 {
-    PathgridGraph::PathgridGraph(const MWWorld::CellStore *cell)
-        : mCell(nullptr)
-        , mPathgrid(nullptr)
-        , mGraph(0)
-        , mIsGraphConstructed(false)
-        , mSCCId(0)
-        , mSCCIndex(0)
-    {
-        load(cell);
-    }
-
     /*
      * mGraph is populated with the cost of each allowed edge.
      *
@@ -96,19 +88,13 @@ namespace MWMechanics
      *    +---------------->
      *      high cost
      */
-    bool PathgridGraph::load(const MWWorld::CellStore *cell)
+    PathgridGraph::PathgridGraph(const ESM::Pathgrid* pathgrid)
+        : mPathgrid(pathgrid)
+        , mSCCId(0)
+        , mSCCIndex(0)
     {
-        if(!cell)
-            return false;
-
-        if(mIsGraphConstructed)
-            return true;
-
-        mCell = cell->getCell();
-        mPathgrid = MWBase::Environment::get().getWorld()->getStore().get<ESM::Pathgrid>().search(*cell->getCell());
         if(!mPathgrid)
-            return false;
-
+            return;
 
         mGraph.resize(mPathgrid->mPoints.size());
         for(int i = 0; i < static_cast<int> (mPathgrid->mEdges.size()); i++)
@@ -125,8 +111,11 @@ namespace MWMechanics
             //mGraph[mPathgrid->mEdges[i].mV1].edges.push_back(neighbour);
         }
         buildConnectedPoints();
-        mIsGraphConstructed = true;
-        return true;
+        buildNextPoints();
+
+        // only needed to build the graph
+        mSCCStack = std::vector<int>();
+        mSCCPoint = std::vector<VPair>();
     }
 
     const ESM::Pathgrid *PathgridGraph::getPathgrid() const
@@ -213,6 +202,54 @@ namespace MWMechanics
         }
     }
 
+    /*
+     * Floyd-Warshall algorithm over mGraph edge costs. mNextPoints is left empty for big pathgrids, aStarSearch
+     * does the search for them.
+     */
+    void PathgridGraph::buildNextPoints()
+    {
+        const std::size_t size = mGraph.size();
+        if (size > maxPointsToPrecomputePaths)
+            return;
+
+        std::vector<float> costs(size * size, std::numeric_limits<float>::infinity());
+        mNextPoints.assign(size * size, -1);
+
+        for (std::size_t v = 0; v < size; ++v)
+        {
+            costs[v * size + v] = 0;
+            mNextPoints[v * size + v] = static_cast<int>(v);
+            for (const ConnectedPoint& edge : mGraph[v].edges)
+            {
+                const std::size_t w = static_cast<std::size_t>(edge.index);
+                if (edge.cost < costs[v * size + w])
+                {
+                    costs[v * size + w] = edge.cost;
+                    mNextPoints[v * size + w] = edge.index;
+                }
+            }
+        }
+
+        for (std::size_t k = 0; k < size; ++k)
+        {
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                const float costToK = costs[i * size + k];
+                if (costToK == std::numeric_limits<float>::infinity())
+                    continue;
+                for (std::size_t j = 0; j < size; ++j)
+                {
+                    const float cost = costToK + costs[k * size + j];
+                    if (cost < costs[i * size + j])
+                    {
+                        costs[i * size + j] = cost;
+                        mNextPoints[i * size + j] = mNextPoints[i * size + k];
+                    }
+                }
+            }
+        }
+    }
+
     bool PathgridGraph::isPointConnected(const int start, const int end) const
     {
         return (mGraph[start].componentId == mGraph[end].componentId);
@@ -263,6 +300,19 @@ namespace MWMechanics
             return path; // there is no path, return an empty path
         }
 
+        if(!mNextPoints.empty())
+        {
+            const std::size_t size = mGraph.size();
+            for(int current = start; ; current = mNextPoints[current * size + goal])
+            {
+                if(current == -1)
+                    return {};
+                path.push_back(mPathgrid->mPoints[current]);
+                if(current == goal)
+                    return path;
+            }
+        }
+
         int graphSize = static_cast<int> (mGraph.size());
         std::vector<float> gScore (graphSize, -1);
         std::vector<float> fScore (graphSize, -1);
@@ -336,5 +386,27 @@ namespace MWMechanics
         path.push_front(mPathgrid->mPoints[start]);
         return path;
     }
-}
 
+    PathgridGraphCache::PathgridGraphCache()
+        : mEmpty(std::make_shared<const PathgridGraph>(nullptr))
+    {
+    }
+
+    std::shared_ptr<const PathgridGraph> PathgridGraphCache::get(const ESM::Pathgrid* pathgrid)
+    {
+        if (pathgrid == nullptr)
+            return mEmpty;
+
+        {
+            const std::lock_guard lock(mMutex);
+            const auto it = mGraphs.find(pathgrid);
+            if (it != mGraphs.end())
+                return it->second;
+        }
+
+        // Build without lock to not block other threads, the first inserted graph wins
+        auto graph = std::make_shared<const PathgridGraph>(pathgrid);
+        const std::lock_guard lock(mMutex);
+        return mGraphs.emplace(pathgrid, std::move(graph)).first->second;
+    }
+}
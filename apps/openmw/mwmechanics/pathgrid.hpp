@@ -2,27 +2,19 @@
 #define GAME_MWMECHANICS_PATHGRID_H
 
 #include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
 
 #include <components/esm3/loadpgrd.hpp>
 
-namespace ESM
-{
-    struct Cell;
-}
-
-namespace MWWorld
-{
-    class CellStore;
-}
-
 namespace MWMechanics
 {
+    /// Graph is immutable after construction so it can be built in a background thread and shared.
     class PathgridGraph
     {
         public:
-            PathgridGraph(const MWWorld::CellStore* cell);
-
-            bool load(const MWWorld::CellStore *cell);
+            explicit PathgridGraph(const ESM::Pathgrid* pathgrid);
 
             const ESM::Pathgrid* getPathgrid() const;
 
@@ -37,12 +29,11 @@ namespace MWMechanics
             // the output list is in local (internal cells) or world (external
             // cells) coordinates
             //
-            // NOTE: if start equals end an empty path is returned
+            // NOTE: if start equals end a path with only the start point is returned
             std::deque<ESM::Pathgrid::Point> aStarSearch(const int start, const int end) const;
 
         private:
 
-            const ESM::Cell *mCell;
             const ESM::Pathgrid *mPathgrid;
 
             struct ConnectedPoint // edge
@@ -67,7 +58,10 @@ namespace MWMechanics
             //   all other pathgrid points are the third set
             //
             std::vector<Node> mGraph;
-            bool mIsGraphConstructed;
+
+            // For small pathgrids the next point of the shortest path is precomputed for each pair of points
+            // (mNextPoints[start * size + end]) so aStarSearch only has to follow it
+            std::vector<int> mNextPoints;
 
             // variables used to calculate connected components
             int mSCCId;
@@ -78,6 +72,24 @@ namespace MWMechanics
             // methods used to calculate connected components
             void recursiveStrongConnect(int v);
             void buildConnectedPoints();
+            void buildNextPoints();
+    };
+
+    /// Pathgrid graphs shared by the cell preloader building them in a background thread and AI packages.
+    /// Pathgrids can never change during runtime so graphs are kept until the cache is destroyed.
+    class PathgridGraphCache
+    {
+        public:
+            PathgridGraphCache();
+
+            /// Returns the cached graph or builds it in the calling thread. Thread safe.
+            /// @param pathgrid can be nullptr for cells without pathgrid, an empty graph is returned
+            std::shared_ptr<const PathgridGraph> get(const ESM::Pathgrid* pathgrid);
+
+        private:
+            std::mutex mMutex;
+            std::map<const ESM::Pathgrid*, std::shared_ptr<const PathgridGraph>> mGraphs;
+            const std::shared_ptr<const PathgridGraph> mEmpty;
     };
 }
 
@@ -105,6 +105,26 @@ namespace
             std::variant<std::monostate, std::unique_lock<Mutex>, std::shared_lock<Mutex>> mImpl;
     };
 
+    // Cached line of sight requests are refreshed by physics workers in batches taken under a shared lock, so
+    // getLineOfSight doesn't wait for the whole refresh
+    constexpr int sLOSBatchSize = 16;
+    // Rays between distant actors are cast less often, unless any of the actors moves noticeably
+    constexpr float sLOSRefreshDistanceStep = 1024;
+    constexpr std::size_t sMaxLOSRefreshInterval = 8;
+    constexpr float sLOSMovementThreshold = 32;
+
+    bool needsRefresh(const MWPhysics::LOSRequest& req, const osg::Vec3f& position1, const osg::Vec3f& position2,
+        std::size_t frame)
+    {
+        const std::size_t interval = std::min(sMaxLOSRefreshInterval,
+            1 + static_cast<std::size_t>((position1 - position2).length() / sLOSRefreshDistanceStep));
+        if (frame - req.mLastRefresh >= interval)
+            return true;
+        const float threshold2 = sLOSMovementThreshold * sLOSMovementThreshold;
+        return (position1 - req.mPositions[0]).length2() > threshold2
+            || (position2 - req.mPositions[1]).length2() > threshold2;
+    }
+
     bool isUnderWater(const MWPhysics::ActorFrameData& actorData)
     {
         return actorData.mPosition.z() < actorData.mSwimLevel;
@@ -322,6 +342,10 @@ namespace MWPhysics
           , mQuit(false)
           , mNextJob(0)
           , mNextLOS(0)
+          , mLOSHits(0)
+          , mLOSMisses(0)
+          , mLOSRefreshes(0)
+          , mBatchCounter(0)
           , mFrameNumber(0)
           , mTimer(osg::Timer::instance())
           , mPrevStepCount(1)
@@ -568,37 +592,78 @@ namespace MWPhysics
 
     bool PhysicsTaskScheduler::getLineOfSight(const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2)
     {
-        MaybeExclusiveLock lock(mLOSCacheMutex, mNumThreads);
-
         auto req = LOSRequest(actor1, actor2);
-        auto result = std::find(mLOSCache.begin(), mLOSCache.end(), req);
-        if (result == mLOSCache.end())
         {
-            req.mResult = hasLineOfSight(actor1.get(), actor2.get());
+            MaybeExclusiveLock lock(mLOSCacheMutex, mNumThreads);
+            const auto it = mLOSCacheIndex.find(req.mRawActors);
+            // the address of a removed actor may be reused by a new one
+            if (it != mLOSCacheIndex.end() && !mLOSCache[it->second].mActors[0].expired()
+                && !mLOSCache[it->second].mActors[1].expired())
+            {
+                LOSRequest& cached = mLOSCache[it->second];
+                cached.mAge = 0;
+                mLOSHits.fetch_add(1, std::memory_order_relaxed);
+                return cached.mResult;
+            }
+        }
+
+        mLOSMisses.fetch_add(1, std::memory_order_relaxed);
+        updateLOSRequest(req, *req.mRawActors[0], *req.mRawActors[1]);
+
+        MaybeExclusiveLock lock(mLOSCacheMutex, mNumThreads);
+        const auto [it, inserted] = mLOSCacheIndex.emplace(req.mRawActors, mLOSCache.size());
+        if (inserted)
             mLOSCache.push_back(req);
-            return req.mResult;
+        else
+            mLOSCache[it->second] = req;
+        return req.mResult;
+    }
+
+    void PhysicsTaskScheduler::reportStats(unsigned int frameNumber, osg::Stats& stats)
+    {
+        {
+            MaybeSharedLock lock(mLOSCacheMutex, mNumThreads);
+            stats.setAttribute(frameNumber, "Physics LOS Cache", mLOSCache.size());
         }
-        result->mAge = 0;
-        return result->mResult;
+        stats.setAttribute(frameNumber, "Physics LOS Hits", mLOSHits.exchange(0, std::memory_order_relaxed));
+        stats.setAttribute(frameNumber, "Physics LOS Misses", mLOSMisses.exchange(0, std::memory_order_relaxed));
+        stats.setAttribute(frameNumber, "Physics LOS Refreshes", mLOSRefreshes.exchange(0, std::memory_order_relaxed));
+    }
+
+    void PhysicsTaskScheduler::updateLOSRequest(LOSRequest& req, const Actor& actor1, const Actor& actor2)
+    {
+        req.mPositions = {actor1.getCollisionObjectPosition(), actor2.getCollisionObjectPosition()};
+        req.mResult = hasLineOfSight(&actor1, &actor2);
+        req.mLastRefresh = mFrameCounter;
     }
 
     void PhysicsTaskScheduler::refreshLOSCache()
     {
-        MaybeSharedLock lock(mLOSCacheMutex, mNumThreads);
-        int job = 0;
-        int numLOS = mLOSCache.size();
-        while ((job = mNextLOS.fetch_add(1, std::memory_order_relaxed)) < numLOS)
+        std::size_t refreshed = 0;
+        while (true)
         {
-            auto& req = mLOSCache[job];
-            auto actorPtr1 = req.mActors[0].lock();
-            auto actorPtr2 = req.mActors[1].lock();
-
-            if (req.mAge++ > mLOSCacheExpiry || !actorPtr1 || !actorPtr2)
-                req.mStale = true;
-            else
-                req.mResult = hasLineOfSight(actorPtr1.get(), actorPtr2.get());
+            const int begin = mNextLOS.fetch_add(sLOSBatchSize, std::memory_order_relaxed);
+            MaybeSharedLock lock(mLOSCacheMutex, mNumThreads);
+            const int end = std::min(begin + sLOSBatchSize, static_cast<int>(mLOSCache.size()));
+            if (begin >= end)
+                break;
+            for (int job = begin; job < end; ++job)
+            {
+                auto& req = mLOSCache[job];
+                auto actorPtr1 = req.mActors[0].lock();
+                auto actorPtr2 = req.mActors[1].lock();
+
+                if (req.mAge++ > mLOSCacheExpiry || !actorPtr1 || !actorPtr2)
+                    req.mStale = true;
+                else if (needsRefresh(req, actorPtr1->getCollisionObjectPosition(),
+                                      actorPtr2->getCollisionObjectPosition(), mFrameCounter))
+                {
+                    updateLOSRequest(req, *actorPtr1, *actorPtr2);
+                    ++refreshed;
+                }
+            }
         }
-
+        mLOSRefreshes.fetch_add(refreshed, std::memory_order_relaxed);
     }
 
     void PhysicsTaskScheduler::updateAabbs()
@@ -634,19 +699,79 @@ namespace MWPhysics
         }
     }
 
+    void PhysicsTaskScheduler::runBatch(std::size_t count, const std::function<void(std::size_t)>& job)
+    {
+        if (mNumThreads == 0)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                job(i);
+            return;
+        }
+
+        const auto batch = std::make_shared<Batch>(job, count);
+        {
+            std::lock_guard lock(mBatchMutex);
+            mBatch = batch;
+        }
+        // Workers busy with the simulation or missing the notification join later or never, the calling thread
+        // takes the jobs they don't
+        mBatchCounter.fetch_add(1, std::memory_order_release);
+        mHasJob.notify_all();
+
+        runBatchJobs(*batch);
+
+        {
+            std::unique_lock lock(batch->mMutex);
+            batch->mFinished.wait(lock, [&] { return batch->mDone == batch->mSize; });
+        }
+
+        std::lock_guard lock(mBatchMutex);
+        if (mBatch == batch)
+            mBatch = nullptr;
+    }
+
+    void PhysicsTaskScheduler::runBatchJobs(Batch& batch)
+    {
+        std::size_t done = 0;
+        for (std::size_t i; (i = batch.mNext.fetch_add(1, std::memory_order_relaxed)) < batch.mSize; ++done)
+            batch.mJob(i);
+        if (done == 0)
+            return;
+        std::lock_guard lock(batch.mMutex);
+        batch.mDone += done;
+        if (batch.mDone == batch.mSize)
+            batch.mFinished.notify_all();
+    }
+
     void PhysicsTaskScheduler::worker()
     {
         std::size_t lastFrame = 0;
+        std::size_t lastBatch = 0;
         std::shared_lock lock(mSimulationMutex);
         while (!mQuit)
         {
-            if (lastFrame == mFrameCounter)
+            mHasJob.wait(lock, [&] {
+                return mQuit || lastFrame != mFrameCounter
+                    || lastBatch != mBatchCounter.load(std::memory_order_acquire);
+            });
+
+            if (lastBatch != mBatchCounter.load(std::memory_order_acquire))
             {
-                mHasJob.wait(lock, [&] { return mQuit || lastFrame != mFrameCounter; });
-                lastFrame = mFrameCounter;
+                lastBatch = mBatchCounter.load(std::memory_order_acquire);
+                std::shared_ptr<Batch> batch;
+                {
+                    std::lock_guard batchLock(mBatchMutex);
+                    batch = mBatch;
+                }
+                if (batch != nullptr)
+                    runBatchJobs(*batch);
             }
 
-            doSimulation();
+            if (lastFrame != mFrameCounter)
+            {
+                lastFrame = mFrameCounter;
+                doSimulation();
+            }
         }
     }
 
@@ -753,10 +878,15 @@ namespace MWPhysics
     {
         {
             MaybeExclusiveLock lock(mLOSCacheMutex, mNumThreads);
-            mLOSCache.erase(
-                    std::remove_if(mLOSCache.begin(), mLOSCache.end(),
-                        [](const LOSRequest& req) { return req.mStale; }),
-                    mLOSCache.end());
+            const auto stale = std::remove_if(mLOSCache.begin(), mLOSCache.end(),
+                [](const LOSRequest& req) { return req.mStale; });
+            if (stale != mLOSCache.end())
+            {
+                mLOSCache.erase(stale, mLOSCache.end());
+                mLOSCacheIndex.clear();
+                for (std::size_t i = 0; i < mLOSCache.size(); ++i)
+                    mLOSCacheIndex.emplace(mLOSCache[i].mRawActors, i);
+            }
         }
         mTimeEnd = mTimer->tick();
 
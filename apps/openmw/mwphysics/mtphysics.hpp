@@ -1,11 +1,16 @@
 #ifndef OPENMW_MWPHYSICS_MTPHYSICS_H
 #define OPENMW_MWPHYSICS_MTPHYSICS_H
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <shared_mutex>
 #include <thread>
+#include <unordered_map>
 #include <unordered_set>
 #include <variant>
 
@@ -56,15 +61,35 @@ namespace MWPhysics
             void removeCollisionObject(btCollisionObject* collisionObject);
             void updateSingleAabb(const std::shared_ptr<PtrHolder>& ptr, bool immediate=false);
             bool getLineOfSight(const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2);
+            void reportStats(unsigned int frameNumber, osg::Stats& stats);
+
+            /// @brief run job for each index in [0, count) on the calling thread and idle physics workers
+            /// @note returns when all jobs are done, jobs should only read the collision world
+            void runBatch(std::size_t count, const std::function<void(std::size_t)>& job);
             void debugDraw();
             void* getUserPointer(const btCollisionObject* object) const;
             void releaseSharedStates(); // destroy all objects whose destructor can't be safely called from ~PhysicsTaskScheduler()
 
         private:
+            struct Batch
+            {
+                Batch(const std::function<void(std::size_t)>& job, std::size_t size)
+                    : mJob(job), mSize(size), mNext(0), mDone(0) {}
+
+                const std::function<void(std::size_t)>& mJob;
+                const std::size_t mSize;
+                std::atomic<std::size_t> mNext;
+                std::size_t mDone; // guarded by mMutex
+                std::mutex mMutex;
+                std::condition_variable mFinished;
+            };
+
             void doSimulation();
+            void runBatchJobs(Batch& batch);
             void worker();
             void updateActorsPositions();
             bool hasLineOfSight(const Actor* actor1, const Actor* actor2);
+            void updateLOSRequest(LOSRequest& req, const Actor& actor1, const Actor& actor2);
             void refreshLOSCache();
             void updateAabbs();
             void updatePtrAabb(const std::shared_ptr<PtrHolder>& ptr);
@@ -85,6 +110,7 @@ namespace MWPhysics
             btCollisionWorld* mCollisionWorld;
             MWRender::DebugDrawer* mDebugDrawer;
             std::vector<LOSRequest> mLOSCache;
+            std::unordered_map<std::array<const Actor*, 2>, std::size_t, LOSRequestKeyHash> mLOSCacheIndex; // to mLOSCache position
             std::set<std::weak_ptr<PtrHolder>, std::owner_less<std::weak_ptr<PtrHolder>>> mUpdateAabb;
 
             // TODO: use std::experimental::flex_barrier or std::barrier once it becomes a thing
@@ -101,8 +127,15 @@ namespace MWPhysics
             bool mQuit;
             std::atomic<int> mNextJob;
             std::atomic<int> mNextLOS;
+            std::atomic<std::size_t> mLOSHits;
+            std::atomic<std::size_t> mLOSMisses;
+            std::atomic<std::size_t> mLOSRefreshes;
             std::vector<std::thread> mThreads;
 
+            std::shared_ptr<Batch> mBatch;
+            std::atomic<std::size_t> mBatchCounter;
+            std::mutex mBatchMutex;
+
             std::size_t mWorkersFrameCounter = 0;
             std::condition_variable mWorkersDone;
             std::mutex mWorkersDoneMutex;
@@ -26,6 +26,7 @@
 #include <components/esm3/loadgmst.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/misc/convert.hpp>
+#include <components/misc/hash.hpp>
 #include <components/settings/settings.hpp>
 #include <components/nifosg/particle.hpp> // FindRecIndexVisitor
 
@@ -357,6 +358,22 @@ namespace MWPhysics
         return result;
     }
 
+    std::vector<RayCastingResult> PhysicsSystem::castRays(std::span<const RayCastingRequest> requests) const
+    {
+        std::vector<RayCastingResult> results(requests.size());
+        // The calling thread waits for the batch to finish, so the actor and object maps are not modified meanwhile
+        mTaskScheduler->runBatch(requests.size(), [&] (std::size_t i)
+        {
+            const RayCastingRequest& request = requests[i];
+            if (request.mRadius > 0)
+                results[i] = castSphere(request.mFrom, request.mTo, request.mRadius, request.mMask, request.mGroup);
+            else
+                results[i] = castRay(request.mFrom, request.mTo, request.mIgnore, std::vector<MWWorld::Ptr>(),
+                                     request.mMask, request.mGroup);
+        });
+        return results;
+    }
+
     bool PhysicsSystem::getLineOfSight(const MWWorld::ConstPtr &actor1, const MWWorld::ConstPtr &actor2) const
     {
         if (actor1 == actor2) return true;
@@ -946,6 +963,7 @@ namespace MWPhysics
         stats.setAttribute(frameNumber, "Physics Objects", mObjects.size());
         stats.setAttribute(frameNumber, "Physics Projectiles", mProjectiles.size());
         stats.setAttribute(frameNumber, "Physics HeightFields", mHeightFields.size());
+        mTaskScheduler->reportStats(frameNumber, stats);
     }
 
     void PhysicsSystem::reportCollision(const btVector3& position, const btVector3& normal)
@@ -993,7 +1011,7 @@ namespace MWPhysics
     {}
 
     LOSRequest::LOSRequest(const std::weak_ptr<Actor>& a1, const std::weak_ptr<Actor>& a2)
-        : mResult(false), mStale(false), mAge(0)
+        : mLastRefresh(0), mResult(false), mStale(false), mAge(0)
     {
         // we use raw actor pointer pair to uniquely identify request
         // sort the pointer value in ascending order to not duplicate equivalent requests, eg. getLOS(A, B) and getLOS(B, A)
@@ -1016,4 +1034,12 @@ namespace MWPhysics
     {
         return lhs.mRawActors == rhs.mRawActors;
     }
+
+    std::size_t LOSRequestKeyHash::operator()(const std::array<const Actor*, 2>& rawActors) const noexcept
+    {
+        std::size_t seed = 0;
+        Misc::hashCombine(seed, rawActors[0]);
+        Misc::hashCombine(seed, rawActors[1]);
+        return seed;
+    }
 }
@@ -72,12 +72,19 @@ namespace MWPhysics
         LOSRequest(const std::weak_ptr<Actor>& a1, const std::weak_ptr<Actor>& a2);
         std::array<std::weak_ptr<Actor>, 2> mActors;
         std::array<const Actor*, 2> mRawActors;
+        std::array<osg::Vec3f, 2> mPositions; // of the actors at the last ray test
+        std::size_t mLastRefresh; // physics frame of the last ray test
         bool mResult;
         bool mStale;
         int mAge;
     };
     bool operator==(const LOSRequest& lhs, const LOSRequest& rhs) noexcept;
 
+    struct LOSRequestKeyHash
+    {
+        std::size_t operator()(const std::array<const Actor*, 2>& rawActors) const noexcept;
+    };
+
     struct ActorFrameData
     {
         ActorFrameData(Actor& actor, bool inert, bool waterCollision, float slowFall, float waterlevel);
@@ -218,6 +225,8 @@ namespace MWPhysics
             RayCastingResult castSphere(const osg::Vec3f& from, const osg::Vec3f& to, float radius,
                     int mask = CollisionType_Default, int group=0xff) const override;
 
+            std::vector<RayCastingResult> castRays(std::span<const RayCastingRequest> requests) const override;
+
             /// Return true if actor1 can see actor2.
             bool getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const override;
 
@@ -1,6 +1,9 @@
 #ifndef OPENMW_MWPHYSICS_RAYCASTING_H
 #define OPENMW_MWPHYSICS_RAYCASTING_H
 
+#include <span>
+#include <vector>
+
 #include <osg/Vec3f>
 
 #include "../mwworld/ptr.hpp"
@@ -18,6 +21,16 @@ namespace MWPhysics
             MWWorld::Ptr mHitObject;
     };
 
+    struct RayCastingRequest
+    {
+        osg::Vec3f mFrom;
+        osg::Vec3f mTo;
+        float mRadius = 0; // casts a sphere when greater than zero
+        MWWorld::ConstPtr mIgnore; // not supported for spheres
+        int mMask = CollisionType_Default;
+        int mGroup = 0xff;
+    };
+
     class RayCastingInterface
     {
         public:
@@ -35,6 +48,10 @@ namespace MWPhysics
             virtual RayCastingResult castSphere(const osg::Vec3f& from, const osg::Vec3f& to, float radius,
                     int mask = CollisionType_Default, int group=0xff) const = 0;
 
+            /// Casts rays and spheres like castRay and castSphere, in parallel on the physics worker threads if there are any.
+            /// @return results in the order of requests.
+            virtual std::vector<RayCastingResult> castRays(std::span<const RayCastingRequest> requests) const = 0;
+
             /// Return true if actor1 can see actor2.
             virtual bool getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const = 0;
     };
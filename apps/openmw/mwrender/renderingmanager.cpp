@@ -42,6 +42,7 @@
 #include <components/sceneutil/writescene.hpp>
 #include <components/sceneutil/shadow.hpp>
 #include <components/sceneutil/rtt.hpp>
+#include <components/sceneutil/skinningqueue.hpp>
 
 #include <components/misc/constants.hpp>
 
@@ -542,6 +543,9 @@ namespace MWRender
         mStateUpdater = new StateUpdater;
         sceneRoot->addUpdateCallback(mStateUpdater);
 
+        if (const std::size_t skinningThreads = Settings::Manager::getThreadsCount("skinning threads", "General"); skinningThreads > 0)
+            sceneRoot->addCullCallback(new SceneUtil::SkinningQueue(skinningThreads));
+
         mSharedUniformStateUpdater = new SharedUniformStateUpdater(groundcover);
         rootNode->addUpdateCallback(mSharedUniformStateUpdater);
 
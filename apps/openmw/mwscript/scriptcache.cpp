@@ -0,0 +1,175 @@
+#include "scriptcache.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/serialization/binaryreader.hpp>
+#include <components/serialization/binarywriter.hpp>
+#include <components/serialization/format.hpp>
+#include <components/serialization/sizeaccumulator.hpp>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace MWScript
+{
+namespace
+{
+    constexpr char scriptCacheMagic[] = {'O', 'S', 'C', 'C'};
+    constexpr std::uint32_t scriptCacheVersion = 1;
+
+    struct ScriptCache
+    {
+        std::vector<MWWorld::ContentFileStamp> mContentFiles;
+        std::uint64_t mCompilerHash = 0;
+        std::vector<CachedScript> mScripts;
+    };
+
+    template <Serialization::Mode mode>
+    struct Format : Serialization::Format<mode, Format<mode>>
+    {
+        using Serialization::Format<mode, Format<mode>>::operator();
+
+        template <class Visitor, class T>
+        auto operator()(Visitor&& visitor, T& value) const
+            -> std::enable_if_t<std::is_same_v<std::decay_t<T>, std::string>>
+        {
+            if constexpr (mode == Serialization::Mode::Write)
+                visitor(*this, static_cast<std::uint64_t>(value.size()));
+            else
+            {
+                static_assert(mode == Serialization::Mode::Read);
+                std::uint64_t size = 0;
+                visitor(*this, size);
+                value.resize(static_cast<std::size_t>(size));
+            }
+            visitor(*this, value.data(), value.size());
+        }
+
+        template <class Visitor, class T>
+        auto operator()(Visitor&& visitor, T& value) const
+            -> std::enable_if_t<std::is_same_v<std::decay_t<T>, MWWorld::ContentFileStamp>>
+        {
+            visitor(*this, value.mPath);
+            visitor(*this, value.mSize);
+            visitor(*this, value.mModificationTime);
+        }
+
+        template <class Visitor, class T>
+        auto operator()(Visitor&& visitor, T& value) const
+            -> std::enable_if_t<std::is_same_v<std::decay_t<T>, CachedScript>>
+        {
+            visitor(*this, value.mId);
+            visitor(*this, value.mSourceHash);
+            visitor(*this, value.mByteCode);
+            visitor(*this, value.mShorts);
+            visitor(*this, value.mLongs);
+            visitor(*this, value.mFloats);
+        }
+
+        template <class Visitor, class T>
+        auto operator()(Visitor&& visitor, T& value) const
+            -> std::enable_if_t<std::is_same_v<std::decay_t<T>, ScriptCache>>
+        {
+            if constexpr (mode == Serialization::Mode::Write)
+            {
+                visitor(*this, scriptCacheMagic);
+                visitor(*this, scriptCacheVersion);
+            }
+            else
+            {
+                static_assert(mode == Serialization::Mode::Read);
+                char magic[std::size(scriptCacheMagic)];
+                visitor(*this, magic);
+                if (std::memcmp(magic, scriptCacheMagic, sizeof(magic)) != 0)
+                    throw std::runtime_error("Bad script cache magic");
+                std::uint32_t version = 0;
+                visitor(*this, version);
+                if (version != scriptCacheVersion)
+                    throw std::runtime_error("Bad script cache version");
+            }
+            visitor(*this, value.mContentFiles);
+            visitor(*this, value.mCompilerHash);
+            visitor(*this, value.mScripts);
+        }
+    };
+}
+
+    std::uint64_t getScriptSourceHash(std::string_view scriptText)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (char ch : scriptText)
+        {
+            hash ^= static_cast<unsigned char>(ch);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    std::optional<std::vector<CachedScript>> readScriptCache(const boost::filesystem::path& path,
+        const std::vector<MWWorld::ContentFileStamp>& contentFiles, std::uint64_t compilerHash)
+    {
+        boost::filesystem::ifstream stream(path, std::ios::binary);
+        if (!stream)
+            return std::nullopt;
+        const std::string content(std::istreambuf_iterator<char>(stream), {});
+        const auto* data = reinterpret_cast<const std::byte*>(content.data());
+
+        ScriptCache cache;
+        try
+        {
+            constexpr Format<Serialization::Mode::Read> format;
+            format(Serialization::BinaryReader(data, data + content.size()), cache);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Ignoring invalid script cache " << path << ": " << e.what();
+            return std::nullopt;
+        }
+
+        if (cache.mContentFiles != contentFiles || cache.mCompilerHash != compilerHash)
+        {
+            Log(Debug::Info) << "Script cache " << path << " is outdated";
+            return std::nullopt;
+        }
+
+        return std::move(cache.mScripts);
+    }
+
+    void writeScriptCache(const boost::filesystem::path& path,
+        const std::vector<MWWorld::ContentFileStamp>& contentFiles, std::uint64_t compilerHash,
+        const std::vector<CachedScript>& scripts)
+    {
+        ScriptCache cache;
+        cache.mContentFiles = contentFiles;
+        cache.mCompilerHash = compilerHash;
+        cache.mScripts = scripts;
+
+        constexpr Format<Serialization::Mode::Write> format;
+        Serialization::SizeAccumulator sizeAccumulator;
+        format(sizeAccumulator, cache);
+        std::vector<std::byte> data(sizeAccumulator.value());
+        format(Serialization::BinaryWriter(data.data(), data.data() + data.size()), cache);
+
+        // Write to a temporary file first so a crash doesn't leave a truncated cache behind
+        boost::filesystem::path temporaryPath = path;
+        temporaryPath += ".tmp";
+        try
+        {
+            {
+                boost::filesystem::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+                stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+                if (!stream)
+                    throw std::runtime_error("failed to write " + temporaryPath.string());
+            }
+            boost::filesystem::rename(temporaryPath, path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write script cache " << path << ": " << e.what();
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef GAME_SCRIPT_SCRIPTCACHE_H
+#define GAME_SCRIPT_SCRIPTCACHE_H
+
+#include <boost/filesystem/path.hpp>
+
+#include <components/interpreter/types.hpp>
+
+#include "../mwworld/refcountcache.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace MWScript
+{
+    /// Compiled script with the declarations of its local variables.
+    struct CachedScript
+    {
+        std::string mId;
+        std::uint64_t mSourceHash = 0;
+        std::vector<Interpreter::Type_Code> mByteCode;
+        std::vector<std::string> mShorts;
+        std::vector<std::string> mLongs;
+        std::vector<std::string> mFloats;
+    };
+
+    inline bool operator==(const CachedScript& l, const CachedScript& r)
+    {
+        return l.mId == r.mId && l.mSourceHash == r.mSourceHash && l.mByteCode == r.mByteCode
+            && l.mShorts == r.mShorts && l.mLongs == r.mLongs && l.mFloats == r.mFloats;
+    }
+
+    std::uint64_t getScriptSourceHash(std::string_view scriptText);
+
+    /// @return Scripts stored in the cache file or nothing if the file is missing, corrupted or was
+    /// written for different content files, compiler extensions or settings. Each script should still be used
+    /// only if its source hash matches the current script text.
+    std::optional<std::vector<CachedScript>> readScriptCache(const boost::filesystem::path& path,
+        const std::vector<MWWorld::ContentFileStamp>& contentFiles, std::uint64_t compilerHash);
+
+    /// Replaces the cache file atomically. Failures are logged and otherwise ignored.
+    void writeScriptCache(const boost::filesystem::path& path,
+        const std::vector<MWWorld::ContentFileStamp>& contentFiles, std::uint64_t compilerHash,
+        const std::vector<CachedScript>& scripts);
+}
+
+#endif
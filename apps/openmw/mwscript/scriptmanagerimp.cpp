@@ -4,6 +4,7 @@
 #include <sstream>
 #include <exception>
 #include <algorithm>
+#include <functional>
 
 #include <components/debug/debuglog.hpp>
 
@@ -14,21 +15,128 @@
 #include <components/compiler/scanner.hpp>
 #include <components/compiler/context.hpp>
 #include <components/compiler/exception.hpp>
+#include <components/compiler/extensions.hpp>
+#include <components/compiler/nullerrorhandler.hpp>
 #include <components/compiler/quickfileparser.hpp>
 
 #include "../mwworld/esmstore.hpp"
 
 #include "extensions.hpp"
 #include "interpretercontext.hpp"
+#include "scriptcache.hpp"
 
 namespace MWScript
 {
+namespace
+{
+    template <class T>
+    bool searchObjectScript(const MWWorld::ESMStore& store, const std::string& id, std::string_view& script)
+    {
+        const T* record = store.get<T>().searchStatic(id);
+        if (record == nullptr)
+            return false;
+        if constexpr (requires { record->mScript; })
+            script = record->mScript;
+        return true;
+    }
+
+    template <class ... T>
+    bool searchAnyObjectScript(const MWWorld::ESMStore& store, const std::string& id, std::string_view& script)
+    {
+        return (searchObjectScript<T>(store, id, script) || ...);
+    }
+
+    /// Compiler context for background threads. Uses only static records and resolves locals of other
+    /// scripts through a callback instead of the global environment. Matches CompilerContext of type
+    /// Type_Full for everything loaded from the content files.
+    class PrecompileContext : public Compiler::Context
+    {
+            const MWWorld::ESMStore& mStore;
+            std::function<Compiler::Locals (const ESM::Script&)> mGetLocals;
+
+        public:
+
+            PrecompileContext(const MWWorld::ESMStore& store, std::function<Compiler::Locals (const ESM::Script&)> getLocals)
+                : mStore(store), mGetLocals(std::move(getLocals))
+            {}
+
+            bool canDeclareLocals() const override
+            {
+                return true;
+            }
+
+            char getGlobalType(const std::string& name) const override
+            {
+                const ESM::Global* global = mStore.get<ESM::Global>().searchStatic(name);
+                if (global == nullptr)
+                    return ' ';
+                switch (global->mValue.getType())
+                {
+                    case ESM::VT_Short: return 's';
+                    case ESM::VT_Long: return 'l';
+                    case ESM::VT_Float: return 'f';
+                    default: return ' ';
+                }
+            }
+
+            std::pair<char, bool> getMemberType(const std::string& name, const std::string& id) const override
+            {
+                std::string_view script = id;
+                bool reference = false;
+
+                if (mStore.get<ESM::Script>().searchStatic(id) == nullptr)
+                {
+                    script = {};
+                    if (!searchAnyObjectScript<ESM::Activator, ESM::Potion, ESM::Apparatus, ESM::Armor, ESM::Book,
+                            ESM::Clothing, ESM::Container, ESM::Creature, ESM::Door, ESM::Ingredient,
+                            ESM::CreatureLevList, ESM::ItemLevList, ESM::Light, ESM::Lockpick, ESM::Miscellaneous,
+                            ESM::NPC, ESM::Probe, ESM::Repair, ESM::Static, ESM::Weapon, ESM::BodyPart>(mStore, id, script))
+                        throw std::logic_error("failed to create manual cell ref for " + id + " (unknown ID)");
+                    reference = true;
+                }
+
+                char type = ' ';
+
+                if (!script.empty())
+                {
+                    const ESM::Script* scriptRecord = mStore.get<ESM::Script>().searchStatic(script);
+                    if (scriptRecord == nullptr)
+                        throw std::logic_error("script " + std::string(script) + " does not exist");
+                    type = mGetLocals(*scriptRecord).getType(Misc::StringUtils::lowerCase(name));
+                }
+
+                return std::make_pair(type, reference);
+            }
+
+            bool isId(const std::string& name) const override
+            {
+                std::string_view script;
+                return searchAnyObjectScript<ESM::Activator, ESM::Potion, ESM::Apparatus, ESM::Armor, ESM::Book,
+                        ESM::Clothing, ESM::Container, ESM::Creature, ESM::Door, ESM::Ingredient,
+                        ESM::CreatureLevList, ESM::ItemLevList, ESM::Light, ESM::Lockpick, ESM::Miscellaneous,
+                        ESM::NPC, ESM::Probe, ESM::Repair, ESM::Static, ESM::Weapon, ESM::Script>(mStore, name, script);
+            }
+    };
+
+    Compiler::Locals makeLocals(const CachedScript& script)
+    {
+        Compiler::Locals result;
+        for (const std::string& name : script.mShorts)
+            result.declare('s', name);
+        for (const std::string& name : script.mLongs)
+            result.declare('l', name);
+        for (const std::string& name : script.mFloats)
+            result.declare('f', name);
+        return result;
+    }
+}
+
     ScriptManager::ScriptManager (const MWWorld::ESMStore& store,
         Compiler::Context& compilerContext, int warningsMode,
         const std::vector<std::string>& scriptBlacklist)
     : mErrorHandler(), mStore (store),
       mCompilerContext (compilerContext), mParser (mErrorHandler, mCompilerContext),
-      mOpcodesInstalled (false), mGlobalScripts (store)
+      mOpcodesInstalled (false), mWarningsMode (warningsMode), mGlobalScripts (store)
     {
         mErrorHandler.setWarningsMode (warningsMode);
 
@@ -39,6 +147,167 @@ namespace MWScript
         std::sort (mScriptBlacklist.begin(), mScriptBlacklist.end());
     }
 
+    ScriptManager::~ScriptManager()
+    {
+        stopPrecompiling();
+
+        if (mCachePath.empty() || !mCacheChanged)
+            return;
+
+        std::vector<CachedScript> scripts;
+        const auto addScript = [&] (const std::string& id, const CompiledScript& compiled)
+        {
+            // Failed scripts have no code and are compiled again by the next run
+            if (compiled.mByteCode.empty())
+                return;
+            const ESM::Script* script = mStore.get<ESM::Script>().searchStatic(id);
+            if (script == nullptr)
+                return;
+            scripts.push_back(CachedScript {script->mId, getScriptSourceHash(script->mScriptText), compiled.mByteCode,
+                compiled.mLocals.get('s'), compiled.mLocals.get('l'), compiled.mLocals.get('f')});
+        };
+        for (const auto& [id, compiled] : mScripts)
+            addScript(id, compiled);
+        for (const auto& [id, compiled] : mPrecompiled)
+            if (mScripts.find(id) == mScripts.end())
+                addScript(id, compiled);
+
+        writeScriptCache(mCachePath, mContentFiles, mCompilerHash, scripts);
+        Log(Debug::Info) << "Written " << scripts.size() << " compiled scripts to " << mCachePath;
+    }
+
+    void ScriptManager::loadCache(const boost::filesystem::path& path,
+        const std::vector<MWWorld::ContentFileStamp>& contentFiles)
+    {
+        mCachePath = path;
+        mContentFiles = contentFiles;
+        // Warnings may be treated as errors, so the same script may compile or fail depending on the mode
+        mCompilerHash = getExtensions().getHash() * 31 + static_cast<std::uint64_t>(mWarningsMode);
+
+        std::optional<std::vector<CachedScript>> scripts = readScriptCache(path, contentFiles, mCompilerHash);
+        if (!scripts.has_value())
+        {
+            mCacheChanged = true;
+            return;
+        }
+
+        std::size_t loaded = 0;
+        for (CachedScript& cached : *scripts)
+        {
+            const ESM::Script* script = mStore.get<ESM::Script>().searchStatic(cached.mId);
+            if (script == nullptr || getScriptSourceHash(script->mScriptText) != cached.mSourceHash)
+            {
+                mCacheChanged = true;
+                continue;
+            }
+            const Compiler::Locals locals = makeLocals(cached);
+            mScripts.emplace(cached.mId, CompiledScript(cached.mByteCode, locals));
+            ++loaded;
+        }
+
+        Log(Debug::Info) << "Loaded " << loaded << " compiled scripts from " << path;
+    }
+
+    void ScriptManager::startPrecompiling(std::size_t threadsCount)
+    {
+        stopPrecompiling();
+
+        mPrecompileQueue.clear();
+        for (const ESM::Script& script : mStore.get<ESM::Script>())
+            if (mScripts.find(script.mId) == mScripts.end() && mStore.get<ESM::Script>().searchStatic(script.mId) == &script)
+                mPrecompileQueue.push_back(&script);
+
+        if (mPrecompileQueue.empty() || threadsCount == 0)
+            return;
+
+        Log(Debug::Info) << "Compiling " << mPrecompileQueue.size() << " scripts in background using "
+            << threadsCount << " threads";
+
+        mNextPrecompiled = 0;
+        mStopPrecompiling = false;
+        for (std::size_t i = 0; i < threadsCount; ++i)
+            mPrecompileThreads.emplace_back([this] { precompile(); });
+    }
+
+    void ScriptManager::stopPrecompiling()
+    {
+        mStopPrecompiling = true;
+        for (std::thread& thread : mPrecompileThreads)
+            thread.join();
+        mPrecompileThreads.clear();
+    }
+
+    void ScriptManager::precompile()
+    {
+        Compiler::NullErrorHandler errorHandler;
+        errorHandler.setWarningsMode(mWarningsMode);
+        PrecompileContext context(mStore, [this] (const ESM::Script& script) { return getPrecompileLocals(script); });
+        context.setExtensions(mCompilerContext.getExtensions());
+        Compiler::FileParser parser(errorHandler, context);
+
+        while (!mStopPrecompiling)
+        {
+            const std::size_t index = mNextPrecompiled++;
+            if (index >= mPrecompileQueue.size())
+                break;
+
+            const ESM::Script& script = *mPrecompileQueue[index];
+            parser.reset();
+            errorHandler.reset();
+
+            try
+            {
+                std::istringstream input(script.mScriptText);
+                Compiler::Scanner scanner(errorHandler, input, context.getExtensions());
+                scanner.scan(parser);
+            }
+            catch (const std::exception&)
+            {
+                // Failures are reported when the script is compiled on demand
+                continue;
+            }
+
+            if (!errorHandler.isGood())
+                continue;
+
+            std::vector<Interpreter::Type_Code> code;
+            parser.getCode(code);
+            const std::lock_guard lock(mPrecompiledMutex);
+            mPrecompiled.emplace(script.mId, CompiledScript(code, parser.getLocals()));
+            mCacheChanged = true;
+        }
+    }
+
+    Compiler::Locals ScriptManager::getPrecompileLocals(const ESM::Script& script)
+    {
+        {
+            const std::lock_guard lock(mPrecompileLocalsMutex);
+            auto iter = mPrecompileLocals.find(script.mId);
+            if (iter != mPrecompileLocals.end())
+                return iter->second;
+        }
+
+        Compiler::NullErrorHandler errorHandler;
+        PrecompileContext context(mStore, [this] (const ESM::Script& other) { return getPrecompileLocals(other); });
+        context.setExtensions(mCompilerContext.getExtensions());
+
+        Compiler::Locals locals;
+        std::istringstream stream(script.mScriptText);
+        Compiler::QuickFileParser parser(errorHandler, context, locals);
+        Compiler::Scanner scanner(errorHandler, stream, context.getExtensions());
+        try
+        {
+            scanner.scan(parser);
+        }
+        catch (const std::exception&)
+        {
+            locals.clear();
+        }
+
+        const std::lock_guard lock(mPrecompileLocalsMutex);
+        return mPrecompileLocals.emplace(script.mId, std::move(locals)).first->second;
+    }
+
     bool ScriptManager::compile(std::string_view name)
     {
         mParser.reset();
@@ -46,6 +315,16 @@ namespace MWScript
 
         if (const ESM::Script *script = mStore.get<ESM::Script>().find (name))
         {
+            {
+                const std::lock_guard lock(mPrecompiledMutex);
+                auto iter = mPrecompiled.find(name);
+                if (iter != mPrecompiled.end())
+                {
+                    mScripts.insert(mPrecompiled.extract(iter));
+                    return true;
+                }
+            }
+
             mErrorHandler.setContext(script->mId);
 
             bool Success = true;
@@ -81,6 +360,7 @@ namespace MWScript
                 std::vector<Interpreter::Type_Code> code;
                 mParser.getCode(code);
                 mScripts.emplace(name, CompiledScript(code, mParser.getLocals()));
+                mCacheChanged = true;
 
                 return true;
             }
@@ -119,7 +399,10 @@ namespace MWScript
                     mOpcodesInstalled = true;
                 }
 
-                mInterpreter.run (&iter->second.mByteCode[0], iter->second.mByteCode.size(), interpreterContext);
+                if (!iter->second.mProgram.has_value())
+                    iter->second.mProgram = mInterpreter.prepare(iter->second.mByteCode.data(), iter->second.mByteCode.size());
+
+                mInterpreter.run (*iter->second.mProgram, interpreterContext);
                 return true;
             }
             catch (const MissingImplicitRefError& e)
@@ -1,9 +1,16 @@
 #ifndef GAME_SCRIPT_SCRIPTMANAGER_H
 #define GAME_SCRIPT_SCRIPTMANAGER_H
 
+#include <atomic>
+#include <cstdint>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <string>
+#include <thread>
+
+#include <boost/filesystem/path.hpp>
 
 #include <components/compiler/streamerrorhandler.hpp>
 #include <components/compiler/fileparser.hpp>
@@ -13,6 +20,8 @@
 
 #include "../mwbase/scriptmanager.hpp"
 
+#include "../mwworld/refcountcache.hpp"
+
 #include "globalscripts.hpp"
 
 namespace MWWorld
@@ -20,6 +29,11 @@ namespace MWWorld
     class ESMStore;
 }
 
+namespace ESM
+{
+    struct Script;
+}
+
 namespace Compiler
 {
     class Context;
@@ -41,10 +55,12 @@ namespace MWScript
             Compiler::FileParser mParser;
             Interpreter::Interpreter mInterpreter;
             bool mOpcodesInstalled;
+            int mWarningsMode;
 
             struct CompiledScript
             {
                 std::vector<Interpreter::Type_Code> mByteCode;
+                std::optional<Interpreter::Program> mProgram;
                 Compiler::Locals mLocals;
                 std::set<std::string> mInactive;
 
@@ -58,12 +74,42 @@ namespace MWScript
             std::unordered_map<std::string, Compiler::Locals, ::Misc::StringUtils::CiHash, ::Misc::StringUtils::CiEqual> mOtherLocals;
             std::vector<std::string> mScriptBlacklist;
 
+            boost::filesystem::path mCachePath;
+            std::vector<MWWorld::ContentFileStamp> mContentFiles;
+            std::uint64_t mCompilerHash = 0;
+            std::atomic_bool mCacheChanged {false};
+
+            // Scripts compiled in background, moved to mScripts when requested for the first time
+            std::vector<std::thread> mPrecompileThreads;
+            std::vector<const ESM::Script*> mPrecompileQueue;
+            std::atomic_size_t mNextPrecompiled {0};
+            std::atomic_bool mStopPrecompiling {false};
+            std::mutex mPrecompiledMutex;
+            std::unordered_map<std::string, CompiledScript, ::Misc::StringUtils::CiHash, ::Misc::StringUtils::CiEqual> mPrecompiled;
+            std::mutex mPrecompileLocalsMutex;
+            std::unordered_map<std::string, Compiler::Locals, ::Misc::StringUtils::CiHash, ::Misc::StringUtils::CiEqual> mPrecompileLocals;
+
+            void precompile();
+
+            Compiler::Locals getPrecompileLocals(const ESM::Script& script);
+
+            void stopPrecompiling();
+
         public:
 
             ScriptManager (const MWWorld::ESMStore& store,
                 Compiler::Context& compilerContext, int warningsMode,
                 const std::vector<std::string>& scriptBlacklist);
 
+            ~ScriptManager() override;
+
+            void loadCache(const boost::filesystem::path& path, const std::vector<MWWorld::ContentFileStamp>& contentFiles);
+            ///< Use scripts compiled by a previous run for the same content files. Scripts compiled during this
+            /// run are written back into the cache on destruction.
+
+            void startPrecompiling(std::size_t threadsCount);
+            ///< Compile all scripts missing in the cache in background.
+
             void clear() override;
 
             bool run(std::string_view name, Interpreter::Context& interpreterContext) override;
@@ -1,10 +1,12 @@
 #include "character.hpp"
 
+#include <algorithm>
 #include <cctype>
 #include <sstream>
 
 #include <boost/filesystem.hpp>
 
+#include <components/debug/debuglog.hpp>
 #include <components/esm3/esmreader.hpp>
 #include <components/esm/defs.hpp>
 
@@ -27,26 +29,66 @@ std::string MWState::getFirstGameFile(const std::vector<std::string>& contentFil
     return "";
 }
 
-void MWState::Character::addSlot (const boost::filesystem::path& path, const std::string& game)
+std::vector<char> MWState::loadScreenshot(const Slot& slot)
 {
-    Slot slot;
-    slot.mPath = path;
-    slot.mTimeStamp = boost::filesystem::last_write_time (path);
+    if (!slot.mProfile.mScreenshot.empty())
+        return slot.mProfile.mScreenshot;
 
     ESM::ESMReader reader;
     reader.open (slot.mPath.string());
 
     if (reader.getRecName()!=ESM::REC_SAVE)
-        return; // invalid save file -> ignore
+        throw std::runtime_error ("invalid save file");
 
     reader.getRecHeader();
 
-    slot.mProfile.load (reader);
+    ESM::SavedGame profile;
+    profile.load (reader);
+
+    return std::move(profile.mScreenshot);
+}
+
+bool MWState::Character::addSlot (const boost::filesystem::path& path, const std::string& game, SlotIndex& previousIndex)
+{
+    Slot slot;
+    slot.mPath = path;
+    slot.mTimeStamp = boost::filesystem::last_write_time (path);
+
+    bool indexed = false;
+
+    const std::string fileName = path.filename().string();
+    const auto entry = previousIndex.find(fileName);
+    if (entry != previousIndex.end() && isSlotIndexEntryValid(entry->second, path))
+    {
+        slot.mProfile = entry->second.mProfile;
+        mIndex.insert(previousIndex.extract(entry));
+        indexed = true;
+    }
+    else
+    {
+        ESM::ESMReader reader;
+        reader.open (slot.mPath.string());
+
+        if (reader.getRecName()!=ESM::REC_SAVE)
+            return false; // invalid save file -> ignore
+
+        reader.getRecHeader();
+
+        slot.mProfile.load (reader);
+
+        // Read by loadScreenshot when needed
+        slot.mProfile.mScreenshot = std::vector<char>();
+
+        // Saved games of other games are indexed too to not read them again
+        mIndex.insert_or_assign(fileName, makeSlotIndexEntry(path, slot.mProfile));
+    }
 
     if (!Misc::StringUtils::ciEqual(getFirstGameFile(slot.mProfile.mContentFiles), game))
-        return; // this file is for a different game -> ignore
+        return indexed; // this file is for a different game -> ignore
 
     mSlots.push_back (slot);
+
+    return indexed;
 }
 
 void MWState::Character::addSlot (const ESM::SavedGame& profile)
@@ -69,9 +111,14 @@ void MWState::Character::addSlot (const ESM::SavedGame& profile)
     const std::string ext = ".omwsave";
     slot.mPath = mPath / (stream.str() + ext);
 
-    // Append an index if necessary to ensure a unique file
+    // Append an index if necessary to ensure a unique file. Slot file may be not written yet.
+    const auto isUsed = [&] (const boost::filesystem::path& path)
+    {
+        return boost::filesystem::exists(path)
+            || std::any_of(mSlots.begin(), mSlots.end(), [&] (const Slot& v) { return v.mPath == path; });
+    };
     int i=0;
-    while (boost::filesystem::exists(slot.mPath))
+    while (isUsed(slot.mPath))
     {
         const std::string test = stream.str() + " - " + std::to_string(++i);
         slot.mPath = mPath / (test + ext);
@@ -92,29 +139,48 @@ MWState::Character::Character (const boost::filesystem::path& saves, const std::
     }
     else
     {
+        SlotIndex previousIndex = readSlotIndex (mPath / slotIndexFileName);
+        bool outdated = false;
+
         for (boost::filesystem::directory_iterator iter (mPath);
             iter!=boost::filesystem::directory_iterator(); ++iter)
         {
             boost::filesystem::path slotPath = *iter;
 
+            // Left by an interrupted save
+            if (slotPath.extension() == ".tmp" || slotPath.filename() == slotIndexFileName)
+                continue;
+
             try
             {
-                addSlot (slotPath, game);
+                if (!addSlot (slotPath, game, previousIndex))
+                    outdated = true;
+            }
+            catch (...) // ignoring bad saved game files for now
+            {
+                outdated = true;
             }
-            catch (...) {} // ignoring bad saved game files for now
         }
 
         std::sort (mSlots.begin(), mSlots.end());
+
+        // Left entries are of removed files
+        if (outdated || !previousIndex.empty())
+            updateIndex();
     }
 }
 
 void MWState::Character::cleanup()
 {
-    if (mSlots.size() == 0)
+    // Saved games of other games are still indexed
+    if (mSlots.size() == 0 && mIndex.empty())
     {
         // All slots are gone, no need to keep the empty directory
         if (boost::filesystem::is_directory (mPath))
         {
+            boost::system::error_code ec;
+            boost::filesystem::remove(mPath / slotIndexFileName, ec);
+
             // Extra safety check to make sure the directory is empty (e.g. slots failed to parse header)
             boost::filesystem::directory_iterator it(mPath);
             if (it == boost::filesystem::directory_iterator())
@@ -142,7 +208,11 @@ void MWState::Character::deleteSlot (const Slot *slot)
 
     boost::filesystem::remove(slot->mPath);
 
+    mIndex.erase(slot->mPath.filename().string());
+    mPendingWrites.erase(slot->mPath);
     mSlots.erase (mSlots.begin()+index);
+
+    updateIndex();
 }
 
 const MWState::Slot *MWState::Character::updateSlot (const Slot *slot, const ESM::SavedGame& profile)
@@ -166,6 +236,68 @@ const MWState::Slot *MWState::Character::updateSlot (const Slot *slot, const ESM
     return &mSlots.back();
 }
 
+void MWState::Character::restoreSlot (const boost::filesystem::path& path, const std::optional<Slot>& previous)
+{
+    const auto it = std::find_if(mSlots.begin(), mSlots.end(), [&] (const Slot& v) { return v.mPath == path; });
+    if (it == mSlots.end())
+        return;
+
+    if (previous.has_value())
+    {
+        mSlots.erase(it);
+        mSlots.insert(std::upper_bound(mSlots.begin(), mSlots.end(), *previous), *previous);
+    }
+    else if (!boost::filesystem::exists(path))
+        mSlots.erase(it);
+}
+
+void MWState::Character::startSlotWrite (const Slot& slot, const std::optional<Slot>& previous)
+{
+    // When the file is already being written, previous is the slot of the last pending write
+    const auto [it, inserted] = mPendingWrites.try_emplace(slot.mPath);
+    if (inserted)
+        it->second.mWritten = previous;
+    it->second.mSlots.push_back(slot);
+}
+
+void MWState::Character::finishSlotWrite (const boost::filesystem::path& path, bool succeeded)
+{
+    const auto it = mPendingWrites.find(path);
+    if (it == mPendingWrites.end())
+        return;
+
+    PendingWrites& writes = it->second;
+    if (succeeded)
+        writes.mWritten = std::move(writes.mSlots.front());
+    writes.mSlots.pop_front();
+
+    const std::string fileName = path.filename().string();
+    if (writes.mSlots.empty())
+    {
+        // A failed write leaves the file as it was, so is its entry
+        if (!succeeded)
+            restoreSlot(path, writes.mWritten);
+        else
+        {
+            try
+            {
+                mIndex.insert_or_assign(fileName, makeSlotIndexEntry(path, writes.mWritten->mProfile));
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to index saved game " << path << ": " << e.what();
+                mIndex.erase(fileName);
+            }
+        }
+        mPendingWrites.erase(it);
+    }
+    // The file may be already replaced by the next write, so the header can't be matched with the file
+    else if (succeeded)
+        mIndex.erase(fileName);
+
+    updateIndex();
+}
+
 MWState::Character::SlotIterator MWState::Character::begin() const
 {
     return mSlots.rbegin();
@@ -199,3 +331,15 @@ const boost::filesystem::path& MWState::Character::getPath() const
 {
     return mPath;
 }
+
+void MWState::Character::updateIndex() const
+{
+    try
+    {
+        writeSlotIndex (mPath / slotIndexFileName, mIndex);
+    }
+    catch (const std::exception& e)
+    {
+        Log(Debug::Warning) << "Failed to write saved games index for " << mPath << ": " << e.what();
+    }
+}
@@ -1,16 +1,22 @@
 #ifndef GAME_STATE_CHARACTER_H
 #define GAME_STATE_CHARACTER_H
 
+#include <deque>
+#include <map>
+#include <optional>
+
 #include <boost/filesystem/path.hpp>
 
 #include <components/esm3/savedgame.hpp>
 
+#include "slotindex.hpp"
+
 namespace MWState
 {
     struct Slot
     {
         boost::filesystem::path mPath;
-        ESM::SavedGame mProfile;
+        ESM::SavedGame mProfile; // screenshot is present only for slots created in this session
         std::time_t mTimeStamp;
     };
 
@@ -18,6 +24,9 @@ namespace MWState
 
     std::string getFirstGameFile(const std::vector<std::string>& contentFiles);
 
+    std::vector<char> loadScreenshot(const Slot& slot);
+    ///< Return screenshot of the slot profile or read it from the slot file.
+
     class Character
     {
         public:
@@ -26,10 +35,20 @@ namespace MWState
 
         private:
 
+            struct PendingWrites
+            {
+                std::optional<Slot> mWritten; // as the slot is in the file, empty if there is no file
+                std::deque<Slot> mSlots; // in the order they are written
+            };
+
             boost::filesystem::path mPath;
             std::vector<Slot> mSlots;
+            std::map<boost::filesystem::path, PendingWrites> mPendingWrites;
+            SlotIndex mIndex; // includes saved games of other games
 
-            void addSlot (const boost::filesystem::path& path, const std::string& game);
+            bool addSlot (const boost::filesystem::path& path, const std::string& game, SlotIndex& previousIndex);
+            ///< Move the entry of the slot file from \a previousIndex into the index or make a new one.
+            /// \return true if the slot header is taken from \a previousIndex.
 
             void addSlot (const ESM::SavedGame& profile);
 
@@ -55,6 +74,18 @@ namespace MWState
             ///
             /// \attention The \a slot pointer will be invalidated by this call.
 
+            void restoreSlot (const boost::filesystem::path& path, const std::optional<Slot>& previous);
+            ///< Replace the slot with the given path by \a previous, or remove it if \a previous is empty and
+            /// there is no slot file.
+
+            void startSlotWrite (const Slot& slot, const std::optional<Slot>& previous);
+            ///< Mark the slot file as being written in background, such slots are not indexed.
+            /// \param previous The slot as it is in the file before the write, empty if there is no file.
+
+            void finishSlotWrite (const boost::filesystem::path& path, bool succeeded);
+            ///< Finish the oldest write of the slot file and update the index. If the write failed and there
+            /// are no other writes of the file, restore the slot as it is in the file.
+
             SlotIterator begin() const;
             ///<  Any call to createSlot and updateSlot can invalidate the returned iterator.
 
@@ -62,6 +93,10 @@ namespace MWState
 
             const boost::filesystem::path& getPath() const;
 
+            void updateIndex() const;
+            ///< Write the index file. Entries are updated when a write of the slot file is finished, so files
+            /// being written keep their previous entries.
+
             ESM::SavedGame getSignature() const;
             ///< Return signature information for this character.
             ///
@@ -110,6 +110,13 @@ void MWState::CharacterManager::setCurrentCharacter (const Character *character)
     }
 }
 
+MWState::Character* MWState::CharacterManager::getCharacter (const boost::filesystem::path& path)
+{
+    for (Character& character : mCharacters)
+        if (character.getPath() == path)
+            return &character;
+    return nullptr;
+}
 
 std::list<MWState::Character>::const_iterator MWState::CharacterManager::begin() const
 {
@@ -42,6 +42,9 @@ namespace MWState
 
             void setCurrentCharacter (const Character *character);
 
+            Character* getCharacter (const boost::filesystem::path& path);
+            ///< Return the character with saved games in the given directory, null if there is none.
+
             std::list<Character>::const_iterator begin() const;
 
             std::list<Character>::const_iterator end() const;
@@ -0,0 +1,114 @@
+#include "savewriter.hpp"
+
+#include <stdexcept>
+
+#include <components/files/compressedstream.hpp>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+namespace
+{
+    void writeFile(const boost::filesystem::path& path, const std::string& data, bool compress)
+    {
+        // Write to a temporary file first to not trash the existing save if something goes wrong
+        boost::filesystem::path temporaryPath = path;
+        temporaryPath += ".tmp";
+
+        try
+        {
+            {
+                boost::filesystem::ofstream stream(temporaryPath, std::ios::binary);
+                if (compress)
+                    Files::writeCompressedStream(stream, data);
+                else
+                    stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+                stream.flush();
+                if (stream.fail())
+                    throw std::runtime_error("Write operation failed (file stream)");
+            }
+
+            boost::filesystem::rename(temporaryPath, path);
+        }
+        catch (...)
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove(temporaryPath, ec);
+            throw;
+        }
+    }
+}
+
+MWState::SaveWriter::SaveWriter()
+    : mThread([this] { run(); })
+{
+}
+
+MWState::SaveWriter::~SaveWriter()
+{
+    {
+        std::lock_guard lock(mMutex);
+        mShouldStop = true;
+    }
+    mHasJob.notify_all();
+    mThread.join();
+}
+
+void MWState::SaveWriter::push(const boost::filesystem::path& path, const std::string& description, std::string data,
+    bool compress, std::chrono::steady_clock::time_point start)
+{
+    {
+        std::lock_guard lock(mMutex);
+        mJobs.push_back(Job {path, description, std::move(data), compress, start});
+    }
+    mHasJob.notify_all();
+}
+
+void MWState::SaveWriter::wait()
+{
+    std::unique_lock lock(mMutex);
+    mIsIdle.wait(lock, [&] { return mJobs.empty() && !mWriting; });
+}
+
+std::vector<MWState::SaveWriterResult> MWState::SaveWriter::takeResults()
+{
+    std::vector<SaveWriterResult> result;
+    std::lock_guard lock(mMutex);
+    result.swap(mResults);
+    return result;
+}
+
+void MWState::SaveWriter::run()
+{
+    std::unique_lock lock(mMutex);
+    while (true)
+    {
+        // Pending saves are written even when stopping, the game may be quit right after saving
+        mHasJob.wait(lock, [&] { return mShouldStop || !mJobs.empty(); });
+        if (mJobs.empty())
+            break;
+
+        Job job = std::move(mJobs.front());
+        mJobs.pop_front();
+        mWriting = true;
+        lock.unlock();
+
+        std::string error;
+        try
+        {
+            writeFile(job.mPath, job.mData, job.mCompress);
+        }
+        catch (const std::exception& e)
+        {
+            error = e.what();
+        }
+
+        const auto duration = std::chrono::steady_clock::now() - job.mStart;
+
+        lock.lock();
+        mWriting = false;
+        mResults.push_back(SaveWriterResult {std::move(job.mPath), std::move(job.mDescription), std::move(error), duration});
+        if (mJobs.empty())
+            mIsIdle.notify_all();
+    }
+}
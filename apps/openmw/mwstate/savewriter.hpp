@@ -0,0 +1,68 @@
+#ifndef GAME_STATE_SAVEWRITER_H
+#define GAME_STATE_SAVEWRITER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem/path.hpp>
+
+namespace MWState
+{
+    struct SaveWriterResult
+    {
+        boost::filesystem::path mPath;
+        std::string mDescription;
+        std::string mError; // empty if the save is written
+        std::chrono::steady_clock::duration mDuration; // since the save is started
+    };
+
+    /// Writes serialized saved games into files in a background thread. Saves are written in the order they are
+    /// pushed, so when a file is saved several times the last save wins. An existing file is replaced only when the
+    /// new one is fully written.
+    class SaveWriter
+    {
+        public:
+            SaveWriter();
+
+            ~SaveWriter();
+            ///< Waits for all pushed saves to be written.
+
+            void push(const boost::filesystem::path& path, const std::string& description, std::string data,
+                bool compress, std::chrono::steady_clock::time_point start);
+            ///< \param compress write data as Files::CompressedStreamBuf readable by ESM::ESMReader.
+
+            void wait();
+            ///< Blocks until all pushed saves are written.
+
+            std::vector<SaveWriterResult> takeResults();
+            ///< Returns results of the saves finished since the last call.
+
+        private:
+            struct Job
+            {
+                boost::filesystem::path mPath;
+                std::string mDescription;
+                std::string mData;
+                bool mCompress;
+                std::chrono::steady_clock::time_point mStart;
+            };
+
+            std::mutex mMutex;
+            std::condition_variable mHasJob;
+            std::condition_variable mIsIdle;
+            std::deque<Job> mJobs;
+            bool mWriting = false;
+            bool mShouldStop = false;
+            std::vector<SaveWriterResult> mResults;
+            std::thread mThread;
+
+            void run();
+    };
+}
+
+#endif
@@ -0,0 +1,124 @@
+#include "slotindex.hpp"
+
+#include <stdexcept>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <components/debug/debuglog.hpp>
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+
+#include "../mwworld/refcountcache.hpp"
+
+MWState::SlotIndex MWState::readSlotIndex(const boost::filesystem::path& path)
+{
+    if (!boost::filesystem::exists(path))
+        return {};
+
+    try
+    {
+        ESM::ESMReader reader;
+        reader.open(path.string());
+
+        // Profile layout depends on the format, index is rebuilt after update
+        if (reader.getFormat() != ESM::SavedGame::sCurrentFormat)
+            return {};
+
+        SlotIndex result;
+        while (reader.hasMoreRecs())
+        {
+            if (reader.getRecName() != ESM::REC_SAVE)
+                throw std::runtime_error("Unexpected record");
+
+            reader.getRecHeader();
+
+            const std::string fileName = reader.getHNString("FILE");
+            SlotIndexEntry entry;
+            reader.getHNT(entry.mFileSize, "SIZE");
+            // Entries of indices with time stamps in seconds don't match and are replaced
+            reader.getHNT(entry.mModificationTime, "MTIM");
+            entry.mProfile.load(reader);
+
+            result.emplace(fileName, std::move(entry));
+        }
+        return result;
+    }
+    catch (const std::exception& e)
+    {
+        Log(Debug::Warning) << "Failed to read saved games index " << path << ": " << e.what();
+        return {};
+    }
+}
+
+void MWState::writeSlotIndex(const boost::filesystem::path& path, const SlotIndex& index)
+{
+    ESM::ESMWriter writer;
+
+    writer.setFormat(ESM::SavedGame::sCurrentFormat);
+
+    // all unused
+    writer.setVersion(0);
+    writer.setType(0);
+    writer.setAuthor("");
+    writer.setDescription("");
+
+    writer.setRecordCount(static_cast<int>(index.size()));
+
+    boost::filesystem::path temporaryPath = path;
+    temporaryPath += ".tmp";
+
+    try
+    {
+        {
+            boost::filesystem::ofstream stream(temporaryPath, std::ios::binary);
+
+            writer.save(stream);
+
+            for (const auto& [fileName, entry] : index)
+            {
+                writer.startRecord(ESM::REC_SAVE);
+                writer.writeHNString("FILE", fileName);
+                writer.writeHNT("SIZE", entry.mFileSize);
+                writer.writeHNT("MTIM", entry.mModificationTime);
+                entry.mProfile.save(writer);
+                writer.endRecord(ESM::REC_SAVE);
+            }
+
+            writer.close();
+
+            stream.flush();
+            if (stream.fail())
+                throw std::runtime_error("Write operation failed (file stream)");
+        }
+
+        boost::filesystem::rename(temporaryPath, path);
+    }
+    catch (...)
+    {
+        boost::system::error_code ec;
+        boost::filesystem::remove(temporaryPath, ec);
+        throw;
+    }
+}
+
+MWState::SlotIndexEntry MWState::makeSlotIndexEntry(const boost::filesystem::path& path, const ESM::SavedGame& profile)
+{
+    const MWWorld::ContentFileStamp stamp = MWWorld::makeContentFileStamp(path);
+    SlotIndexEntry result {stamp.mSize, stamp.mModificationTime, profile};
+    result.mProfile.mScreenshot = std::vector<char>();
+    return result;
+}
+
+bool MWState::isSlotIndexEntryValid(const SlotIndexEntry& entry, const boost::filesystem::path& path)
+{
+    try
+    {
+        const MWWorld::ContentFileStamp stamp = MWWorld::makeContentFileStamp(path);
+        return entry.mFileSize == stamp.mSize && entry.mModificationTime == stamp.mModificationTime;
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef GAME_STATE_SLOTINDEX_H
+#define GAME_STATE_SLOTINDEX_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include <boost/filesystem/path.hpp>
+
+#include <components/esm3/savedgame.hpp>
+
+namespace MWState
+{
+    /// Saved game header cached to not open the file when the saves directory is scanned. Valid as long as the
+    /// file has the same size and modification time.
+    struct SlotIndexEntry
+    {
+        std::uint64_t mFileSize;
+        std::int64_t mModificationTime; // in nanoseconds, to notice a save made within a second
+        ESM::SavedGame mProfile; // without screenshot
+    };
+
+    /// Entries by file name of the saved game.
+    using SlotIndex = std::map<std::string, SlotIndexEntry>;
+
+    /// File name of the index inside the character saves directory.
+    constexpr char slotIndexFileName[] = "saves.index";
+
+    SlotIndex readSlotIndex(const boost::filesystem::path& path);
+    ///< Returns empty index if the file does not exist, is invalid or written for other saved game format.
+
+    void writeSlotIndex(const boost::filesystem::path& path, const SlotIndex& index);
+    ///< Replaces the existing file only when the new one is fully written.
+
+    SlotIndexEntry makeSlotIndexEntry(const boost::filesystem::path& path, const ESM::SavedGame& profile);
+    ///< Uses the current size and modification time of the file, drops the screenshot. Throws if the file is
+    /// not accessible.
+
+    bool isSlotIndexEntryValid(const SlotIndexEntry& entry, const boost::filesystem::path& path);
+    ///< Returns false if the file is changed since the entry is made or is not accessible.
+}
+
+#endif
@@ -17,7 +17,6 @@
 
 #include <osgDB/Registry>
 
-#include <boost/filesystem/fstream.hpp>
 #include <boost/filesystem/operations.hpp>
 
 #include "../mwbase/environment.hpp"
@@ -187,6 +186,8 @@ void MWState::StateManager::resumeGame()
 void MWState::StateManager::saveGame (const std::string& description, const Slot *slot)
 {
     MWState::Character* character = getCurrentCharacter();
+    std::optional<Slot> previousSlot;
+    bool pushed = false;
 
     try
     {
@@ -231,7 +232,10 @@ void MWState::StateManager::saveGame (const std::string& description, const Slot
         if (!slot)
             slot = character->createSlot (profile);
         else
+        {
+            previousSlot = *slot;
             slot = character->updateSlot (slot, profile);
+        }
 
         // Make sure the animation state held by references is up to date before saving the game.
         MWBase::Environment::get().getMechanicsManager()->persistAnimationStates();
@@ -299,41 +303,45 @@ void MWState::StateManager::saveGame (const std::string& description, const Slot
         if (stream.fail())
             throw std::runtime_error("Write operation failed (memory stream)");
 
-        // All good, write to file
-        boost::filesystem::ofstream filestream (slot->mPath, std::ios::binary);
-        filestream << stream.rdbuf();
-
-        if (filestream.fail())
-            throw std::runtime_error("Write operation failed (file stream)");
+        // All good, write to file in background
+        mSaveWriter.push(slot->mPath, description, std::move(stream).str(),
+            Settings::Manager::getBool("compress", "Saves"), start);
+        character->startSlotWrite(*slot, previousSlot);
+        pushed = true;
 
         Settings::Manager::setString ("character", "Saves",
             slot->mPath.parent_path().filename().string());
 
         const auto finish = std::chrono::steady_clock::now();
 
-        Log(Debug::Info) << '\'' << description << "' is saved in "
+        Log(Debug::Info) << '\'' << description << "' is serialized in "
             << std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(finish - start).count() << "ms";
     }
     catch (const std::exception& e)
     {
-        std::stringstream error;
-        error << "Failed to save game: " << e.what();
-
-        Log(Debug::Error) << error.str();
+        reportSaveError(e.what());
 
-        std::vector<std::string> buttons;
-        buttons.emplace_back("#{sOk}");
-        MWBase::Environment::get().getWindowManager()->interactiveMessageBox(error.str(), buttons);
-
-        // If no file was written, clean up the slot
-        if (character && slot && !boost::filesystem::exists(slot->mPath))
+        // Nothing is written, so the slot file is as it was before the save
+        if (slot != nullptr && !pushed)
         {
-            character->deleteSlot(slot);
+            character->restoreSlot(slot->mPath, previousSlot);
             character->cleanup();
         }
     }
 }
 
+void MWState::StateManager::reportSaveError (const std::string& message)
+{
+    std::stringstream error;
+    error << "Failed to save game: " << message;
+
+    Log(Debug::Error) << error.str();
+
+    std::vector<std::string> buttons;
+    buttons.emplace_back("#{sOk}");
+    MWBase::Environment::get().getWindowManager()->interactiveMessageBox(error.str(), buttons);
+}
+
 void MWState::StateManager::quickSave (std::string name)
 {
     if (!(mState==State_Running &&
@@ -388,6 +396,9 @@ void MWState::StateManager::loadGame (const Character *character, const std::str
 {
     try
     {
+        // The file may be not written yet
+        mSaveWriter.wait();
+
         cleanup();
 
         Log(Debug::Info) << "Reading save file " << std::filesystem::path(filepath).filename().string();
@@ -601,6 +612,7 @@ void MWState::StateManager::quickLoad()
 
 void MWState::StateManager::deleteGame(const MWState::Character *character, const MWState::Slot *slot)
 {
+    mSaveWriter.wait();
     mCharacterManager.deleteSlot(character, slot);
 }
 
@@ -623,6 +635,26 @@ void MWState::StateManager::update (float duration)
 {
     mTimePlayed += duration;
 
+    for (const SaveWriterResult& result : mSaveWriter.takeResults())
+    {
+        Character* character = mCharacterManager.getCharacter(result.mPath.parent_path());
+        if (!result.mError.empty())
+        {
+            reportSaveError(result.mError);
+            // The slot file is left as it was before the save, so is the slot
+            if (character != nullptr)
+            {
+                character->finishSlotWrite(result.mPath, false);
+                character->cleanup();
+            }
+            continue;
+        }
+        if (character != nullptr)
+            character->finishSlotWrite(result.mPath, true);
+        Log(Debug::Info) << '\'' << result.mDescription << "' is saved in "
+            << std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(result.mDuration).count() << "ms";
+    }
+
     // Note: It would be nicer to trigger this from InputManager, i.e. the very beginning of the frame update.
     if (mAskLoadRecent)
     {
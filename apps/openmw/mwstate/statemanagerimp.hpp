@@ -8,6 +8,7 @@
 #include <boost/filesystem/path.hpp>
 
 #include "charactermanager.hpp"
+#include "savewriter.hpp"
 
 namespace MWState
 {
@@ -18,6 +19,7 @@ namespace MWState
             State mState;
             CharacterManager mCharacterManager;
             double mTimePlayed;
+            SaveWriter mSaveWriter;
 
         private:
 
@@ -27,6 +29,8 @@ namespace MWState
 
             void writeScreenshot (std::vector<char>& imageData) const;
 
+            void reportSaveError (const std::string& message);
+
             std::map<int, int> buildContentFileIndexMap (const ESM::ESMReader& reader) const;
 
         public:
@@ -57,6 +61,7 @@ namespace MWState
             ///< Write a saved game to \a slot or create a new slot if \a slot == 0.
             ///
             /// \note Slot must belong to the current character.
+            /// \note The game state is serialized immediately, the file is written in a background thread.
 
             ///Saves a file, using supplied filename, overwritting if needed
             /** This is mostly used for quicksaving and autosaving, for they use the same name over and over again
@@ -16,10 +16,16 @@
 #include <components/esm3/loadcell.hpp>
 #include <components/loadinglistener/reporter.hpp>
 
+#include "../mwbase/environment.hpp"
+#include "../mwbase/world.hpp"
+
+#include "../mwmechanics/pathgrid.hpp"
+
 #include "../mwrender/landmanager.hpp"
 
 #include "cellstore.hpp"
 #include "class.hpp"
+#include "esmstore.hpp"
 
 namespace
 {
@@ -71,7 +77,7 @@ namespace MWWorld
     {
     public:
         /// Constructor to be called from the main thread.
-        PreloadItem(MWWorld::CellStore* cell, Resource::SceneManager* sceneManager, Resource::BulletShapeManager* bulletShapeManager, Resource::KeyframeManager* keyframeManager, Terrain::World* terrain, MWRender::LandManager* landManager, bool preloadInstances)
+        PreloadItem(MWWorld::CellStore* cell, Resource::SceneManager* sceneManager, Resource::BulletShapeManager* bulletShapeManager, Resource::KeyframeManager* keyframeManager, Terrain::World* terrain, MWRender::LandManager* landManager, MWMechanics::PathgridGraphCache* pathgridGraphCache, bool preloadInstances)
             : mIsExterior(cell->getCell()->isExterior())
             , mX(cell->getCell()->getGridX())
             , mY(cell->getCell()->getGridY())
@@ -80,6 +86,8 @@ namespace MWWorld
             , mKeyframeManager(keyframeManager)
             , mTerrain(terrain)
             , mLandManager(landManager)
+            , mPathgridGraphCache(pathgridGraphCache)
+            , mPathgrid(MWBase::Environment::get().getWorld()->getStore().get<ESM::Pathgrid>().search(*cell->getCell()))
             , mPreloadInstances(preloadInstances)
             , mAbort(false)
         {
@@ -97,6 +105,20 @@ namespace MWWorld
         /// Preload work to be called from the worker thread.
         void doWork() override
         {
+            // AI needs the graph as soon as the cell is loaded, build it before the meshes to have it ready if the
+            // preloading is aborted
+            if (mPathgrid != nullptr)
+            {
+                try
+                {
+                    mPathgridGraphCache->get(mPathgrid);
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Warning) << "Failed to preload pathgrid graph: " << e.what();
+                }
+            }
+
             if (mIsExterior)
             {
                 try
@@ -159,6 +181,8 @@ namespace MWWorld
         Resource::KeyframeManager* mKeyframeManager;
         Terrain::World* mTerrain;
         MWRender::LandManager* mLandManager;
+        MWMechanics::PathgridGraphCache* mPathgridGraphCache;
+        const ESM::Pathgrid* mPathgrid;
         bool mPreloadInstances;
 
         std::atomic<bool> mAbort;
@@ -228,11 +252,12 @@ namespace MWWorld
         Resource::ResourceSystem* mResourceSystem;
     };
 
-    CellPreloader::CellPreloader(Resource::ResourceSystem* resourceSystem, Resource::BulletShapeManager* bulletShapeManager, Terrain::World* terrain, MWRender::LandManager* landManager)
+    CellPreloader::CellPreloader(Resource::ResourceSystem* resourceSystem, Resource::BulletShapeManager* bulletShapeManager, Terrain::World* terrain, MWRender::LandManager* landManager, MWMechanics::PathgridGraphCache* pathgridGraphCache)
         : mResourceSystem(resourceSystem)
         , mBulletShapeManager(bulletShapeManager)
         , mTerrain(terrain)
         , mLandManager(landManager)
+        , mPathgridGraphCache(pathgridGraphCache)
         , mExpiryDelay(0.0)
         , mMinCacheSize(0)
         , mMaxCacheSize(0)
@@ -311,7 +336,7 @@ namespace MWWorld
                 return;
         }
 
-        osg::ref_ptr<PreloadItem> item (new PreloadItem(cell, mResourceSystem->getSceneManager(), mBulletShapeManager, mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPreloadInstances));
+        osg::ref_ptr<PreloadItem> item (new PreloadItem(cell, mResourceSystem->getSceneManager(), mBulletShapeManager, mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPathgridGraphCache, mPreloadInstances));
         mWorkQueue->addWorkItem(item);
 
         mPreloadCells[cell] = PreloadEntry(timestamp, item);
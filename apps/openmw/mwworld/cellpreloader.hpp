@@ -29,6 +29,11 @@ namespace Loading
     class Listener;
 }
 
+namespace MWMechanics
+{
+    class PathgridGraphCache;
+}
+
 namespace MWWorld
 {
     class CellStore;
@@ -37,10 +42,10 @@ namespace MWWorld
     class CellPreloader
     {
     public:
-        CellPreloader(Resource::ResourceSystem* resourceSystem, Resource::BulletShapeManager* bulletShapeManager, Terrain::World* terrain, MWRender::LandManager* landManager);
+        CellPreloader(Resource::ResourceSystem* resourceSystem, Resource::BulletShapeManager* bulletShapeManager, Terrain::World* terrain, MWRender::LandManager* landManager, MWMechanics::PathgridGraphCache* pathgridGraphCache);
         ~CellPreloader();
 
-        /// Ask a background thread to preload rendering meshes and collision shapes for objects in this cell.
+        /// Ask a background thread to preload rendering meshes, collision shapes for objects and pathgrid graph for this cell.
         /// @note The cell itself must be in State_Loaded or State_Preloaded.
         void preload(MWWorld::CellStore* cell, double timestamp);
 
@@ -79,6 +84,7 @@ namespace MWWorld
         Resource::BulletShapeManager* mBulletShapeManager;
         Terrain::World* mTerrain;
         MWRender::LandManager* mLandManager;
+        MWMechanics::PathgridGraphCache* mPathgridGraphCache;
         osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
         double mExpiryDelay;
         unsigned int mMinCacheSize;
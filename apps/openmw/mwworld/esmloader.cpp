@@ -1,8 +1,13 @@
 #include "esmloader.hpp"
 #include "esmstore.hpp"
 
+#include <algorithm>
+#include <memory>
+
+#include <components/debug/debuglog.hpp>
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/readerscache.hpp>
+#include <components/to_utf8/to_utf8.hpp>
 
 namespace MWWorld
 {
@@ -15,6 +20,67 @@ EsmLoader::EsmLoader(MWWorld::ESMStore& store, ESM::ReadersCache& readers, ToUTF
 {
 }
 
+EsmLoader::~EsmLoader()
+{
+    stopParsing();
+}
+
+void EsmLoader::startParsing(std::vector<std::pair<int, boost::filesystem::path>> files, std::size_t threadsCount)
+{
+    stopParsing();
+
+    mParseTasks.clear();
+    mParsedFiles.clear();
+    mParseTasks.reserve(files.size());
+    for (auto& [index, path] : files)
+    {
+        ParseTask& task = mParseTasks.emplace_back(ParseTask {index, std::move(path), {}});
+        mParsedFiles.emplace(index, task.mResult.get_future());
+    }
+    mNextParseTask = 0;
+
+    threadsCount = std::min(threadsCount, mParseTasks.size());
+    Log(Debug::Info) << "Parsing " << mParseTasks.size() << " content files using " << threadsCount << " threads";
+
+    // Encoder keeps an internal buffer, so each thread needs its own copy
+    for (std::size_t i = 0; i < threadsCount; ++i)
+    {
+        std::shared_ptr<ToUTF8::Utf8Encoder> encoder;
+        if (mEncoder != nullptr)
+            encoder = std::make_shared<ToUTF8::Utf8Encoder>(*mEncoder);
+        mParseThreads.emplace_back([this, encoder] { parse(encoder.get()); });
+    }
+}
+
+void EsmLoader::parse(ToUTF8::Utf8Encoder* encoder)
+{
+    for (std::size_t i = mNextParseTask++; i < mParseTasks.size(); i = mNextParseTask++)
+    {
+        ParseTask& task = mParseTasks[i];
+        try
+        {
+            ESM::ESMReader reader;
+            reader.setEncoder(encoder);
+            reader.setIndex(task.mIndex);
+            reader.open(task.mPath.string());
+            task.mResult.set_value(mStore.parse(reader));
+        }
+        catch (...)
+        {
+            task.mResult.set_exception(std::current_exception());
+        }
+    }
+}
+
+void EsmLoader::stopParsing()
+{
+    // Skip files that are not started yet, for example when loading has failed
+    mNextParseTask = mParseTasks.size();
+    for (std::thread& thread : mParseThreads)
+        thread.join();
+    mParseThreads.clear();
+}
+
 void EsmLoader::load(const boost::filesystem::path& filepath, int& index, Loading::Listener* listener)
 {
     const ESM::ReadersCache::BusyItem reader = mReaders.get(static_cast<std::size_t>(index));
@@ -32,7 +98,14 @@ void EsmLoader::load(const boost::filesystem::path& filepath, int& index, Loadin
                 + ", but it is not available or has been loaded in the wrong order. "
                   "Please run the launcher to fix this issue.");
 
-    mStore.load(*reader, listener, mDialogue);
+    if (const auto it = mParsedFiles.find(index); it != mParsedFiles.end())
+    {
+        ESMStore::ParsedContentFile parsed = it->second.get();
+        mParsedFiles.erase(it);
+        mStore.load(*reader, listener, mDialogue, &parsed);
+    }
+    else
+        mStore.load(*reader, listener, mDialogue);
 
     if (!mMasterFileFormat.has_value() && (Misc::StringUtils::ciEndsWith(reader->getName(), ".esm")
                                            || Misc::StringUtils::ciEndsWith(reader->getName(), ".omwgame")))
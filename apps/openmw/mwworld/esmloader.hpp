@@ -1,9 +1,16 @@
 #ifndef ESMLOADER_HPP
 #define ESMLOADER_HPP
 
+#include <atomic>
+#include <future>
+#include <map>
 #include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "contentloader.hpp"
+#include "esmstore.hpp"
 
 namespace ToUTF8
 {
@@ -19,22 +26,42 @@ namespace ESM
 namespace MWWorld
 {
 
-class ESMStore;
-
 struct EsmLoader : public ContentLoader
 {
     explicit EsmLoader(MWWorld::ESMStore& store, ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder);
 
+    ~EsmLoader();
+
     std::optional<int> getMasterFileFormat() const { return mMasterFileFormat; }
 
+    /// Start parsing the given content files on background threads. load() then waits for the
+    /// parsed records of a file and only merges them into the store in load order.
+    /// @param files Content file indices and paths
+    void startParsing(std::vector<std::pair<int, boost::filesystem::path>> files, std::size_t threadsCount);
+
     void load(const boost::filesystem::path& filepath, int& index, Loading::Listener* listener) override;
 
     private:
+        struct ParseTask
+        {
+            int mIndex;
+            boost::filesystem::path mPath;
+            std::promise<ESMStore::ParsedContentFile> mResult;
+        };
+
         ESM::ReadersCache& mReaders;
         MWWorld::ESMStore& mStore;
         ToUTF8::Utf8Encoder* mEncoder;
         ESM::Dialogue* mDialogue;
         std::optional<int> mMasterFileFormat;
+        std::vector<ParseTask> mParseTasks;
+        std::atomic_size_t mNextParseTask {0};
+        std::map<int, std::future<ESMStore::ParsedContentFile>> mParsedFiles;
+        std::vector<std::thread> mParseThreads;
+
+        void parse(ToUTF8::Utf8Encoder* encoder);
+
+        void stopParsing();
 };
 
 } /* namespace MWWorld */
@@ -144,7 +144,29 @@ static bool isCacheableRecord(int id)
     return false;
 }
 
-void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener, ESM::Dialogue*& dialogue)
+ESMStore::ParsedContentFile ESMStore::parse(ESM::ESMReader& esm) const
+{
+    ParsedContentFile result;
+
+    while (esm.hasMoreRecs())
+    {
+        ESM::NAME n = esm.getRecName();
+        esm.getRecHeader();
+        if (esm.getRecordFlags() & ESM::FLAG_Ignored)
+        {
+            esm.skipRecord();
+            continue;
+        }
+
+        const auto it = mStores.find(n.toInt());
+        if (it == mStores.end() || !it->second->parse(esm, result.mRecords[n.toInt()]))
+            esm.skipRecord();
+    }
+
+    return result;
+}
+
+void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener, ESM::Dialogue*& dialogue, ParsedContentFile* parsed)
 {
     if (listener != nullptr)
         listener->setProgressRange(::EsmLoader::fileProgress);
@@ -199,8 +221,24 @@ void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener, ESM::Dialo
             else {
                 throw std::runtime_error("Unknown record: " + n.toString());
             }
+        } else if (mLoadedFromCache && it->second->isCacheable()) {
+            esm.skipRecord();
+            dialogue = nullptr;
         } else {
-            RecordId id = it->second->load(esm);
+            ParsedRecordsBase* parsedRecords = nullptr;
+            if (parsed != nullptr)
+                if (const auto records = parsed->mRecords.find(n.toInt()); records != parsed->mRecords.end())
+                    parsedRecords = records->second.get();
+
+            RecordId id;
+            if (parsedRecords != nullptr)
+            {
+                esm.skipRecord();
+                id = it->second->insertParsed(*parsedRecords);
+            }
+            else
+                id = it->second->load(esm);
+
             if (id.mIsDeleted)
             {
                 it->second->eraseStatic(id.mId);
@@ -218,6 +256,30 @@ void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener, ESM::Dialo
     }
 }
 
+void ESMStore::writeCache(ESM::ESMWriter& writer) const
+{
+    for (const auto& [type, store] : mStores)
+        if (store->isCacheable())
+            store->writeStatic(writer);
+}
+
+void ESMStore::loadCache(ESM::ESMReader& esm)
+{
+    while (esm.hasMoreRecs())
+    {
+        const ESM::NAME n = esm.getRecName();
+        esm.getRecHeader();
+
+        const auto it = mStores.find(n.toInt());
+        if (it == mStores.end() || !it->second->isCacheable())
+            throw std::runtime_error("Unexpected cached record: " + n.toString());
+
+        it->second->load(esm);
+    }
+
+    mLoadedFromCache = true;
+}
+
 ESM::LuaScriptsCfg ESMStore::getLuaScriptsCfg() const
 {
     ESM::LuaScriptsCfg cfg;
@@ -278,6 +340,22 @@ void ESMStore::validateRecords(ESM::ReadersCache& readers)
     countAllCellRefs(readers);
 }
 
+void ESMStore::validateRecords(ESM::ReadersCache& readers, const boost::filesystem::path& refCountCachePath,
+    const std::vector<ContentFileStamp>& contentFiles, ToUTF8::FromType encoding)
+{
+    validate();
+    if (!mRefCount.empty())
+        return;
+    if (std::optional<RefCounts> cached = readRefCountCache(refCountCachePath, contentFiles, encoding))
+    {
+        Log(Debug::Info) << "Using cached reference counts from " << refCountCachePath;
+        mRefCount = std::move(*cached);
+        return;
+    }
+    countAllCellRefs(readers);
+    writeRefCountCache(refCountCachePath, contentFiles, encoding, mRefCount);
+}
+
 void ESMStore::countAllCellRefs(ESM::ReadersCache& readers)
 {
     // TODO: We currently need to read entire files here again.
@@ -7,6 +7,7 @@
 
 #include <components/esm/luascripts.hpp>
 #include <components/esm/records.hpp>
+#include "refcountcache.hpp"
 #include "store.hpp"
 
 namespace Loading
@@ -83,12 +84,14 @@ namespace MWWorld
         IDMap mIds;
         std::unordered_map<std::string, int> mStaticIds;
 
-        std::unordered_map<std::string, int> mRefCount;
+        RefCounts mRefCount;
 
         std::map<int, StoreBase *> mStores;
 
         unsigned int mDynamicCount;
 
+        bool mLoadedFromCache = false;
+
         mutable std::unordered_map<std::string, std::weak_ptr<MWMechanics::SpellList>, Misc::StringUtils::CiHash, Misc::StringUtils::CiEqual> mSpellListCache;
 
         /// Validate entries in store after setup
@@ -200,7 +203,27 @@ namespace MWWorld
         /// Validate entries in store after loading a save
         void validateDynamic();
 
-        void load(ESM::ESMReader &esm, Loading::Listener* listener, ESM::Dialogue*& dialogue);
+        /// Records of a content file parsed by parse(), keyed by record type.
+        struct ParsedContentFile
+        {
+            std::map<int, std::unique_ptr<ParsedRecordsBase>> mRecords;
+        };
+
+        /// Parse records of all types that don't depend on other records without modifying the store.
+        /// @note Thread safe, may run concurrently with load() of other content files.
+        ParsedContentFile parse(ESM::ESMReader& esm) const;
+
+        /// @param parsed Records of this content file already parsed by parse(). These are inserted
+        /// in their original order while the remaining records are read from esm.
+        void load(ESM::ESMReader &esm, Loading::Listener* listener, ESM::Dialogue*& dialogue,
+            ParsedContentFile* parsed = nullptr);
+
+        /// Write static records of the Stores supporting StoreBase::isCacheable() for loadCache().
+        void writeCache(ESM::ESMWriter& writer) const;
+
+        /// Load records written by writeCache(). Records of these types are then skipped by load(),
+        /// so the content files have to be loaded in the same order as they were for writeCache().
+        void loadCache(ESM::ESMReader& esm);
 
         template <class T>
         const Store<T> &get() const {
@@ -270,6 +293,11 @@ namespace MWWorld
         void setUp();
         void validateRecords(ESM::ReadersCache& readers);
 
+        /// Same as validateRecords, but takes cell reference counts from the cache file if it was written
+        /// for the same content files and encoding. Otherwise counts them and replaces the cache.
+        void validateRecords(ESM::ReadersCache& readers, const boost::filesystem::path& refCountCachePath,
+            const std::vector<ContentFileStamp>& contentFiles, ToUTF8::FromType encoding);
+
         int countSavedGameRecords() const;
 
         void write (ESM::ESMWriter& writer, Loading::Listener& progress) const;
@@ -0,0 +1,141 @@
+#include "esmstorecache.hpp"
+
+#include "esmstore.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/esm/defs.hpp>
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace MWWorld
+{
+namespace
+{
+    constexpr std::uint32_t esmStoreCacheKey = ESM::fourCC("OSCK");
+    // Increase when a cached record type changes its format
+    constexpr std::uint32_t esmStoreCacheVersion = 1;
+
+    // Paths are written without conversion to the content files encoding because they might not be
+    // representable in it.
+    void writeKey(ESM::ESMWriter& writer, const std::vector<ContentFileStamp>& contentFiles,
+        ToUTF8::FromType encoding)
+    {
+        writer.startRecord(esmStoreCacheKey);
+        writer.writeHNT("VERS", esmStoreCacheVersion);
+        writer.writeHNT("ENCD", static_cast<std::int32_t>(encoding));
+        for (const ContentFileStamp& stamp : contentFiles)
+        {
+            writer.writeHNString("PATH", stamp.mPath);
+            writer.writeHNT("SIZE", stamp.mSize);
+            writer.writeHNT("MTIM", stamp.mModificationTime);
+        }
+        writer.endRecord(esmStoreCacheKey);
+    }
+
+    bool readKey(ESM::ESMReader& reader, const std::vector<ContentFileStamp>& contentFiles,
+        ToUTF8::FromType encoding)
+    {
+        if (!reader.hasMoreRecs() || reader.getRecName().toInt() != esmStoreCacheKey)
+            throw std::runtime_error("Missing cache key");
+        reader.getRecHeader();
+
+        std::uint32_t version = 0;
+        reader.getHNT(version, "VERS");
+        if (version != esmStoreCacheVersion)
+            return false;
+
+        std::int32_t storedEncoding = 0;
+        reader.getHNT(storedEncoding, "ENCD");
+        if (storedEncoding != static_cast<std::int32_t>(encoding))
+            return false;
+
+        std::vector<ContentFileStamp> stored;
+        while (reader.isNextSub("PATH"))
+        {
+            ContentFileStamp& stamp = stored.emplace_back();
+            stamp.mPath = reader.getHString();
+            reader.getHNT(stamp.mSize, "SIZE");
+            reader.getHNT(stamp.mModificationTime, "MTIM");
+        }
+        return stored == contentFiles;
+    }
+}
+
+    bool readEsmStoreCache(const boost::filesystem::path& path, const std::vector<ContentFileStamp>& contentFiles,
+        ToUTF8::Utf8Encoder& encoder, ESMStore& store)
+    {
+        if (!boost::filesystem::exists(path))
+            return false;
+
+        ESM::ESMReader reader;
+        try
+        {
+            reader.open(path.string());
+            if (!readKey(reader, contentFiles, encoder.getSourceEncoding()))
+            {
+                Log(Debug::Info) << "Content records cache " << path << " is outdated";
+                return false;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Ignoring invalid content records cache " << path << ": " << e.what();
+            return false;
+        }
+
+        // Records are written converted back to the content files encoding, like the content files themselves
+        reader.setEncoder(&encoder);
+        try
+        {
+            store.loadCache(reader);
+        }
+        catch (const std::exception& e)
+        {
+            // The store is partially filled at this point, so it's too late to load the content files instead
+            boost::system::error_code ec;
+            boost::filesystem::remove(path, ec);
+            throw std::runtime_error("Failed to load content records cache " + path.string()
+                + ", it is removed to be rebuilt on the next start: " + e.what());
+        }
+
+        Log(Debug::Info) << "Loaded content records from cache " << path;
+        return true;
+    }
+
+    void writeEsmStoreCache(const boost::filesystem::path& path, const std::vector<ContentFileStamp>& contentFiles,
+        ToUTF8::Utf8Encoder& encoder, const ESMStore& store)
+    {
+        // Write to a temporary file first so a crash doesn't leave a truncated cache behind
+        boost::filesystem::path temporaryPath = path;
+        temporaryPath += ".tmp";
+        try
+        {
+            {
+                boost::filesystem::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+
+                ESM::ESMWriter writer;
+                writer.setFormat(0);
+                writer.save(stream);
+                writeKey(writer, contentFiles, encoder.getSourceEncoding());
+                writer.setEncoder(&encoder);
+                store.writeCache(writer);
+                writer.close();
+
+                if (!stream)
+                    throw std::runtime_error("failed to write " + temporaryPath.string());
+            }
+            boost::filesystem::rename(temporaryPath, path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write content records cache " << path << ": " << e.what();
+        }
+    }
+}
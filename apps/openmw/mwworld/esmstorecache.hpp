@@ -0,0 +1,31 @@
+#ifndef OPENMW_MWWORLD_ESMSTORECACHE_H
+#define OPENMW_MWWORLD_ESMSTORECACHE_H
+
+#include "refcountcache.hpp"
+
+#include <boost/filesystem/path.hpp>
+
+#include <vector>
+
+namespace ToUTF8
+{
+    class Utf8Encoder;
+}
+
+namespace MWWorld
+{
+    class ESMStore;
+
+    /// Loads the merged records of the Stores supporting StoreBase::isCacheable() into a store before any
+    /// content file is loaded. The content files are still loaded afterwards for the other record types.
+    /// @return false if the file is missing or was written for different content files or encoding.
+    bool readEsmStoreCache(const boost::filesystem::path& path, const std::vector<ContentFileStamp>& contentFiles,
+        ToUTF8::Utf8Encoder& encoder, ESMStore& store);
+
+    /// Replaces the cache file atomically with the records of a store having all content files loaded.
+    /// Failures are logged and otherwise ignored.
+    void writeEsmStoreCache(const boost::filesystem::path& path, const std::vector<ContentFileStamp>& contentFiles,
+        ToUTF8::Utf8Encoder& encoder, const ESMStore& store);
+}
+
+#endif
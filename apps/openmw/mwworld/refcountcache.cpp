@@ -0,0 +1,185 @@
+#include "refcountcache.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/serialization/binaryreader.hpp>
+#include <components/serialization/binarywriter.hpp>
+#include <components/serialization/format.hpp>
+#include <components/serialization/sizeaccumulator.hpp>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <stdexcept>
+
+namespace MWWorld
+{
+namespace
+{
+    constexpr char refCountCacheMagic[] = {'O', 'R', 'C', 'C'};
+    constexpr std::uint32_t refCountCacheVersion = 2;
+
+    struct RefCountEntry
+    {
+        std::string mId;
+        std::int32_t mCount = 0;
+    };
+
+    struct RefCountCache
+    {
+        std::vector<ContentFileStamp> mContentFiles;
+        std::int32_t mEncoding = 0;
+        std::vector<RefCountEntry> mRefCounts;
+    };
+
+    template <Serialization::Mode mode>
+    struct Format : Serialization::Format<mode, Format<mode>>
+    {
+        using Serialization::Format<mode, Format<mode>>::operator();
+
+        template <class Visitor, class T>
+        auto operator()(Visitor&& visitor, T& value) const
+            -> std::enable_if_t<std::is_same_v<std::decay_t<T>, std::string>>
+        {
+            if constexpr (mode == Serialization::Mode::Write)
+                visitor(*this, static_cast<std::uint64_t>(value.size()));
+            else
+            {
+                static_assert(mode == Serialization::Mode::Read);
+                std::uint64_t size = 0;
+                visitor(*this, size);
+                value.resize(static_cast<std::size_t>(size));
+            }
+            visitor(*this, value.data(), value.size());
+        }
+
+        template <class Visitor, class T>
+        auto operator()(Visitor&& visitor, T& value) const
+            -> std::enable_if_t<std::is_same_v<std::decay_t<T>, ContentFileStamp>>
+        {
+            visitor(*this, value.mPath);
+            visitor(*this, value.mSize);
+            visitor(*this, value.mModificationTime);
+        }
+
+        template <class Visitor, class T>
+        auto operator()(Visitor&& visitor, T& value) const
+            -> std::enable_if_t<std::is_same_v<std::decay_t<T>, RefCountEntry>>
+        {
+            visitor(*this, value.mId);
+            visitor(*this, value.mCount);
+        }
+
+        template <class Visitor, class T>
+        auto operator()(Visitor&& visitor, T& value) const
+            -> std::enable_if_t<std::is_same_v<std::decay_t<T>, RefCountCache>>
+        {
+            if constexpr (mode == Serialization::Mode::Write)
+            {
+                visitor(*this, refCountCacheMagic);
+                visitor(*this, refCountCacheVersion);
+            }
+            else
+            {
+                static_assert(mode == Serialization::Mode::Read);
+                char magic[std::size(refCountCacheMagic)];
+                visitor(*this, magic);
+                if (std::memcmp(magic, refCountCacheMagic, sizeof(magic)) != 0)
+                    throw std::runtime_error("Bad ref count cache magic");
+                std::uint32_t version = 0;
+                visitor(*this, version);
+                if (version != refCountCacheVersion)
+                    throw std::runtime_error("Bad ref count cache version");
+            }
+            visitor(*this, value.mContentFiles);
+            visitor(*this, value.mEncoding);
+            visitor(*this, value.mRefCounts);
+        }
+    };
+}
+
+    ContentFileStamp makeContentFileStamp(const boost::filesystem::path& path)
+    {
+        ContentFileStamp result;
+        result.mPath = path.string();
+        result.mSize = static_cast<std::uint64_t>(boost::filesystem::file_size(path));
+        // boost::filesystem::last_write_time has only seconds resolution
+        const auto modificationTime = std::filesystem::last_write_time(std::filesystem::path(path.native()));
+        result.mModificationTime = static_cast<std::int64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(modificationTime.time_since_epoch()).count());
+        return result;
+    }
+
+    std::optional<RefCounts> readRefCountCache(const boost::filesystem::path& path,
+        const std::vector<ContentFileStamp>& contentFiles, ToUTF8::FromType encoding)
+    {
+        boost::filesystem::ifstream stream(path, std::ios::binary);
+        if (!stream)
+            return std::nullopt;
+        const std::string content(std::istreambuf_iterator<char>(stream), {});
+        const auto* data = reinterpret_cast<const std::byte*>(content.data());
+
+        RefCountCache cache;
+        try
+        {
+            constexpr Format<Serialization::Mode::Read> format;
+            format(Serialization::BinaryReader(data, data + content.size()), cache);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Ignoring invalid ref count cache " << path << ": " << e.what();
+            return std::nullopt;
+        }
+
+        if (cache.mContentFiles != contentFiles || cache.mEncoding != static_cast<std::int32_t>(encoding))
+        {
+            Log(Debug::Info) << "Ref count cache " << path << " is outdated";
+            return std::nullopt;
+        }
+
+        RefCounts result;
+        result.reserve(cache.mRefCounts.size());
+        for (RefCountEntry& entry : cache.mRefCounts)
+            result.emplace(std::move(entry.mId), entry.mCount);
+        return result;
+    }
+
+    void writeRefCountCache(const boost::filesystem::path& path, const std::vector<ContentFileStamp>& contentFiles,
+        ToUTF8::FromType encoding, const RefCounts& refCounts)
+    {
+        RefCountCache cache;
+        cache.mContentFiles = contentFiles;
+        cache.mEncoding = static_cast<std::int32_t>(encoding);
+        cache.mRefCounts.reserve(refCounts.size());
+        for (const auto& [id, count] : refCounts)
+            cache.mRefCounts.push_back(RefCountEntry {id, static_cast<std::int32_t>(count)});
+
+        constexpr Format<Serialization::Mode::Write> format;
+        Serialization::SizeAccumulator sizeAccumulator;
+        format(sizeAccumulator, cache);
+        std::vector<std::byte> data(sizeAccumulator.value());
+        format(Serialization::BinaryWriter(data.data(), data.data() + data.size()), cache);
+
+        // Write to a temporary file first so a crash doesn't leave a truncated cache behind
+        boost::filesystem::path temporaryPath = path;
+        temporaryPath += ".tmp";
+        try
+        {
+            {
+                boost::filesystem::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+                stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+                if (!stream)
+                    throw std::runtime_error("failed to write " + temporaryPath.string());
+            }
+            boost::filesystem::rename(temporaryPath, path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write ref count cache " << path << ": " << e.what();
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef OPENMW_MWWORLD_REFCOUNTCACHE_H
+#define OPENMW_MWWORLD_REFCOUNTCACHE_H
+
+#include <components/to_utf8/to_utf8.hpp>
+
+#include <boost/filesystem/path.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace MWWorld
+{
+    using RefCounts = std::unordered_map<std::string, int>;
+
+    /// State of a content file at the moment of loading. The cache is valid only for the same
+    /// content files with the same sizes and modification times in the same order.
+    struct ContentFileStamp
+    {
+        std::string mPath;
+        std::uint64_t mSize = 0;
+        std::int64_t mModificationTime = 0; // in nanoseconds, to notice a change made within a second
+    };
+
+    inline bool operator==(const ContentFileStamp& l, const ContentFileStamp& r)
+    {
+        return l.mPath == r.mPath && l.mSize == r.mSize && l.mModificationTime == r.mModificationTime;
+    }
+
+    ContentFileStamp makeContentFileStamp(const boost::filesystem::path& path);
+
+    /// @return Reference counts stored in the cache file or nothing if the file is missing, corrupted
+    /// or was written for different content files or encoding. Reference ids are converted to UTF-8
+    /// from the content files encoding, so they depend on it.
+    std::optional<RefCounts> readRefCountCache(const boost::filesystem::path& path,
+        const std::vector<ContentFileStamp>& contentFiles, ToUTF8::FromType encoding);
+
+    /// Replaces the cache file atomically. Failures are logged and otherwise ignored.
+    void writeRefCountCache(const boost::filesystem::path& path, const std::vector<ContentFileStamp>& contentFiles,
+        ToUTF8::FromType encoding, const RefCounts& refCounts);
+}
+
+#endif
@@ -3,6 +3,7 @@
 #include <limits>
 #include <chrono>
 #include <atomic>
+#include <algorithm>
 
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
 
@@ -12,6 +13,8 @@
 #include <components/settings/settings.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
+#include <components/resource/imagemanager.hpp>
+#include <components/resource/bulletshapemanager.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
 #include <components/detournavigator/navigator.hpp>
 #include <components/detournavigator/agentbounds.hpp>
@@ -46,6 +49,11 @@
 
 namespace
 {
+    std::size_t getCacheBudget(const std::string& name)
+    {
+        return static_cast<std::size_t>(std::max(0, Settings::Manager::getInt(name, "Cells"))) * 1024 * 1024;
+    }
+
     using MWWorld::RotationOrder;
 
     osg::Quat makeActorOsgQuat(const ESM::Position& position)
@@ -312,9 +320,12 @@ namespace MWWorld
         if (mChangeCellGridRequest.has_value())
         {
             changeCellGrid(mChangeCellGridRequest->mPosition, mChangeCellGridRequest->mCell.x(),
-                           mChangeCellGridRequest->mCell.y(), mChangeCellGridRequest->mChangeEvent);
+                           mChangeCellGridRequest->mCell.y(), mChangeCellGridRequest->mChangeEvent,
+                           mCellLoadingBudget != std::chrono::steady_clock::duration::zero());
             mChangeCellGridRequest.reset();
         }
+        else if (!mCellsToLoad.empty())
+            loadQueuedCells();
 
         mPreloader->updateCache(mRendering.getReferenceTime());
         preloadCells(duration);
@@ -486,6 +497,7 @@ namespace MWWorld
             unloadCell (cell);
         }
         assert(mActiveCells.empty());
+        mCellsToLoad.clear();
         mCurrentCell = nullptr;
 
         mPreloader->clear();
@@ -525,8 +537,10 @@ namespace MWWorld
         mChangeCellGridRequest = ChangeCellGridRequest {position, cell, changeEvent};
     }
 
-    void Scene::changeCellGrid (const osg::Vec3f &pos, int playerCellX, int playerCellY, bool changeEvent)
+    void Scene::changeCellGrid (const osg::Vec3f &pos, int playerCellX, int playerCellY, bool changeEvent, bool incremental)
     {
+        mCellsToLoad.clear();
+
         for (auto iter = mActiveCells.begin(); iter != mActiveCells.end(); )
         {
             auto* cell = *iter++;
@@ -576,12 +590,6 @@ namespace MWWorld
 
         auto cellsPositionsToLoad = cellsToLoad(mActiveCells,mHalfGridSize);
 
-        Loading::Listener* loadingListener = MWBase::Environment::get().getWindowManager()->getLoadingScreen();
-        Loading::ScopedLoad load(loadingListener);
-        std::string loadingExteriorText = "#{sLoadingMessage3}";
-        loadingListener->setLabel(loadingExteriorText);
-        loadingListener->setProgressRange(refsToLoad);
-
         const auto getDistanceToPlayerCell = [&] (const std::pair<int, int>& cellPosition)
         {
             return std::abs(cellPosition.first - playerCellX) + std::abs(cellPosition.second - playerCellY);
@@ -597,6 +605,25 @@ namespace MWWorld
                 return getCellPositionPriority(lhs) < getCellPositionPriority(rhs);
             });
 
+        if (incremental)
+        {
+            // The player's cell is loaded right away to keep the gameplay around the player consistent
+            const auto deferred = std::find_if(cellsPositionsToLoad.begin(), cellsPositionsToLoad.end(),
+                [&] (const std::pair<int, int>& cellPosition) { return getDistanceToPlayerCell(cellPosition) > 0; });
+            for (auto it = deferred; it != cellsPositionsToLoad.end(); ++it)
+            {
+                refsToLoad -= mWorld.getExterior(it->first, it->second)->count();
+                mCellsToLoad.push_back(QueuedCell {osg::Vec2i(it->first, it->second), pos, changeEvent});
+            }
+            cellsPositionsToLoad.erase(deferred, cellsPositionsToLoad.end());
+        }
+
+        Loading::Listener* loadingListener = MWBase::Environment::get().getWindowManager()->getLoadingScreen();
+        Loading::ScopedLoad load(loadingListener);
+        std::string loadingExteriorText = "#{sLoadingMessage3}";
+        loadingListener->setLabel(loadingExteriorText);
+        loadingListener->setProgressRange(refsToLoad);
+
         for (const auto& [x,y] : cellsPositionsToLoad)
         {
             if (!isCellInCollection(x, y, mActiveCells))
@@ -615,6 +642,20 @@ namespace MWWorld
         mCellLoaded = true;
     }
 
+    void Scene::loadQueuedCells()
+    {
+        const auto start = std::chrono::steady_clock::now();
+        do
+        {
+            const QueuedCell queued = mCellsToLoad.front();
+            mCellsToLoad.pop_front();
+            if (!isCellInCollection(queued.mCell.x(), queued.mCell.y(), mActiveCells))
+                loadCell(mWorld.getExterior(queued.mCell.x(), queued.mCell.y()), nullptr, queued.mRespawn,
+                         queued.mPlayerPosition);
+        }
+        while (!mCellsToLoad.empty() && std::chrono::steady_clock::now() - start < mCellLoadingBudget);
+    }
+
     void Scene::addPostponedPhysicsObjects()
     {
         for(const auto& cell : mActiveCells)
@@ -778,11 +819,16 @@ namespace MWWorld
     , mPreloadDoors(Settings::Manager::getBool("preload doors", "Cells"))
     , mPreloadFastTravel(Settings::Manager::getBool("preload fast travel", "Cells"))
     , mPredictionTime(Settings::Manager::getFloat("prediction time", "Cells"))
+    , mCellLoadingBudget(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float, std::milli>(
+        std::max(0.f, Settings::Manager::getFloat("exterior cell loading budget", "Cells")))))
     {
-        mPreloader = std::make_unique<CellPreloader>(rendering.getResourceSystem(), physics->getShapeManager(), rendering.getTerrain(), rendering.getLandManager());
+        mPreloader = std::make_unique<CellPreloader>(rendering.getResourceSystem(), physics->getShapeManager(), rendering.getTerrain(), rendering.getLandManager(), &mPathgridGraphCache);
         mPreloader->setWorkQueue(mRendering.getWorkQueue());
 
         rendering.getResourceSystem()->setExpiryDelay(Settings::Manager::getFloat("cache expiry delay", "Cells"));
+        rendering.getResourceSystem()->getSceneManager()->setMaxCacheSize(getCacheBudget("mesh cache budget"));
+        rendering.getResourceSystem()->getImageManager()->setMaxCacheSize(getCacheBudget("texture cache budget"));
+        physics->getShapeManager()->setMaxCacheSize(getCacheBudget("collision shape cache budget"));
 
         mPreloader->setExpiryDelay(Settings::Manager::getFloat("preload cell expiry delay", "Cells"));
         mPreloader->setMinCacheSize(Settings::Manager::getInt("preload cell cache min", "Cells"));
@@ -841,6 +887,7 @@ namespace MWWorld
             unloadCell(cellToUnload);
         }
         assert(mActiveCells.empty());
+        mCellsToLoad.clear();
 
         loadingListener->setProgressRange(cell->count());
 
@@ -1017,6 +1064,11 @@ namespace MWWorld
         }
     }
 
+    const MWMechanics::PathgridGraph& Scene::getPathgridGraph(const CellStore& cell)
+    {
+        return *mPathgridGraphCache.get(mWorld.getStore().get<ESM::Pathgrid>().search(*cell.getCell()));
+    }
+
     void Scene::preloadCells(float dt)
     {
         if (dt<=1e-06) return;
@@ -7,6 +7,8 @@
 
 #include "ptr.hpp"
 
+#include <chrono>
+#include <deque>
 #include <set>
 #include <memory>
 #include <unordered_map>
@@ -15,6 +17,8 @@
 
 #include <components/misc/constants.hpp>
 
+#include "../mwmechanics/pathgrid.hpp"
+
 namespace osg
 {
     class Vec3f;
@@ -82,6 +86,13 @@ namespace MWWorld
                 bool mChangeEvent;
             };
 
+            struct QueuedCell
+            {
+                osg::Vec2i mCell;
+                osg::Vec3f mPlayerPosition;
+                bool mRespawn;
+            };
+
             CellStore* mCurrentCell; // the cell the player is in
             CellStoreCollection mActiveCells;
             bool mCellChanged;
@@ -90,6 +101,7 @@ namespace MWWorld
             MWPhysics::PhysicsSystem *mPhysics;
             MWRender::RenderingManager& mRendering;
             DetourNavigator::Navigator& mNavigator;
+            MWMechanics::PathgridGraphCache mPathgridGraphCache;
             std::unique_ptr<CellPreloader> mPreloader;
             float mCellLoadingThreshold;
             float mPreloadDistance;
@@ -99,6 +111,7 @@ namespace MWWorld
             bool mPreloadDoors;
             bool mPreloadFastTravel;
             float mPredictionTime;
+            std::chrono::steady_clock::duration mCellLoadingBudget; // zero loads the whole grid at once
 
             static const int mHalfGridSize = Constants::CellGridRadius;
 
@@ -110,11 +123,19 @@ namespace MWWorld
 
             std::optional<ChangeCellGridRequest> mChangeCellGridRequest;
 
+            // Exterior cells of the current grid waiting to be loaded, nearest to the player first
+            std::deque<QueuedCell> mCellsToLoad;
+
             void insertCell(CellStore &cell, Loading::Listener* loadingListener);
             osg::Vec2i mCurrentGridCenter;
 
             // Load and unload cells as necessary to create a cell grid with "X" and "Y" in the center
-            void changeCellGrid (const osg::Vec3f &pos, int playerCellX, int playerCellY, bool changeEvent = true);
+            // @param incremental load only the player's cell at once and queue the others for loadQueuedCells
+            void changeCellGrid (const osg::Vec3f &pos, int playerCellX, int playerCellY, bool changeEvent = true,
+                                 bool incremental = false);
+
+            // Load queued cells until the time budget is spent, at least one
+            void loadQueuedCells();
 
             void requestChangeCellGrid(const osg::Vec3f &position, const osg::Vec2i& cell, bool changeEvent = true);
 
@@ -192,6 +213,8 @@ namespace MWWorld
 
             void preload(const std::string& mesh, bool useAnim=false);
 
+            const MWMechanics::PathgridGraph& getPathgridGraph(const CellStore& cell);
+
             void testExteriorCells();
             void testInteriorCells();
     };
@@ -180,6 +180,31 @@ namespace MWWorld
         return RecordId(record.mId, isDeleted);
     }
     template<typename T>
+    bool Store<T>::parse(ESM::ESMReader& esm, std::unique_ptr<ParsedRecordsBase>& out) const
+    {
+        if (out == nullptr)
+            out = std::make_unique<ParsedRecords<T>>();
+        auto& [record, isDeleted] = static_cast<ParsedRecords<T>&>(*out).mRecords.emplace_back(T(), false);
+
+        record.load(esm, isDeleted);
+        Misc::StringUtils::lowerCaseInPlace(record.mId); // TODO: remove this line once we have ported our remaining code base to lowercase on lookup
+
+        return true;
+    }
+    template<typename T>
+    RecordId Store<T>::insertParsed(ParsedRecordsBase& records)
+    {
+        auto& parsed = static_cast<ParsedRecords<T>&>(records);
+        auto& [record, isDeleted] = parsed.mRecords.at(parsed.mNext++);
+
+        RecordId result(record.mId, isDeleted);
+        std::pair<typename Static::iterator, bool> inserted = mStatic.insert_or_assign(result.mId, std::move(record));
+        if (inserted.second)
+            mShared.push_back(&inserted.first->second);
+
+        return result;
+    }
+    template<typename T>
     void Store<T>::setUp()
     {
     }
@@ -293,6 +318,17 @@ namespace MWWorld
         }
     }
     template<typename T>
+    void Store<T>::writeStatic(ESM::ESMWriter& writer) const
+    {
+        // Static records precede dynamic ones in mShared
+        for (std::size_t i = 0; i < mStatic.size(); ++i)
+        {
+            writer.startRecord(T::sRecordId);
+            mShared[i]->save(writer);
+            writer.endRecord(T::sRecordId);
+        }
+    }
+    template<typename T>
     RecordId Store<T>::read(ESM::ESMReader& reader, bool overrideOnly)
     {
         T record;
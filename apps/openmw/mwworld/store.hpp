@@ -43,6 +43,22 @@ namespace MWWorld
         RecordId(const std::string &id = {}, bool isDeleted = false);
     };
 
+    /// Records parsed ahead of being inserted into a Store, see StoreBase::parse.
+    class ParsedRecordsBase
+    {
+    public:
+        virtual ~ParsedRecordsBase() = default;
+    };
+
+    template <class T>
+    class ParsedRecords : public ParsedRecordsBase
+    {
+    public:
+        /// Records with their deleted flag in content file order
+        std::vector<std::pair<T, bool>> mRecords;
+        std::size_t mNext = 0;
+    };
+
     class StoreBase
     {
     public:
@@ -57,6 +73,14 @@ namespace MWWorld
         virtual int getDynamicSize() const { return 0; }
         virtual RecordId load(ESM::ESMReader &esm) = 0;
 
+        /// Parse the current record into out without modifying the Store, so content files can be
+        /// parsed on multiple threads. Only supported by Stores whose records don't depend on other records.
+        /// @return false if the record was not consumed and has to be loaded with load().
+        virtual bool parse(ESM::ESMReader& /*esm*/, std::unique_ptr<ParsedRecordsBase>& /*out*/) const { return false; }
+
+        /// Insert the next record from the records produced by parse(), like load() would do.
+        virtual RecordId insertParsed(ParsedRecordsBase& /*records*/) { return RecordId(); }
+
         virtual bool eraseStatic(std::string_view id) { return false; }
         virtual void clearDynamic() {}
 
@@ -64,6 +88,13 @@ namespace MWWorld
 
         virtual RecordId read (ESM::ESMReader& reader, bool overrideOnly = false) { return RecordId(); }
         ///< Read into dynamic storage
+
+        /// Whether static records can be restored with load() from a cache written by writeStatic() instead
+        /// of the content files. Not supported by Stores whose records keep reader contexts or are merged.
+        virtual bool isCacheable() const { return false; }
+
+        /// Write static records in the order they were loaded from the content files, see isCacheable().
+        virtual void writeStatic(ESM::ESMWriter& /*writer*/) const {}
     };
 
     template <class T>
@@ -215,8 +246,12 @@ namespace MWWorld
         bool erase(const T &item);
 
         RecordId load(ESM::ESMReader &esm) override;
+        bool parse(ESM::ESMReader& esm, std::unique_ptr<ParsedRecordsBase>& out) const override;
+        RecordId insertParsed(ParsedRecordsBase& records) override;
         void write(ESM::ESMWriter& writer, Loading::Listener& progress) const override;
         RecordId read(ESM::ESMReader& reader, bool overrideOnly = false) override;
+        bool isCacheable() const override { return true; }
+        void writeStatic(ESM::ESMWriter& writer) const override;
     };
 
     template <>
@@ -85,6 +85,7 @@
 
 #include "contentloader.hpp"
 #include "esmloader.hpp"
+#include "esmstorecache.hpp"
 #include "cellutils.hpp"
 
 namespace MWWorld
@@ -96,6 +97,12 @@ namespace MWWorld
             mLoaders.emplace(std::move(extension), &loader);
         }
 
+        ContentLoader* getLoader(const boost::filesystem::path& filepath) const
+        {
+            const auto it = mLoaders.find(Misc::StringUtils::lowerCase(filepath.extension().string()));
+            return it == mLoaders.end() ? nullptr : it->second;
+        }
+
         void load(const boost::filesystem::path& filepath, int& index, Loading::Listener* listener) override
         {
             const auto it = mLoaders.find(Misc::StringUtils::lowerCase(filepath.extension().string()));
@@ -175,7 +182,8 @@ namespace MWWorld
         fillGlobalVariables();
 
         mStore.setUp();
-        mStore.validateRecords(mReaders);
+        mStore.validateRecords(mReaders, boost::filesystem::path(userDataPath) / "refcounts.cache", mContentFileStamps,
+            encoder->getSourceEncoding());
         mStore.movePlayerRecord();
 
         mSwimHeightScale = mStore.get<ESM::GameSetting>().find("fSwimHeightScale")->mValue.getFloat();
@@ -1253,6 +1261,8 @@ namespace MWWorld
             }
         }
 
+        MWBase::Environment::get().getMechanicsManager()->updatePosition(newPtr);
+
         if (isPlayer)
             mWorldScene->playerMoved(position);
         else
@@ -2944,23 +2954,46 @@ namespace MWWorld
         OMWScriptsLoader omwScriptsLoader(mStore);
         gameContentLoader.addLoader(".omwscripts", omwScriptsLoader);
 
-        int idx = 0;
+        std::vector<boost::filesystem::path> paths;
+        paths.reserve(content.size());
         for (const std::string &file : content)
         {
             boost::filesystem::path filename(file);
             const Files::MultiDirCollection& col = fileCollections.getCollection(filename.extension().string());
-            if (col.doesExist(file))
-            {
-                gameContentLoader.load(col.getPath(file), idx, listener);
-            }
-            else
+            if (!col.doesExist(file))
             {
                 std::string message = "Failed loading " + file + ": the content file does not exist";
                 throw std::runtime_error(message);
             }
+            paths.push_back(col.getPath(file));
+        }
+
+        for (const boost::filesystem::path& path : paths)
+            mContentFileStamps.push_back(makeContentFileStamp(path));
+
+        // Records that are parsed ahead are the ones loaded from the cache, so there is nothing left to parse
+        const boost::filesystem::path cachePath = boost::filesystem::path(mUserDataPath) / "esmstore.cache";
+        const bool cached = readEsmStoreCache(cachePath, mContentFileStamps, *encoder, mStore);
+        if (!cached)
+        {
+            std::vector<std::pair<int, boost::filesystem::path>> esmFiles;
+            for (std::size_t i = 0; i < paths.size(); ++i)
+                if (gameContentLoader.getLoader(paths[i]) == &esmLoader)
+                    esmFiles.emplace_back(static_cast<int>(i), paths[i]);
+            if (const std::size_t threadsCount = Settings::Manager::getThreadsCount("content parsing threads", "General"); threadsCount > 0)
+                esmLoader.startParsing(std::move(esmFiles), threadsCount);
+        }
+
+        int idx = 0;
+        for (const boost::filesystem::path& path : paths)
+        {
+            gameContentLoader.load(path, idx, listener);
             idx++;
         }
 
+        if (!cached)
+            writeEsmStoreCache(cachePath, mContentFileStamps, *encoder, mStore);
+
         if (const auto v = esmLoader.getMasterFileFormat(); v.has_value() && *v == 0)
             ensureNeededRecords(); // Insert records that may not be present in all versions of master files.
     }
@@ -3940,6 +3973,11 @@ namespace MWWorld
         return mNavigator.get();
     }
 
+    const MWMechanics::PathgridGraph& World::getPathgridGraph(const MWWorld::CellStore* cell)
+    {
+        return mWorldScene->getPathgridGraph(*cell);
+    }
+
     void World::updateActorPath(const MWWorld::ConstPtr& actor, const std::deque<osg::Vec3f>& path,
         const DetourNavigator::AgentBounds& agentBounds, const osg::Vec3f& start, const osg::Vec3f& end) const
     {
@@ -108,6 +108,7 @@ namespace MWWorld
             bool mScriptsEnabled;
             bool mDiscardMovements;
             std::vector<std::string> mContentFiles;
+            std::vector<ContentFileStamp> mContentFileStamps;
 
             std::string mUserDataPath;
 
@@ -658,6 +659,9 @@ namespace MWWorld
             void applyLoopingParticles(const MWWorld::Ptr& ptr) const override;
 
             const std::vector<std::string>& getContentFiles() const override;
+
+            /// Sizes and modification times of the loaded content files to validate caches built from them.
+            const std::vector<ContentFileStamp>& getContentFileStamps() const { return mContentFileStamps; }
             void breakInvisibility (const MWWorld::Ptr& actor) override;
 
             // Allow NPCs to use torches?
@@ -736,6 +740,8 @@ namespace MWWorld
 
             DetourNavigator::Navigator* getNavigator() const override;
 
+            const MWMechanics::PathgridGraph& getPathgridGraph(const MWWorld::CellStore* cell) override;
+
             void updateActorPath(const MWWorld::ConstPtr& actor, const std::deque<osg::Vec3f>& path,
                 const DetourNavigator::AgentBounds& agentBounds, const osg::Vec3f& start, const osg::Vec3f& end) const override;
 
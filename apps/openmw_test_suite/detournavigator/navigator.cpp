@@ -5,6 +5,11 @@
 #include <components/detournavigator/exceptions.hpp>
 #include <components/detournavigator/navigatorutils.hpp>
 #include <components/detournavigator/navmeshdb.hpp>
+#include <components/detournavigator/pathrequestqueue.hpp>
+#include <components/detournavigator/serialization.hpp>
+#include <components/detournavigator/settingsutils.hpp>
+#include <components/detournavigator/stats.hpp>
+#include <components/detournavigator/tilegraph.hpp>
 #include <components/misc/rng.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/esm3/loadland.hpp>
@@ -21,9 +26,11 @@
 #include <gmock/gmock.h>
 
 #include <array>
+#include <chrono>
 #include <deque>
 #include <memory>
 #include <limits>
+#include <thread>
 
 MATCHER_P3(Vec3fEq, x, y, z, "")
 {
@@ -114,6 +121,41 @@ namespace
         osg::ref_ptr<const Resource::BulletShapeInstance> mInstance;
     };
 
+    void waitUntilReady(const PathRequest& request)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!request.isReady() && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    constexpr TileSides allSides = TileSide_negativeX | TileSide_positiveY | TileSide_positiveX | TileSide_negativeY;
+
+    std::unique_ptr<NavMeshDb> makeDbWithTileGraph(const Settings& settings, std::string_view worldspace,
+        const AgentBounds& agentBounds, std::vector<TileGraphNode> nodes)
+    {
+        auto db = std::make_unique<NavMeshDb>(":memory:", std::numeric_limits<std::uint64_t>::max());
+        db->replaceTileGraph(worldspace, serialize(settings.mRecast, agentBounds), TileVersion {navMeshFormatVersion},
+            serialize(TileGraph(std::move(nodes))));
+        return db;
+    }
+
+    // Tiles around a gap at (1, 0) and (1, 1) so the route from (0, 0) to (2, 0) goes through (1, 2)
+    std::unique_ptr<NavMeshDb> makeDbWithTileGraph(const Settings& settings, std::string_view worldspace,
+        const AgentBounds& agentBounds)
+    {
+        std::vector<TileGraphNode> nodes;
+        for (const TilePosition& position : {TilePosition(0, 0), TilePosition(0, 1), TilePosition(0, 2),
+                TilePosition(1, 2), TilePosition(2, 2), TilePosition(2, 1), TilePosition(2, 0)})
+            nodes.push_back(TileGraphNode {position, allSides});
+        return makeDbWithTileGraph(settings, worldspace, agentBounds, std::move(nodes));
+    }
+
+    osg::Vec2f getTileCenter(const Settings& settings, const TilePosition& position)
+    {
+        const float tileSize = getRealTileSize(settings.mRecast);
+        return osg::Vec2f((position.x() + 0.5f) * tileSize, (position.y() + 0.5f) * tileSize);
+    }
+
     btVector3 getHeightfieldShift(const osg::Vec2i& cellPosition, int cellSize, float minHeight, float maxHeight)
     {
         return BulletHelpers::getHeightfieldShift(cellPosition.x(), cellPosition.x(), cellSize, minHeight, maxHeight);
@@ -1163,4 +1205,196 @@ namespace
 
         EXPECT_EQ(mNavigator->getNavMesh(mAgentBounds)->lockConst()->getVersion(), version);
     }
+
+    TEST_F(DetourNavigatorNavigatorTest, request_path_for_empty_should_be_ready_with_navmesh_not_found)
+    {
+        const PathQuery query {.mAgentBounds = mAgentBounds, .mStepSize = mStepSize, .mStart = mStart, .mEnd = mEnd,
+            .mIncludeFlags = Flag_walk};
+        const auto request = mNavigator->requestPath(query);
+        ASSERT_TRUE(request->isReady());
+        EXPECT_EQ(request->getStatus(), Status::NavMeshNotFound);
+        EXPECT_THAT(request->getPath(), IsEmpty());
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, update_then_request_path_should_provide_same_path_as_find_path)
+    {
+        const HeightfieldPlane plane {100};
+        const int cellSize = mHeightfieldTileSize * 4;
+
+        mNavigator->addAgent(mAgentBounds);
+        mNavigator->addHeightfield(mCellPosition, cellSize, plane);
+        mNavigator->update(mPlayerPosition);
+        mNavigator->wait(mListener, WaitConditionType::requiredTilesPresent);
+
+        ASSERT_EQ(findPath(*mNavigator, mAgentBounds, mStepSize, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance, mOut),
+                  Status::Success);
+
+        const PathQuery query {.mAgentBounds = mAgentBounds, .mStepSize = mStepSize, .mStart = mStart, .mEnd = mEnd,
+            .mIncludeFlags = Flag_walk, .mAreaCosts = mAreaCosts, .mEndTolerance = mEndTolerance};
+        const auto request = mNavigator->requestPath(query);
+        EXPECT_FALSE(request->isReady());
+        mNavigator->update(mPlayerPosition);
+        waitUntilReady(*request);
+
+        ASSERT_TRUE(request->isReady());
+        EXPECT_EQ(request->getStatus(), Status::Success);
+        EXPECT_EQ(std::deque<osg::Vec3f>(request->getPath().begin(), request->getPath().end()), mPath);
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, without_threads_path_request_should_be_processed_by_update)
+    {
+        mSettings.mAsyncPathFinderThreads = 0;
+        mNavigator.reset(new NavigatorImpl(mSettings, std::make_unique<NavMeshDb>(":memory:", std::numeric_limits<std::uint64_t>::max())));
+
+        const HeightfieldPlane plane {100};
+        const int cellSize = mHeightfieldTileSize * 4;
+
+        mNavigator->addAgent(mAgentBounds);
+        mNavigator->addHeightfield(mCellPosition, cellSize, plane);
+        mNavigator->update(mPlayerPosition);
+        mNavigator->wait(mListener, WaitConditionType::requiredTilesPresent);
+
+        const PathQuery query {.mAgentBounds = mAgentBounds, .mStepSize = mStepSize, .mStart = mStart, .mEnd = mEnd,
+            .mIncludeFlags = Flag_walk, .mAreaCosts = mAreaCosts, .mEndTolerance = mEndTolerance};
+        const auto request = mNavigator->requestPath(query);
+        EXPECT_FALSE(request->isReady());
+        mNavigator->update(mPlayerPosition);
+
+        ASSERT_TRUE(request->isReady());
+        EXPECT_EQ(request->getStatus(), Status::Success);
+        EXPECT_THAT(request->getPath(), Not(IsEmpty()));
+        EXPECT_EQ(mNavigator->getStats().mPathRequests->mSolved, 1);
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, path_request_dropped_before_update_should_be_cancelled)
+    {
+        mSettings.mAsyncPathFinderThreads = 0;
+        mNavigator.reset(new NavigatorImpl(mSettings, std::make_unique<NavMeshDb>(":memory:", std::numeric_limits<std::uint64_t>::max())));
+
+        const HeightfieldPlane plane {100};
+        const int cellSize = mHeightfieldTileSize * 4;
+
+        mNavigator->addAgent(mAgentBounds);
+        mNavigator->addHeightfield(mCellPosition, cellSize, plane);
+        mNavigator->update(mPlayerPosition);
+        mNavigator->wait(mListener, WaitConditionType::requiredTilesPresent);
+
+        const PathQuery query {.mAgentBounds = mAgentBounds, .mStepSize = mStepSize, .mStart = mStart, .mEnd = mEnd,
+            .mIncludeFlags = Flag_walk, .mAreaCosts = mAreaCosts, .mEndTolerance = mEndTolerance};
+        mNavigator->requestPath(query);
+        EXPECT_EQ(mNavigator->getStats().mPathRequests->mQueued, 1);
+        mNavigator->update(mPlayerPosition);
+
+        const Stats stats = mNavigator->getStats();
+        EXPECT_EQ(stats.mPathRequests->mQueued, 0);
+        EXPECT_EQ(stats.mPathRequests->mSolved, 0);
+        EXPECT_EQ(stats.mPathRequests->mCancelled, 1);
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, path_request_should_use_fallback_flags_when_path_is_not_found)
+    {
+        const HeightfieldPlane plane {100};
+        const int cellSize = mHeightfieldTileSize * 4;
+
+        mNavigator->addAgent(mAgentBounds);
+        mNavigator->addHeightfield(mCellPosition, cellSize, plane);
+        mNavigator->update(mPlayerPosition);
+        mNavigator->wait(mListener, WaitConditionType::requiredTilesPresent);
+
+        const PathQuery query {.mAgentBounds = mAgentBounds, .mStepSize = mStepSize, .mStart = mStart, .mEnd = mEnd,
+            .mIncludeFlags = Flag_swim, .mFallbackIncludeFlags = Flag_walk, .mAreaCosts = mAreaCosts,
+            .mEndTolerance = mEndTolerance};
+        const auto request = mNavigator->requestPath(query);
+        mNavigator->update(mPlayerPosition);
+        waitUntilReady(*request);
+
+        ASSERT_TRUE(request->isReady());
+        EXPECT_EQ(request->getStatus(), Status::Success);
+        EXPECT_THAT(request->getPath(), Not(IsEmpty()));
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, find_tile_route_should_use_tile_graph_loaded_from_db)
+    {
+        mNavigator.reset(new NavigatorImpl(mSettings, makeDbWithTileGraph(mSettings, mWorldspace, mAgentBounds)));
+
+        const HeightfieldPlane plane {100};
+        const int cellSize = mHeightfieldTileSize * 4;
+
+        mNavigator->setWorldspace(mWorldspace);
+        mNavigator->addAgent(mAgentBounds);
+        mNavigator->addHeightfield(mCellPosition, cellSize, plane);
+        mNavigator->update(mPlayerPosition);
+        mNavigator->wait(mListener, WaitConditionType::allJobsDone);
+
+        const osg::Vec2f start = getTileCenter(mSettings, TilePosition(0, 0));
+        const osg::Vec2f end = getTileCenter(mSettings, TilePosition(2, 0));
+        EXPECT_THAT(mNavigator->findTileRoute(mAgentBounds, osg::Vec3f(start, 0), osg::Vec3f(end, 0)), ElementsAre(
+            getTileCenter(mSettings, TilePosition(0, 0)),
+            getTileCenter(mSettings, TilePosition(0, 1)),
+            getTileCenter(mSettings, TilePosition(0, 2)),
+            getTileCenter(mSettings, TilePosition(1, 2)),
+            getTileCenter(mSettings, TilePosition(2, 2)),
+            getTileCenter(mSettings, TilePosition(2, 1)),
+            getTileCenter(mSettings, TilePosition(2, 0))
+        ));
+        EXPECT_THAT(mNavigator->findTileRoute(AgentBounds {CollisionShapeType::Cylinder, mAgentBounds.mHalfExtents},
+            osg::Vec3f(start, 0), osg::Vec3f(end, 0)), IsEmpty());
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, request_path_with_max_distance_should_limit_end_by_tile_route)
+    {
+        mNavigator.reset(new NavigatorImpl(mSettings, makeDbWithTileGraph(mSettings, mWorldspace, mAgentBounds)));
+
+        const HeightfieldPlane plane {100};
+        const int cellSize = mHeightfieldTileSize * 4;
+
+        mNavigator->setWorldspace(mWorldspace);
+        mNavigator->addAgent(mAgentBounds);
+        mNavigator->addHeightfield(mCellPosition, cellSize, plane);
+        mNavigator->update(mPlayerPosition);
+        mNavigator->wait(mListener, WaitConditionType::allJobsDone);
+
+        const float tileSize = getRealTileSize(mSettings.mRecast);
+        const osg::Vec3f start(getTileCenter(mSettings, TilePosition(0, 0)), 1);
+        const osg::Vec3f end(getTileCenter(mSettings, TilePosition(2, 0)), 1);
+        const PathQuery query {.mAgentBounds = mAgentBounds, .mStepSize = mStepSize, .mStart = start, .mEnd = end,
+            .mIncludeFlags = Flag_walk, .mAreaCosts = mAreaCosts, .mEndTolerance = mEndTolerance,
+            .mMaxDistance = 1.5f * tileSize};
+        const auto request = mNavigator->requestPath(query);
+        mNavigator->update(mPlayerPosition);
+        waitUntilReady(*request);
+
+        ASSERT_TRUE(request->isReady());
+        const osg::Vec2f limitedEnd = getTileCenter(mSettings, TilePosition(0, 1));
+        EXPECT_THAT(request->getEnd(), Vec3fEq(limitedEnd.x(), limitedEnd.y(), 1));
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, request_path_with_max_distance_and_without_tile_graph_should_limit_end_by_line)
+    {
+        const PathQuery query {.mAgentBounds = mAgentBounds, .mStepSize = mStepSize, .mStart = osg::Vec3f(0, 0, 0),
+            .mEnd = osg::Vec3f(300, 400, 0), .mIncludeFlags = Flag_walk, .mMaxDistance = 50};
+        const auto request = mNavigator->requestPath(query);
+        ASSERT_TRUE(request->isReady());
+        EXPECT_THAT(request->getEnd(), Vec3fEq(30, 40, 0));
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, tiles_generated_at_runtime_should_update_tile_graph)
+    {
+        mNavigator.reset(new NavigatorImpl(mSettings, makeDbWithTileGraph(mSettings, mWorldspace, mAgentBounds,
+            {TileGraphNode {TilePosition(100, 100), allSides}})));
+
+        const HeightfieldPlane plane {100};
+        const int cellSize = mHeightfieldTileSize * 4;
+
+        mNavigator->setWorldspace(mWorldspace);
+        mNavigator->addAgent(mAgentBounds);
+        mNavigator->addHeightfield(mCellPosition, cellSize, plane);
+        mNavigator->update(mPlayerPosition);
+        mNavigator->wait(mListener, WaitConditionType::allJobsDone);
+
+        const TilePosition playerTile = getTilePosition(mSettings.mRecast,
+            toNavMeshCoordinates(mSettings.mRecast, mPlayerPosition));
+        EXPECT_THAT(mNavigator->findTileRoute(mAgentBounds, mPlayerPosition, mPlayerPosition),
+            ElementsAre(getTileCenter(mSettings, playerTile)));
+    }
 }
@@ -178,4 +178,32 @@ namespace
         };
         EXPECT_THROW(f(), std::runtime_error);
     }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, replaced_tile_graph_should_be_found_by_key)
+    {
+        const std::string worldspace = "sys::default";
+        const std::vector<std::byte> input = generateData();
+        EXPECT_FALSE(mDb.getTileGraph(worldspace, input).has_value());
+        ASSERT_EQ(mDb.replaceTileGraph(worldspace, input, TileVersion {1}, generateData()), 1);
+        const std::vector<std::byte> data = generateData();
+        ASSERT_EQ(mDb.replaceTileGraph(worldspace, input, TileVersion {2}, data), 1);
+        const auto result = mDb.getTileGraph(worldspace, input);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(result->mVersion, TileVersion {2});
+        EXPECT_EQ(result->mData, data);
+        EXPECT_FALSE(mDb.getTileGraph("other", input).has_value());
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, inserted_tile_data_should_be_found_by_id)
+    {
+        const TileId tileId {146};
+        const TileVersion version {1};
+        const auto [worldspace, tilePosition, input, data] = insertTile(tileId, version);
+        const auto result = mDb.getTileDataById(tileId);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(result->mTileId, tileId);
+        EXPECT_EQ(result->mVersion, version);
+        EXPECT_EQ(result->mData, data);
+        EXPECT_FALSE(mDb.getTileDataById(TileId {147}).has_value());
+    }
 }
@@ -41,6 +41,8 @@ namespace DetourNavigator
             result.mDetour.mMaxPolys = 4096;
             result.mMaxTilesNumber = 512;
             result.mMinUpdateInterval = std::chrono::milliseconds(50);
+            result.mAsyncPathFinderThreads = 1;
+            result.mAsyncPathFinderFrameBudget = std::chrono::milliseconds(0);
             result.mWriteToNavMeshDb = true;
             return result;
         }
@@ -0,0 +1,154 @@
+#include <components/detournavigator/serialization.hpp>
+#include <components/detournavigator/tilegraph.hpp>
+
+#include <Recast.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+
+    constexpr TileSides allSides = TileSide_negativeX | TileSide_positiveY | TileSide_positiveX | TileSide_negativeY;
+
+    // Builds a graph of fully connected tiles from rows where '#' is a tile and any other character is a gap
+    TileGraph makeGraph(const std::vector<std::string>& rows)
+    {
+        std::vector<TileGraphNode> nodes;
+        for (std::size_t y = 0; y < rows.size(); ++y)
+            for (std::size_t x = 0; x < rows[y].size(); ++x)
+                if (rows[y][x] == '#')
+                    nodes.push_back(TileGraphNode {TilePosition(static_cast<int>(x), static_cast<int>(y)), allSides});
+        return TileGraph(std::move(nodes));
+    }
+
+    TEST(DetourNavigatorTileGraphTest, find_route_should_return_empty_for_absent_tiles)
+    {
+        const TileGraph graph = makeGraph({"##"});
+        EXPECT_THAT(graph.findRoute(TilePosition(0, 0), TilePosition(5, 0)), IsEmpty());
+        EXPECT_THAT(graph.findRoute(TilePosition(5, 0), TilePosition(0, 0)), IsEmpty());
+    }
+
+    TEST(DetourNavigatorTileGraphTest, find_route_should_return_single_tile_for_same_start_and_end)
+    {
+        const TileGraph graph = makeGraph({"##"});
+        EXPECT_THAT(graph.findRoute(TilePosition(1, 0), TilePosition(1, 0)), ElementsAre(TilePosition(1, 0)));
+    }
+
+    TEST(DetourNavigatorTileGraphTest, find_route_should_return_straight_line_for_connected_tiles)
+    {
+        const TileGraph graph = makeGraph({"####"});
+        EXPECT_THAT(graph.findRoute(TilePosition(0, 0), TilePosition(3, 0)),
+            ElementsAre(TilePosition(0, 0), TilePosition(1, 0), TilePosition(2, 0), TilePosition(3, 0)));
+    }
+
+    TEST(DetourNavigatorTileGraphTest, find_route_should_go_around_gap)
+    {
+        const TileGraph graph = makeGraph({
+            "#.#",
+            "#.#",
+            "###",
+        });
+        EXPECT_THAT(graph.findRoute(TilePosition(0, 0), TilePosition(2, 0)),
+            ElementsAre(TilePosition(0, 0), TilePosition(0, 1), TilePosition(0, 2), TilePosition(1, 2),
+                TilePosition(2, 2), TilePosition(2, 1), TilePosition(2, 0)));
+    }
+
+    TEST(DetourNavigatorTileGraphTest, find_route_should_return_empty_for_disconnected_tiles)
+    {
+        const TileGraph graph = makeGraph({"##.##"});
+        EXPECT_THAT(graph.findRoute(TilePosition(0, 0), TilePosition(4, 0)), IsEmpty());
+    }
+
+    TEST(DetourNavigatorTileGraphTest, find_route_should_return_empty_when_visited_nodes_limit_is_exceeded)
+    {
+        const TileGraph graph = makeGraph({
+            "#.#",
+            "#.#",
+            "###",
+        });
+        TileRouteSearch search;
+        EXPECT_THAT(graph.findRoute(TilePosition(0, 0), TilePosition(2, 0), 3, search), IsEmpty());
+        EXPECT_THAT(graph.findRoute(TilePosition(0, 0), TilePosition(2, 0), 6, search), SizeIs(7));
+    }
+
+    TEST(DetourNavigatorTileGraphTest, find_route_should_provide_same_routes_when_search_is_reused)
+    {
+        const TileGraph graph = makeGraph({
+            "#.#",
+            "#.#",
+            "###",
+        });
+        const TileGraph smallGraph = makeGraph({"##"});
+        TileRouteSearch search;
+        const std::vector<TilePosition> expected = graph.findRoute(TilePosition(0, 0), TilePosition(2, 0));
+        EXPECT_EQ(graph.findRoute(TilePosition(0, 0), TilePosition(2, 0), maxTileRouteVisitedNodes, search), expected);
+        EXPECT_THAT(smallGraph.findRoute(TilePosition(1, 0), TilePosition(0, 0), maxTileRouteVisitedNodes, search),
+            ElementsAre(TilePosition(1, 0), TilePosition(0, 0)));
+        EXPECT_EQ(graph.findRoute(TilePosition(0, 0), TilePosition(2, 0), maxTileRouteVisitedNodes, search), expected);
+    }
+
+    TEST(DetourNavigatorTileGraphTest, find_route_should_not_visit_nodes_for_end_in_other_component)
+    {
+        const TileGraph graph = makeGraph({"##########.#"});
+        TileRouteSearch search;
+        EXPECT_THAT(graph.findRoute(TilePosition(0, 0), TilePosition(11, 0), 0, search), IsEmpty());
+        EXPECT_THAT(graph.findRoute(TilePosition(0, 0), TilePosition(11, 0)), IsEmpty());
+    }
+
+    TEST(DetourNavigatorTileGraphTest, tiles_should_be_connected_only_when_both_have_portals_on_shared_side)
+    {
+        const TileGraph graph({
+            TileGraphNode {TilePosition(0, 0), TileSide_positiveX},
+            TileGraphNode {TilePosition(1, 0), TileSide_positiveY},
+            TileGraphNode {TilePosition(1, 1), TileSide_negativeY},
+        });
+        EXPECT_FALSE(graph.isConnected(TilePosition(0, 0), TileSide_positiveX));
+        EXPECT_TRUE(graph.isConnected(TilePosition(1, 0), TileSide_positiveY));
+        EXPECT_TRUE(graph.isConnected(TilePosition(1, 1), TileSide_negativeY));
+        EXPECT_THAT(graph.findRoute(TilePosition(0, 0), TilePosition(1, 1)), IsEmpty());
+        EXPECT_THAT(graph.findRoute(TilePosition(1, 1), TilePosition(1, 0)),
+            ElementsAre(TilePosition(1, 1), TilePosition(1, 0)));
+    }
+
+    TEST(DetourNavigatorTileGraphTest, get_portal_sides_should_collect_border_edges_of_walkable_polygons)
+    {
+        constexpr int nvp = 3;
+        std::vector<unsigned short> polys {
+            0, 1, 2, 0x8000 | 0, RC_MESH_NULL_IDX, 1,
+            1, 2, 3, 0, 0x8000 | 2, RC_MESH_NULL_IDX,
+            2, 3, 4, 0x8000 | 1, RC_MESH_NULL_IDX, RC_MESH_NULL_IDX,
+        };
+        std::vector<unsigned short> flags {1, 1, 0};
+        rcPolyMesh polyMesh {};
+        polyMesh.polys = polys.data();
+        polyMesh.flags = flags.data();
+        polyMesh.npolys = 3;
+        polyMesh.maxpolys = 3;
+        polyMesh.nvp = nvp;
+        EXPECT_EQ(getPortalSides(polyMesh), TileSide_negativeX | TileSide_positiveX);
+        polyMesh.polys = nullptr;
+        polyMesh.flags = nullptr;
+    }
+
+    TEST(DetourNavigatorTileGraphTest, serialized_graph_should_be_deserialized_to_the_same_nodes)
+    {
+        const TileGraph graph({
+            TileGraphNode {TilePosition(-3, 4), static_cast<TileSides>(TileSide_positiveX | TileSide_negativeY)},
+            TileGraphNode {TilePosition(7, -1), TileSide_negativeX},
+        });
+        TileGraph result;
+        ASSERT_TRUE(deserialize(serialize(graph), result));
+        ASSERT_EQ(result.size(), graph.size());
+        for (std::size_t i = 0; i < graph.size(); ++i)
+        {
+            EXPECT_EQ(result.getNodes()[i].mPosition, graph.getNodes()[i].mPosition);
+            EXPECT_EQ(result.getNodes()[i].mSides, graph.getNodes()[i].mSides);
+        }
+    }
+}
@@ -0,0 +1,100 @@
+#include <components/files/compressedstream.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    using namespace testing;
+    using namespace Files;
+
+    std::string generateData(std::size_t size)
+    {
+        std::string result;
+        result.reserve(size);
+        for (std::size_t i = 0; i < size; ++i)
+            result.push_back(static_cast<char>('a' + (i * 7 + i / 13) % 26));
+        return result;
+    }
+
+    std::unique_ptr<std::istream> makeCompressedStream(std::string_view data, std::uint32_t blockSize)
+    {
+        std::ostringstream stream;
+        writeCompressedStream(stream, data, blockSize);
+        return std::make_unique<std::istringstream>(stream.str());
+    }
+
+    TEST(FilesCompressedStreamTest, isCompressedStreamShouldReturnFalseForPlainData)
+    {
+        std::istringstream stream("TES3 plain data");
+        EXPECT_FALSE(isCompressedStream(stream));
+        EXPECT_EQ(stream.tellg(), 0);
+    }
+
+    TEST(FilesCompressedStreamTest, isCompressedStreamShouldReturnTrueForCompressedData)
+    {
+        const std::unique_ptr<std::istream> stream = makeCompressedStream("data", 16);
+        EXPECT_TRUE(isCompressedStream(*stream));
+        EXPECT_EQ(stream->tellg(), 0);
+    }
+
+    TEST(FilesCompressedStreamTest, shouldReadWrittenData)
+    {
+        const std::string data = generateData(1000);
+        const IStreamPtr stream = openCompressedStream(makeCompressedStream(data, 64));
+        const std::string result((std::istreambuf_iterator<char>(*stream)), std::istreambuf_iterator<char>());
+        EXPECT_EQ(result, data);
+    }
+
+    TEST(FilesCompressedStreamTest, shouldReadEmptyData)
+    {
+        const IStreamPtr stream = openCompressedStream(makeCompressedStream("", 64));
+        EXPECT_EQ(stream->get(), std::char_traits<char>::eof());
+        EXPECT_TRUE(stream->eof());
+    }
+
+    TEST(FilesCompressedStreamTest, shouldSeekToAnyBlock)
+    {
+        const std::string data = generateData(1000);
+        const IStreamPtr stream = openCompressedStream(makeCompressedStream(data, 64));
+        for (std::size_t position : {900, 10, 64, 63, 999, 0})
+        {
+            stream->seekg(static_cast<std::streamoff>(position));
+            std::string result(4, '\0');
+            stream->read(result.data(), static_cast<std::streamsize>(result.size()));
+            EXPECT_EQ(result.substr(0, static_cast<std::size_t>(stream->gcount())), data.substr(position, 4))
+                << position;
+            stream->clear();
+        }
+    }
+
+    TEST(FilesCompressedStreamTest, tellgShouldReturnDecompressedPosition)
+    {
+        const std::string data = generateData(1000);
+        const IStreamPtr stream = openCompressedStream(makeCompressedStream(data, 64));
+        std::string result(100, '\0');
+        stream->read(result.data(), static_cast<std::streamsize>(result.size()));
+        EXPECT_EQ(stream->tellg(), 100);
+        stream->seekg(0, std::ios_base::end);
+        EXPECT_EQ(stream->tellg(), 1000);
+    }
+
+    TEST(FilesCompressedStreamTest, readAfterEndShouldSetEof)
+    {
+        const std::string data = generateData(100);
+        const IStreamPtr stream = openCompressedStream(makeCompressedStream(data, 64));
+        std::string result(200, '\0');
+        stream->read(result.data(), static_cast<std::streamsize>(result.size()));
+        EXPECT_EQ(stream->gcount(), 100);
+        EXPECT_TRUE(stream->eof());
+    }
+
+    TEST(FilesCompressedStreamTest, openCompressedStreamShouldThrowForPlainData)
+    {
+        EXPECT_THROW(openCompressedStream(std::make_unique<std::istringstream>("TES3 plain data")),
+            std::runtime_error);
+    }
+}
@@ -111,6 +111,17 @@ return {
         end,
     },
 }
+)X");
+
+    VFSTestFile allocateScript(R"X(
+local data = {}
+return {
+    engineHandlers = {
+        onUpdate = function()
+            for i = 1, 100000 do data[i] = tostring(i) end
+        end,
+    },
+}
 )X");
 
     struct LuaScriptsContainerTest : Test
@@ -127,6 +138,7 @@ return {
             {"testInterface.lua", &interfaceScript},
             {"overrideInterface.lua", &overrideInterfaceScript},
             {"useInterface.lua", &useInterfaceScript},
+            {"allocate.lua", &allocateScript},
         });
 
         LuaUtil::ScriptsConfiguration mCfg;
@@ -147,6 +159,7 @@ CUSTOM, NPC: loadSave2.lua
 CUSTOM, PLAYER: testInterface.lua
 CUSTOM, PLAYER: overrideInterface.lua
 CUSTOM, PLAYER: useInterface.lua
+CUSTOM: allocate.lua
 )X");
             mCfg.init(std::move(cfg));
         }
@@ -468,4 +481,43 @@ CUSTOM, PLAYER: useInterface.lua
         EXPECT_EQ(internal::GetCapturedStdout(), "Ignored callback to the removed script some_script.lua\n");
     }
 
+    TEST_F(LuaScriptsContainerTest, ProfilerShouldRecordHandlerCallsAndMemory)
+    {
+        LuaUtil::LuaState lua(mVFS.get(), &mCfg, LuaUtil::LuaStateSettings {true, 0});
+        if (!lua.isProfilerEnabled())
+            GTEST_SKIP() << "Lua runtime doesn't support custom allocators";
+        LuaUtil::ScriptsContainer scripts(&lua, "Test");
+        const int scriptId = *mCfg.findId("test1.lua");
+        testing::internal::CaptureStdout();
+        EXPECT_TRUE(scripts.addCustomScript(scriptId));
+        scripts.update(1.5f);
+        scripts.update(1.5f);
+        internal::GetCapturedStdout();
+
+        const LuaUtil::LuaState::ScriptStats& stats = lua.getScriptStats().at(scriptId);
+        EXPECT_EQ(stats.mHandlers.at("onUpdate").mCalls, 2u);
+        EXPECT_EQ(stats.mHandlers.at("start").mCalls, 1u);
+        EXPECT_GT(stats.mMemoryUsage, 0);
+        EXPECT_GT(lua.getTotalMemoryUsage(), stats.mMemoryUsage);
+
+        lua.resetHandlersStats();
+        EXPECT_TRUE(lua.getScriptStats().at(scriptId).mHandlers.empty());
+    }
+
+    TEST_F(LuaScriptsContainerTest, ScriptMemoryLimitShouldFailAllocations)
+    {
+        constexpr std::int64_t limit = 256 * 1024;
+        LuaUtil::LuaState lua(mVFS.get(), &mCfg, LuaUtil::LuaStateSettings {true, limit});
+        if (!lua.isProfilerEnabled())
+            GTEST_SKIP() << "Lua runtime doesn't support custom allocators";
+        LuaUtil::ScriptsContainer scripts(&lua, "Test");
+        const int scriptId = *mCfg.findId("allocate.lua");
+        testing::internal::CaptureStdout();
+        EXPECT_TRUE(scripts.addCustomScript(scriptId));
+        scripts.update(1.5f);
+        const std::string output = internal::GetCapturedStdout();
+        EXPECT_THAT(output, HasSubstr("Lua script allocate.lua exceeded memory limit"));
+        EXPECT_THAT(output, HasSubstr("Test[allocate.lua] onUpdate failed."));
+        EXPECT_LE(lua.getScriptStats().at(scriptId).mMemoryUsage, limit);
+    }
 }
@@ -0,0 +1,163 @@
+#include <components/misc/spatialgrid.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    std::vector<int> getInRadius(const SpatialGrid<int>& grid, const osg::Vec3f& center, float radius)
+    {
+        std::vector<int> result;
+        grid.forEachInRadius(center, radius, [&] (int key, const osg::Vec3f& /*position*/) { result.push_back(key); });
+        return result;
+    }
+
+    TEST(MiscSpatialGridTest, forEachInRadiusShouldVisitOnlyObjectsWithinRadius)
+    {
+        SpatialGrid<int> grid(100);
+        grid.insert(1, osg::Vec3f(0, 0, 0));
+        grid.insert(2, osg::Vec3f(50, 50, 0));
+        grid.insert(3, osg::Vec3f(250, 0, 0));
+        grid.insert(4, osg::Vec3f(-150, -20, 0));
+        grid.insert(5, osg::Vec3f(0, 0, 500));
+        EXPECT_THAT(getInRadius(grid, osg::Vec3f(0, 0, 0), 160), UnorderedElementsAre(1, 2, 4));
+    }
+
+    TEST(MiscSpatialGridTest, forEachInRadiusShouldVisitObjectsOnTheBoundary)
+    {
+        SpatialGrid<int> grid(100);
+        grid.insert(1, osg::Vec3f(200, 0, 0));
+        EXPECT_THAT(getInRadius(grid, osg::Vec3f(0, 0, 0), 200), ElementsAre(1));
+    }
+
+    TEST(MiscSpatialGridTest, forEachInRadiusShouldSupportRadiusCoveringManyCells)
+    {
+        SpatialGrid<int> grid(1);
+        grid.insert(1, osg::Vec3f(-1000, 0, 0));
+        grid.insert(2, osg::Vec3f(1000, 1000, 0));
+        grid.insert(3, osg::Vec3f(5000, 0, 0));
+        EXPECT_THAT(getInRadius(grid, osg::Vec3f(0, 0, 0), 2000), UnorderedElementsAre(1, 2));
+        EXPECT_THAT(getInRadius(grid, osg::Vec3f(0, 0, 0), std::numeric_limits<float>::max()),
+            UnorderedElementsAre(1, 2, 3));
+    }
+
+    TEST(MiscSpatialGridTest, moveShouldUpdatePosition)
+    {
+        SpatialGrid<int> grid(100);
+        grid.insert(1, osg::Vec3f(0, 0, 0));
+        grid.insert(2, osg::Vec3f(10, 0, 0));
+        grid.insert(3, osg::Vec3f(20, 0, 0));
+        EXPECT_TRUE(grid.move(1, osg::Vec3f(1000, 0, 0)));
+        EXPECT_TRUE(grid.move(3, osg::Vec3f(30, 0, 0)));
+        EXPECT_THAT(getInRadius(grid, osg::Vec3f(0, 0, 0), 50), UnorderedElementsAre(2, 3));
+        EXPECT_THAT(getInRadius(grid, osg::Vec3f(1000, 0, 0), 50), ElementsAre(1));
+        EXPECT_EQ(grid.size(), 3);
+    }
+
+    TEST(MiscSpatialGridTest, moveShouldIgnoreNotAddedObject)
+    {
+        SpatialGrid<int> grid(100);
+        EXPECT_FALSE(grid.move(1, osg::Vec3f(0, 0, 0)));
+        EXPECT_TRUE(grid.empty());
+    }
+
+    TEST(MiscSpatialGridTest, insertShouldMoveAlreadyAddedObject)
+    {
+        SpatialGrid<int> grid(100);
+        grid.insert(1, osg::Vec3f(0, 0, 0));
+        grid.insert(1, osg::Vec3f(500, 0, 0));
+        EXPECT_EQ(grid.size(), 1);
+        EXPECT_THAT(getInRadius(grid, osg::Vec3f(500, 0, 0), 10), ElementsAre(1));
+    }
+
+    TEST(MiscSpatialGridTest, eraseShouldKeepOtherObjectsInTheSameCell)
+    {
+        SpatialGrid<int> grid(100);
+        grid.insert(1, osg::Vec3f(0, 0, 0));
+        grid.insert(2, osg::Vec3f(10, 0, 0));
+        grid.insert(3, osg::Vec3f(20, 0, 0));
+        EXPECT_TRUE(grid.erase(1));
+        EXPECT_FALSE(grid.erase(1));
+        EXPECT_TRUE(grid.move(3, osg::Vec3f(1000, 0, 0)));
+        EXPECT_TRUE(grid.erase(2));
+        EXPECT_THAT(getInRadius(grid, osg::Vec3f(0, 0, 0), 100), IsEmpty());
+        EXPECT_THAT(getInRadius(grid, osg::Vec3f(1000, 0, 0), 100), ElementsAre(3));
+    }
+
+    TEST(MiscSpatialGridTest, shouldFindObjectsOutsideOfCoveredArea)
+    {
+        SpatialGrid<int> grid(100, 4);
+        grid.insert(1, osg::Vec3f(0, 0, 0));
+        grid.insert(2, osg::Vec3f(150, 150, 0));
+        grid.insert(3, osg::Vec3f(10000, 0, 0));
+        grid.insert(4, osg::Vec3f(-10000, 0, 0));
+        EXPECT_THAT(getInRadius(grid, osg::Vec3f(0, 0, 0), 500), UnorderedElementsAre(1, 2));
+        EXPECT_THAT(getInRadius(grid, osg::Vec3f(10000, 0, 0), 500), ElementsAre(3));
+        EXPECT_TRUE(grid.move(1, osg::Vec3f(-10000, 50, 0)));
+        EXPECT_THAT(getInRadius(grid, osg::Vec3f(-10000, 0, 0), 500), UnorderedElementsAre(1, 4));
+        EXPECT_THAT(getInRadius(grid, osg::Vec3f(0, 0, 0), 50000), UnorderedElementsAre(1, 2, 3, 4));
+    }
+
+    TEST(MiscSpatialGridTest, shouldFollowObjectsMovingAwayFromCoveredArea)
+    {
+        SpatialGrid<int> grid(100, 4);
+        for (int i = 0; i < 64; ++i)
+            grid.insert(i, osg::Vec3f(0, 0, 0));
+        for (int i = 0; i < 64; ++i)
+            EXPECT_TRUE(grid.move(i, osg::Vec3f(100000, 100000, 0)));
+        EXPECT_THAT(getInRadius(grid, osg::Vec3f(0, 0, 0), 500), IsEmpty());
+        EXPECT_EQ(getInRadius(grid, osg::Vec3f(100000, 100000, 0), 1).size(), 64);
+    }
+
+    TEST(MiscSpatialGridTest, anyInRadiusShouldStopOnFirstMatch)
+    {
+        SpatialGrid<int> grid(100);
+        grid.insert(1, osg::Vec3f(0, 0, 0));
+        grid.insert(2, osg::Vec3f(10, 0, 0));
+        int visited = 0;
+        EXPECT_TRUE(grid.anyInRadius(osg::Vec3f(0, 0, 0), 100, [&] (int, const osg::Vec3f&) { ++visited; return true; }));
+        EXPECT_EQ(visited, 1);
+        EXPECT_FALSE(grid.anyInRadius(osg::Vec3f(0, 0, 0), 100, [] (int key, const osg::Vec3f&) { return key == 3; }));
+    }
+
+    // Actors::update relies on this to give engageCombat the same actors as iterating over all of them
+    TEST(MiscSpatialGridTest, forEachInRadiusShouldVisitSameObjectsAsLinearSearch)
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> coordinate(-10000, 10000);
+        SpatialGrid<int> grid(2048);
+        std::vector<osg::Vec3f> positions;
+        for (int i = 0; i < 500; ++i)
+        {
+            positions.emplace_back(coordinate(random), coordinate(random), coordinate(random) / 10);
+            grid.insert(i, positions.back());
+        }
+        for (int i = 0; i < 100; ++i)
+        {
+            const std::size_t moved = static_cast<std::size_t>(i) * 5;
+            positions[moved] = osg::Vec3f(coordinate(random), coordinate(random), 0);
+            EXPECT_TRUE(grid.move(static_cast<int>(moved), positions[moved]));
+        }
+        for (const float radius : {200.f, 2048.f, 7168.f})
+        {
+            for (const osg::Vec3f& center : positions)
+            {
+                std::vector<int> expected;
+                for (std::size_t i = 0; i < positions.size(); ++i)
+                    if ((positions[i] - center).length2() <= radius * radius)
+                        expected.push_back(static_cast<int>(i));
+                std::vector<int> actual = getInRadius(grid, center, radius);
+                std::sort(actual.begin(), actual.end());
+                EXPECT_EQ(actual, expected) << "radius=" << radius;
+            }
+        }
+    }
+}
@@ -0,0 +1,300 @@
+#include "apps/openmw/mwdialogue/filterindex.hpp"
+
+#include <components/esm3/loaddial.hpp>
+#include <components/esm3/loadinfo.hpp>
+#include <components/misc/strings/algorithm.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWDialogue;
+
+    struct Speaker
+    {
+        std::string mActorId;
+        std::string mRace;
+        std::string mClass;
+        std::string mFaction;
+        std::string mPlayerCell;
+        bool mIsCreature = false;
+    };
+
+    // Same branches as Filter::testActor and Filter::testPlayer take for the conditions FilterIndex uses. Rank,
+    // gender and player faction checks are skipped, they can only reject more infos.
+    bool isAccepted(const ESM::DialInfo& info, const Speaker& speaker)
+    {
+        if (!info.mActor.empty())
+        {
+            if (!Misc::StringUtils::ciEqual(info.mActor, speaker.mActorId))
+                return false;
+        }
+        else if (speaker.mIsCreature)
+            return false;
+
+        if (!info.mRace.empty())
+        {
+            if (speaker.mIsCreature)
+                return true;
+            if (!Misc::StringUtils::ciEqual(info.mRace, speaker.mRace))
+                return false;
+        }
+
+        if (!info.mClass.empty())
+        {
+            if (speaker.mIsCreature)
+                return true;
+            if (!Misc::StringUtils::ciEqual(info.mClass, speaker.mClass))
+                return false;
+        }
+
+        if (info.mFactionLess)
+        {
+            if (speaker.mIsCreature)
+                return true;
+            if (!speaker.mFaction.empty())
+                return false;
+        }
+        else if (!info.mFaction.empty())
+        {
+            if (speaker.mIsCreature)
+                return true;
+            if (!Misc::StringUtils::ciEqual(info.mFaction, speaker.mFaction))
+                return false;
+        }
+
+        if (!info.mCell.empty())
+        {
+            const std::string_view playerCell = speaker.mPlayerCell;
+            if (playerCell.length() < info.mCell.length()
+                || !Misc::StringUtils::ciEqual(playerCell.substr(0, info.mCell.length()), info.mCell))
+                return false;
+        }
+
+        return true;
+    }
+
+    ESM::DialInfo makeInfo(const std::string& id)
+    {
+        ESM::DialInfo info;
+        info.mId = id;
+        info.mFactionLess = false;
+        return info;
+    }
+
+    std::vector<const ESM::DialInfo*> getAccepted(const ESM::Dialogue& dialogue, const Speaker& speaker)
+    {
+        std::vector<const ESM::DialInfo*> result;
+        for (const ESM::DialInfo& info : dialogue.mInfo)
+            if (isAccepted(info, speaker))
+                result.push_back(&info);
+        return result;
+    }
+
+    std::vector<std::string> getIds(const std::vector<const ESM::DialInfo*>& infos)
+    {
+        std::vector<std::string> result;
+        for (const ESM::DialInfo* info : infos)
+            result.push_back(info->mId);
+        return result;
+    }
+
+    struct MWDialogueFilterIndexTest : Test
+    {
+        ESM::Dialogue mDialogue;
+        FilterIndex mIndex;
+        Speaker mSpeaker {"fargoth", "Wood Elf", "Commoner", "", "Seyda Neen, Arrille's Tradehouse"};
+
+        MWDialogueFilterIndexTest()
+        {
+            mDialogue.mId = "topic";
+            mDialogue.mType = ESM::Dialogue::Topic;
+        }
+
+        ESM::DialInfo& addInfo(const std::string& id)
+        {
+            return mDialogue.mInfo.emplace_back(makeInfo(id));
+        }
+
+        std::vector<std::string> getCandidates(const Speaker& speaker)
+        {
+            mIndex.add(mDialogue);
+            const FilterIndexKey key = mIndex.makeKey(speaker.mActorId, speaker.mRace, speaker.mClass,
+                speaker.mFaction, speaker.mPlayerCell, speaker.mIsCreature);
+            const std::vector<const ESM::DialInfo*> candidates = mIndex.getCandidates(mDialogue, key);
+            EXPECT_THAT(candidates, IsSupersetOf(getAccepted(mDialogue, speaker)));
+            return getIds(candidates);
+        }
+    };
+
+    TEST_F(MWDialogueFilterIndexTest, shouldReturnAllInfosForNotIndexedDialogue)
+    {
+        addInfo("0").mActor = "other";
+        addInfo("1").mRace = "Dark Elf";
+        const FilterIndexKey key = mIndex.makeKey(mSpeaker.mActorId, mSpeaker.mRace, mSpeaker.mClass,
+            mSpeaker.mFaction, mSpeaker.mPlayerCell, mSpeaker.mIsCreature);
+        EXPECT_THAT(getIds(mIndex.getCandidates(mDialogue, key)), ElementsAre("0", "1"));
+    }
+
+    TEST_F(MWDialogueFilterIndexTest, shouldReturnInfosWithoutConditionsForAnyNpc)
+    {
+        addInfo("0");
+        addInfo("1").mPcFaction = "Mages Guild";
+        EXPECT_THAT(getCandidates(mSpeaker), ElementsAre("0", "1"));
+    }
+
+    TEST_F(MWDialogueFilterIndexTest, shouldFilterByActorIdCaseInsensitively)
+    {
+        addInfo("0").mActor = "Fargoth";
+        addInfo("1").mActor = "hrisskar flat-foot";
+        EXPECT_THAT(getCandidates(mSpeaker), ElementsAre("0"));
+    }
+
+    TEST_F(MWDialogueFilterIndexTest, shouldFilterByRace)
+    {
+        addInfo("0").mRace = "Dark Elf";
+        addInfo("1").mRace = "wood elf";
+        EXPECT_THAT(getCandidates(mSpeaker), ElementsAre("1"));
+    }
+
+    TEST_F(MWDialogueFilterIndexTest, shouldFilterByClass)
+    {
+        addInfo("0").mClass = "commoner";
+        addInfo("1").mClass = "Guard";
+        EXPECT_THAT(getCandidates(mSpeaker), ElementsAre("0"));
+    }
+
+    TEST_F(MWDialogueFilterIndexTest, shouldFilterByFaction)
+    {
+        addInfo("0").mFaction = "Mages Guild";
+        addInfo("1").mFaction = "Fighters Guild";
+        mSpeaker.mFaction = "mages guild";
+        EXPECT_THAT(getCandidates(mSpeaker), ElementsAre("0"));
+    }
+
+    TEST_F(MWDialogueFilterIndexTest, shouldNotFilterFactionlessInfosByFaction)
+    {
+        ESM::DialInfo& info = addInfo("0");
+        info.mFactionLess = true;
+        info.mFaction = "FFFF";
+        mSpeaker.mFaction = "Mages Guild";
+        EXPECT_THAT(getCandidates(mSpeaker), ElementsAre("0"));
+    }
+
+    TEST_F(MWDialogueFilterIndexTest, shouldFilterByPlayerCellPrefix)
+    {
+        addInfo("0").mCell = "Seyda Neen";
+        addInfo("1").mCell = "seyda neen, arrille's tradehouse";
+        addInfo("2").mCell = "Balmora";
+        addInfo("3").mCell = "Seyda Neen, Arrille's Tradehouse, Upstairs";
+        EXPECT_THAT(getCandidates(mSpeaker), ElementsAre("0", "1"));
+    }
+
+    TEST_F(MWDialogueFilterIndexTest, shouldReportCellConditionsOnlyForDialoguesHavingThem)
+    {
+        EXPECT_FALSE(mIndex.hasCellConditions(mDialogue));
+        addInfo("0").mRace = "Dark Elf";
+        ESM::DialInfo& info = addInfo("1");
+        info.mRace = "Wood Elf";
+        info.mCell = "Seyda Neen";
+        mIndex.add(mDialogue);
+        EXPECT_FALSE(mIndex.hasCellConditions(mDialogue));
+        addInfo("2").mCell = "Seyda Neen";
+        mIndex.add(mDialogue);
+        EXPECT_TRUE(mIndex.hasCellConditions(mDialogue));
+    }
+
+    TEST_F(MWDialogueFilterIndexTest, setPlayerCellShouldReplacePlayerCellsOfKey)
+    {
+        addInfo("0").mCell = "Seyda Neen";
+        addInfo("1").mCell = "Balmora";
+        mIndex.add(mDialogue);
+        FilterIndexKey key = mIndex.makeKey(mSpeaker.mActorId, mSpeaker.mRace, mSpeaker.mClass,
+            mSpeaker.mFaction, {}, mSpeaker.mIsCreature);
+        EXPECT_THAT(getIds(mIndex.getCandidates(mDialogue, key)), ElementsAre());
+        mIndex.setPlayerCell("Balmora, Guild of Mages", key);
+        EXPECT_THAT(getIds(mIndex.getCandidates(mDialogue, key)), ElementsAre("1"));
+        mIndex.setPlayerCell("Seyda Neen", key);
+        EXPECT_THAT(getIds(mIndex.getCandidates(mDialogue, key)), ElementsAre("0"));
+    }
+
+    TEST_F(MWDialogueFilterIndexTest, shouldUseOnlyFirstConditionInTestOrder)
+    {
+        ESM::DialInfo& info = addInfo("0");
+        info.mActor = "fargoth";
+        info.mRace = "Dark Elf";
+        ESM::DialInfo& other = addInfo("1");
+        other.mRace = "Dark Elf";
+        other.mCell = "Seyda Neen";
+        EXPECT_THAT(getCandidates(mSpeaker), ElementsAre("0"));
+    }
+
+    TEST_F(MWDialogueFilterIndexTest, shouldReturnOnlyActorSpecificInfosForCreature)
+    {
+        addInfo("0");
+        addInfo("1").mActor = "mudcrab";
+        addInfo("2").mRace = "Dark Elf";
+        addInfo("3").mCell = "Seyda Neen";
+        EXPECT_THAT(getCandidates(Speaker {"mudcrab", "", "", "", "Seyda Neen", true}), ElementsAre("1"));
+    }
+
+    TEST_F(MWDialogueFilterIndexTest, shouldNotMatchSpeakerPropertiesUnknownToIndex)
+    {
+        addInfo("0").mRace = "Dark Elf";
+        addInfo("1").mFaction = "Mages Guild";
+        addInfo("2");
+        EXPECT_THAT(getCandidates(Speaker {"unknown", "unknown", "unknown", "", "unknown"}), ElementsAre("2"));
+    }
+
+    TEST_F(MWDialogueFilterIndexTest, candidatesShouldIncludeAcceptedInfosForRandomConditions)
+    {
+        const std::vector<std::string> actors {"fargoth", "Fargoth", "mudcrab", "hrisskar"};
+        const std::vector<std::string> races {"Wood Elf", "dark elf", "Nord"};
+        const std::vector<std::string> classes {"Commoner", "guard"};
+        const std::vector<std::string> factions {"Mages Guild", "fighters guild"};
+        const std::vector<std::string> cells {"Seyda Neen", "seyda neen, arrille's tradehouse", "Balmora"};
+
+        std::minstd_rand random;
+        const auto pick = [&] (const std::vector<std::string>& values)
+        {
+            // Empty string is a wildcard condition
+            const auto index = std::uniform_int_distribution<std::size_t>(0, values.size())(random);
+            return index == values.size() ? std::string() : values[index];
+        };
+
+        for (int i = 0; i < 200; ++i)
+        {
+            ESM::DialInfo& info = addInfo(std::to_string(i));
+            info.mActor = pick(actors);
+            info.mRace = pick(races);
+            info.mClass = pick(classes);
+            info.mFaction = pick(factions);
+            info.mFactionLess = std::uniform_int_distribution<int>(0, 9)(random) == 0;
+            info.mCell = pick(cells);
+        }
+        mIndex.add(mDialogue);
+
+        for (int i = 0; i < 200; ++i)
+        {
+            const bool isCreature = std::uniform_int_distribution<int>(0, 3)(random) == 0;
+            Speaker speaker {pick(actors), pick(races), pick(classes), pick(factions), pick(cells), isCreature};
+            speaker.mPlayerCell += ", Cellar";
+            const FilterIndexKey key = mIndex.makeKey(speaker.mActorId, speaker.mRace, speaker.mClass,
+                speaker.mFaction, speaker.mPlayerCell, speaker.mIsCreature);
+            const std::vector<const ESM::DialInfo*> candidates = mIndex.getCandidates(mDialogue, key);
+            const std::vector<const ESM::DialInfo*> accepted = getAccepted(mDialogue, speaker);
+            EXPECT_TRUE(std::is_sorted(candidates.begin(), candidates.end(),
+                [] (const ESM::DialInfo* lhs, const ESM::DialInfo* rhs) { return std::stoi(lhs->mId) < std::stoi(rhs->mId); }));
+            EXPECT_TRUE(std::includes(candidates.begin(), candidates.end(), accepted.begin(), accepted.end(),
+                [] (const ESM::DialInfo* lhs, const ESM::DialInfo* rhs) { return std::stoi(lhs->mId) < std::stoi(rhs->mId); }))
+                << "speaker=" << i;
+        }
+    }
+}
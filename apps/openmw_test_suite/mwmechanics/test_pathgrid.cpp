@@ -0,0 +1,93 @@
+#include "apps/openmw/mwmechanics/pathgrid.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWMechanics;
+
+    void addEdge(ESM::Pathgrid& pathgrid, int v0, int v1)
+    {
+        pathgrid.mEdges.push_back(ESM::Pathgrid::Edge {v0, v1});
+        pathgrid.mEdges.push_back(ESM::Pathgrid::Edge {v1, v0});
+    }
+
+    ESM::Pathgrid makeChain(int size)
+    {
+        ESM::Pathgrid pathgrid;
+        for (int i = 0; i < size; ++i)
+        {
+            pathgrid.mPoints.emplace_back(i * 100, 0, 0);
+            if (i > 0)
+                addEdge(pathgrid, i - 1, i);
+        }
+        return pathgrid;
+    }
+
+    std::vector<int> getXs(const std::deque<ESM::Pathgrid::Point>& path)
+    {
+        std::vector<int> result;
+        for (const ESM::Pathgrid::Point& point : path)
+            result.push_back(point.mX);
+        return result;
+    }
+
+    TEST(MWMechanicsPathgridGraphTest, aStarSearchShouldReturnShortestPath)
+    {
+        ESM::Pathgrid pathgrid;
+        pathgrid.mPoints = {{0, 0, 0}, {100, 0, 0}, {200, 0, 0}, {100, 1000, 0}};
+        addEdge(pathgrid, 0, 1);
+        addEdge(pathgrid, 1, 2);
+        addEdge(pathgrid, 0, 3);
+        addEdge(pathgrid, 3, 2);
+        const PathgridGraph graph(&pathgrid);
+        EXPECT_THAT(getXs(graph.aStarSearch(0, 2)), ElementsAre(0, 100, 200));
+        EXPECT_THAT(getXs(graph.aStarSearch(2, 0)), ElementsAre(200, 100, 0));
+        EXPECT_THAT(getXs(graph.aStarSearch(3, 1)), ElementsAre(100, 0, 100));
+    }
+
+    TEST(MWMechanicsPathgridGraphTest, aStarSearchShouldReturnStartForSameStartAndEnd)
+    {
+        const ESM::Pathgrid pathgrid = makeChain(3);
+        const PathgridGraph graph(&pathgrid);
+        EXPECT_THAT(getXs(graph.aStarSearch(1, 1)), ElementsAre(100));
+    }
+
+    TEST(MWMechanicsPathgridGraphTest, aStarSearchShouldReturnEmptyPathForNotConnectedPoints)
+    {
+        ESM::Pathgrid pathgrid = makeChain(3);
+        pathgrid.mPoints.emplace_back(1000, 0, 0);
+        const PathgridGraph graph(&pathgrid);
+        EXPECT_FALSE(graph.isPointConnected(0, 3));
+        EXPECT_THAT(graph.aStarSearch(0, 3), IsEmpty());
+    }
+
+    TEST(MWMechanicsPathgridGraphTest, aStarSearchShouldFindPathInBigPathgrid)
+    {
+        const ESM::Pathgrid pathgrid = makeChain(300);
+        const PathgridGraph graph(&pathgrid);
+        const std::deque<ESM::Pathgrid::Point> path = graph.aStarSearch(0, 299);
+        ASSERT_EQ(path.size(), 300u);
+        EXPECT_EQ(path.front().mX, 0);
+        EXPECT_EQ(path.back().mX, 29900);
+    }
+
+    TEST(MWMechanicsPathgridGraphCacheTest, getShouldReturnSameGraphForSamePathgrid)
+    {
+        const ESM::Pathgrid pathgrid = makeChain(3);
+        PathgridGraphCache cache;
+        const auto graph = cache.get(&pathgrid);
+        EXPECT_EQ(graph->getPathgrid(), &pathgrid);
+        EXPECT_EQ(cache.get(&pathgrid), graph);
+    }
+
+    TEST(MWMechanicsPathgridGraphCacheTest, getShouldReturnEmptyGraphForNullptr)
+    {
+        PathgridGraphCache cache;
+        EXPECT_EQ(cache.get(nullptr)->getPathgrid(), nullptr);
+    }
+}
@@ -0,0 +1,74 @@
+#include "apps/openmw/mwscript/scriptcache.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include "../testing_util.hpp"
+
+namespace
+{
+    using namespace testing;
+    using namespace MWScript;
+
+    struct MWScriptScriptCacheTest : Test
+    {
+        const boost::filesystem::path mPath {TestingOpenMW::temporaryFilePath("scripts.cache")};
+        const std::vector<MWWorld::ContentFileStamp> mContentFiles {
+            MWWorld::ContentFileStamp {"Morrowind.esm", 79837557, 1024102800},
+        };
+        const std::uint64_t mCompilerHash = 42;
+        const std::vector<CachedScript> mScripts {
+            CachedScript {"CharGenBoat", getScriptSourceHash("Begin CharGenBoat\nEnd"), {0x1c000001, 0x4000000},
+                {"done"}, {}, {"timer"}},
+            CachedScript {"Main", getScriptSourceHash("Begin Main\nEnd"), {}, {}, {"state"}, {}},
+        };
+
+        MWScriptScriptCacheTest()
+        {
+            boost::filesystem::remove(mPath);
+        }
+    };
+
+    TEST_F(MWScriptScriptCacheTest, readShouldReturnNothingForMissingFile)
+    {
+        EXPECT_EQ(readScriptCache(mPath, mContentFiles, mCompilerHash), std::nullopt);
+    }
+
+    TEST_F(MWScriptScriptCacheTest, readShouldReturnWrittenScripts)
+    {
+        writeScriptCache(mPath, mContentFiles, mCompilerHash, mScripts);
+        EXPECT_THAT(readScriptCache(mPath, mContentFiles, mCompilerHash), Optional(mScripts));
+    }
+
+    TEST_F(MWScriptScriptCacheTest, readShouldReturnNothingForChangedContentFile)
+    {
+        writeScriptCache(mPath, mContentFiles, mCompilerHash, mScripts);
+        std::vector<MWWorld::ContentFileStamp> contentFiles = mContentFiles;
+        contentFiles[0].mSize += 1;
+        EXPECT_EQ(readScriptCache(mPath, contentFiles, mCompilerHash), std::nullopt);
+    }
+
+    TEST_F(MWScriptScriptCacheTest, readShouldReturnNothingForChangedCompiler)
+    {
+        writeScriptCache(mPath, mContentFiles, mCompilerHash, mScripts);
+        EXPECT_EQ(readScriptCache(mPath, mContentFiles, mCompilerHash + 1), std::nullopt);
+    }
+
+    TEST_F(MWScriptScriptCacheTest, readShouldReturnNothingForCorruptedFile)
+    {
+        {
+            boost::filesystem::ofstream stream(mPath, std::ios::binary);
+            stream << "OSCC garbage";
+        }
+        EXPECT_EQ(readScriptCache(mPath, mContentFiles, mCompilerHash), std::nullopt);
+    }
+
+    TEST(MWScriptScriptSourceHashTest, shouldDependOnScriptText)
+    {
+        EXPECT_EQ(getScriptSourceHash("Begin Main\nEnd"), getScriptSourceHash("Begin Main\nEnd"));
+        EXPECT_NE(getScriptSourceHash("Begin Main\nEnd"), getScriptSourceHash("Begin Main\nEnd\n"));
+    }
+}
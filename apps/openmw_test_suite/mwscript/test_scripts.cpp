@@ -49,6 +49,16 @@ namespace
             mInterpreter.run(&script.mByteCode[0], static_cast<int>(script.mByteCode.size()), context);
         }
 
+        Interpreter::Program prepare(const CompiledScript& script)
+        {
+            return mInterpreter.prepare(script.mByteCode.data(), static_cast<int>(script.mByteCode.size()));
+        }
+
+        void run(const Interpreter::Program& program, TestInterpreterContext& context)
+        {
+            mInterpreter.run(program, context);
+        }
+
         template<typename T, typename ...TArgs>
         void installOpcode(int code, TArgs&& ...args)
         {
@@ -848,4 +858,42 @@ messagebox,"this is a %g",a
     {
         EXPECT_FALSE(!compile(sIssue6380));
     }
+
+    TEST_F(MWScriptTest, mwscript_test_prepared_program)
+    {
+        if(const auto script = compile(sScript3))
+        {
+            const Interpreter::Program program = prepare(*script);
+            for(int i = 1; i < 10; ++i)
+            {
+                TestInterpreterContext expected;
+                expected.setLocalShort(0, i);
+                run(*script, expected);
+                TestInterpreterContext context;
+                context.setLocalShort(0, i);
+                run(program, context);
+                for(int j = 0; j < 5; ++j)
+                    EXPECT_EQ(context.getLocalShort(j), expected.getLocalShort(j)) << i << " " << j;
+            }
+        }
+        else
+        {
+            FAIL();
+        }
+    }
+
+    TEST_F(MWScriptTest, mwscript_test_unknown_opcode_should_fail_when_executed)
+    {
+        registerExtensions();
+        if(const auto script = compile(sScript2))
+        {
+            TestInterpreterContext context;
+            const Interpreter::Program program = prepare(*script);
+            EXPECT_THROW(run(program, context), std::runtime_error);
+        }
+        else
+        {
+            FAIL();
+        }
+    }
 }
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "apps/openmw/mwstate/character.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include "../testing_util.hpp"
+
+namespace
+{
+    using namespace testing;
+    using namespace MWState;
+
+    ESM::SavedGame makeProfile(const std::string& description)
+    {
+        ESM::SavedGame profile;
+        profile.mContentFiles = {"Morrowind.esm"};
+        profile.mPlayerName = "Player";
+        profile.mPlayerLevel = 13;
+        profile.mDescription = description;
+        return profile;
+    }
+
+    struct MWStateCharacterTest : Test
+    {
+        const boost::filesystem::path mPath {TestingOpenMW::temporaryFilePath("character")};
+
+        MWStateCharacterTest()
+        {
+            boost::filesystem::remove_all(mPath);
+        }
+
+        ~MWStateCharacterTest()
+        {
+            boost::filesystem::remove_all(mPath);
+        }
+
+        void writeSlotFile(const Slot& slot)
+        {
+            boost::filesystem::ofstream(slot.mPath, std::ios::binary) << slot.mProfile.mDescription;
+        }
+    };
+
+    TEST_F(MWStateCharacterTest, failedWriteOfNewSlotShouldRemoveIt)
+    {
+        Character character(mPath, "Morrowind.esm");
+        const Slot* slot = character.createSlot(makeProfile("Quicksave"));
+        character.startSlotWrite(*slot, std::nullopt);
+        character.finishSlotWrite(slot->mPath, false);
+        EXPECT_EQ(character.begin(), character.end());
+    }
+
+    TEST_F(MWStateCharacterTest, failedOverwriteShouldRestorePreviousSlot)
+    {
+        Character character(mPath, "Morrowind.esm");
+        const Slot* slot = character.createSlot(makeProfile("First"));
+        writeSlotFile(*slot);
+        const Slot previous = *slot;
+        slot = character.updateSlot(slot, makeProfile("Second"));
+        character.startSlotWrite(*slot, previous);
+        character.finishSlotWrite(previous.mPath, false);
+        ASSERT_EQ(std::distance(character.begin(), character.end()), 1);
+        EXPECT_EQ(character.begin()->mProfile.mDescription, "First");
+        EXPECT_EQ(character.begin()->mTimeStamp, previous.mTimeStamp);
+    }
+
+    TEST_F(MWStateCharacterTest, failedOverwriteShouldRestoreSlotOfLastSucceededWrite)
+    {
+        Character character(mPath, "Morrowind.esm");
+        const Slot* slot = character.createSlot(makeProfile("First"));
+        writeSlotFile(*slot);
+        const Slot first = *slot;
+        slot = character.updateSlot(slot, makeProfile("Second"));
+        character.startSlotWrite(*slot, first);
+        const Slot second = *slot;
+        slot = character.updateSlot(slot, makeProfile("Third"));
+        character.startSlotWrite(*slot, second);
+        character.finishSlotWrite(first.mPath, true);
+        EXPECT_EQ(character.begin()->mProfile.mDescription, "Third");
+        character.finishSlotWrite(first.mPath, false);
+        ASSERT_EQ(std::distance(character.begin(), character.end()), 1);
+        EXPECT_EQ(character.begin()->mProfile.mDescription, "Second");
+    }
+
+    TEST_F(MWStateCharacterTest, restoreSlotShouldKeepSlotsOrderedByTimeStamp)
+    {
+        Character character(mPath, "Morrowind.esm");
+        const Slot* slot = character.createSlot(makeProfile("First"));
+        writeSlotFile(*slot);
+        Slot previous = *slot;
+        previous.mTimeStamp -= 10;
+        character.createSlot(makeProfile("Second"));
+        character.restoreSlot(previous.mPath, previous);
+        ASSERT_EQ(std::distance(character.begin(), character.end()), 2);
+        EXPECT_EQ(character.begin()->mProfile.mDescription, "Second");
+        EXPECT_EQ(std::next(character.begin())->mProfile.mDescription, "First");
+    }
+
+    TEST_F(MWStateCharacterTest, updateIndexShouldSkipSlotsBeingWritten)
+    {
+        Character character(mPath, "Morrowind.esm");
+        const Slot* slot = character.createSlot(makeProfile("Quicksave"));
+        writeSlotFile(*slot);
+        character.startSlotWrite(*slot, std::nullopt);
+        character.updateIndex();
+        EXPECT_THAT(readSlotIndex(mPath / slotIndexFileName), IsEmpty());
+        character.finishSlotWrite(slot->mPath, true);
+        const SlotIndex index = readSlotIndex(mPath / slotIndexFileName);
+        ASSERT_EQ(index.size(), 1);
+        EXPECT_EQ(index.begin()->first, "Quicksave.omwsave");
+        EXPECT_EQ(index.begin()->second.mProfile.mDescription, "Quicksave");
+    }
+
+    TEST_F(MWStateCharacterTest, shouldKeepIndexEntriesOfOtherGames)
+    {
+        boost::filesystem::create_directories(mPath);
+        const boost::filesystem::path otherPath = mPath / "Other.omwsave";
+        boost::filesystem::ofstream(otherPath, std::ios::binary) << "Other";
+        ESM::SavedGame otherProfile = makeProfile("Other");
+        otherProfile.mContentFiles = {"Other.esm"};
+        SlotIndex index;
+        index.emplace("Other.omwsave", makeSlotIndexEntry(otherPath, otherProfile));
+        writeSlotIndex(mPath / slotIndexFileName, index);
+
+        Character character(mPath, "Morrowind.esm");
+        EXPECT_EQ(character.begin(), character.end());
+        const Slot* slot = character.createSlot(makeProfile("Quicksave"));
+        writeSlotFile(*slot);
+        character.startSlotWrite(*slot, std::nullopt);
+        character.finishSlotWrite(slot->mPath, true);
+
+        const SlotIndex result = readSlotIndex(mPath / slotIndexFileName);
+        ASSERT_EQ(result.size(), 2);
+        EXPECT_EQ(result.at("Other.omwsave").mProfile.mDescription, "Other");
+        EXPECT_EQ(result.at("Quicksave.omwsave").mProfile.mDescription, "Quicksave");
+    }
+
+    TEST_F(MWStateCharacterTest, deleteSlotShouldRemoveIndexEntry)
+    {
+        Character character(mPath, "Morrowind.esm");
+        const Slot* slot = character.createSlot(makeProfile("Quicksave"));
+        writeSlotFile(*slot);
+        character.startSlotWrite(*slot, std::nullopt);
+        character.finishSlotWrite(slot->mPath, true);
+        character.deleteSlot(&*character.begin());
+        EXPECT_THAT(readSlotIndex(mPath / slotIndexFileName), IsEmpty());
+    }
+}
@@ -0,0 +1,98 @@
+#include "apps/openmw/mwstate/savewriter.hpp"
+
+#include <components/files/compressedstream.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <iterator>
+
+#include "../testing_util.hpp"
+
+namespace
+{
+    using namespace testing;
+    using namespace MWState;
+
+    std::string readFile(const boost::filesystem::path& path)
+    {
+        boost::filesystem::ifstream stream(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    struct MWStateSaveWriterTest : Test
+    {
+        const boost::filesystem::path mPath {TestingOpenMW::temporaryFilePath("savewriter.omwsave")};
+
+        MWStateSaveWriterTest()
+        {
+            boost::filesystem::remove(mPath);
+        }
+
+        ~MWStateSaveWriterTest()
+        {
+            boost::filesystem::remove(mPath);
+        }
+    };
+
+    TEST_F(MWStateSaveWriterTest, waitShouldReturnWhenFileIsWritten)
+    {
+        SaveWriter writer;
+        writer.push(mPath, "Quicksave", "data", false, std::chrono::steady_clock::now());
+        writer.wait();
+        EXPECT_EQ(readFile(mPath), "data");
+        boost::filesystem::path temporaryPath = mPath;
+        temporaryPath += ".tmp";
+        EXPECT_FALSE(boost::filesystem::exists(temporaryPath));
+    }
+
+    TEST_F(MWStateSaveWriterTest, compressedSaveShouldBeReadableAsCompressedStream)
+    {
+        SaveWriter writer;
+        writer.push(mPath, "Quicksave", "data", true, std::chrono::steady_clock::now());
+        writer.wait();
+        auto stream = std::make_unique<boost::filesystem::ifstream>(mPath, std::ios::binary);
+        ASSERT_TRUE(Files::isCompressedStream(*stream));
+        const Files::IStreamPtr decompressed = Files::openCompressedStream(std::move(stream));
+        EXPECT_EQ(std::string(std::istreambuf_iterator<char>(*decompressed), std::istreambuf_iterator<char>()), "data");
+    }
+
+    TEST_F(MWStateSaveWriterTest, lastPushedSaveShouldReplaceFile)
+    {
+        SaveWriter writer;
+        writer.push(mPath, "Quicksave", "first", false, std::chrono::steady_clock::now());
+        writer.push(mPath, "Quicksave", "second", false, std::chrono::steady_clock::now());
+        writer.wait();
+        EXPECT_EQ(readFile(mPath), "second");
+        const std::vector<SaveWriterResult> results = writer.takeResults();
+        ASSERT_EQ(results.size(), 2u);
+        EXPECT_EQ(results[0].mError, "");
+        EXPECT_EQ(results[1].mError, "");
+        EXPECT_THAT(writer.takeResults(), IsEmpty());
+    }
+
+    TEST_F(MWStateSaveWriterTest, destructorShouldWaitForPendingSaves)
+    {
+        {
+            SaveWriter writer;
+            writer.push(mPath, "Quicksave", "data", false, std::chrono::steady_clock::now());
+        }
+        EXPECT_EQ(readFile(mPath), "data");
+    }
+
+    TEST_F(MWStateSaveWriterTest, failedSaveShouldReportError)
+    {
+        const boost::filesystem::path path = mPath / "not_existing_directory" / "save.omwsave";
+        SaveWriter writer;
+        writer.push(path, "Quicksave", "data", false, std::chrono::steady_clock::now());
+        writer.wait();
+        const std::vector<SaveWriterResult> results = writer.takeResults();
+        ASSERT_EQ(results.size(), 1u);
+        EXPECT_EQ(results[0].mPath, path);
+        EXPECT_NE(results[0].mError, "");
+        EXPECT_FALSE(boost::filesystem::exists(path));
+    }
+}
@@ -0,0 +1,124 @@
+#include "apps/openmw/mwstate/slotindex.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <chrono>
+#include <filesystem>
+
+#include "../testing_util.hpp"
+
+namespace
+{
+    using namespace testing;
+    using namespace MWState;
+
+    struct MWStateSlotIndexTest : Test
+    {
+        const boost::filesystem::path mPath {TestingOpenMW::temporaryFilePath("slotindex.index")};
+
+        MWStateSlotIndexTest()
+        {
+            boost::filesystem::remove(mPath);
+        }
+
+        ~MWStateSlotIndexTest()
+        {
+            boost::filesystem::remove(mPath);
+        }
+    };
+
+    ESM::SavedGame makeProfile()
+    {
+        ESM::SavedGame profile;
+        profile.mContentFiles = {"Morrowind.esm", "Tribunal.esm"};
+        profile.mPlayerName = "Player";
+        profile.mPlayerLevel = 13;
+        profile.mPlayerClassId = "warrior";
+        profile.mPlayerCell = "Balmora";
+        profile.mInGameTime = ESM::EpochTimeStamp {12.5f, 16, 7, 427};
+        profile.mTimePlayed = 3600;
+        profile.mDescription = "Quicksave";
+        return profile;
+    }
+
+    TEST_F(MWStateSlotIndexTest, readShouldReturnEmptyIndexForAbsentFile)
+    {
+        EXPECT_THAT(readSlotIndex(mPath), IsEmpty());
+    }
+
+    TEST_F(MWStateSlotIndexTest, readShouldReturnEmptyIndexForInvalidFile)
+    {
+        boost::filesystem::ofstream(mPath, std::ios::binary) << "invalid";
+        EXPECT_THAT(readSlotIndex(mPath), IsEmpty());
+    }
+
+    TEST_F(MWStateSlotIndexTest, readShouldReturnWrittenIndex)
+    {
+        SlotIndex index;
+        index.emplace("Quicksave.omwsave", SlotIndexEntry {42, 1654441200000000000, makeProfile()});
+        index.emplace("Autosave.omwsave", SlotIndexEntry {13, 1654441200000000001, makeProfile()});
+        writeSlotIndex(mPath, index);
+
+        const SlotIndex result = readSlotIndex(mPath);
+        ASSERT_EQ(result.size(), 2);
+        const SlotIndexEntry& entry = result.at("Quicksave.omwsave");
+        EXPECT_EQ(entry.mFileSize, 42);
+        EXPECT_EQ(entry.mModificationTime, 1654441200000000000);
+        EXPECT_EQ(entry.mProfile.mContentFiles, makeProfile().mContentFiles);
+        EXPECT_EQ(entry.mProfile.mPlayerName, "Player");
+        EXPECT_EQ(entry.mProfile.mPlayerLevel, 13);
+        EXPECT_EQ(entry.mProfile.mPlayerClassId, "warrior");
+        EXPECT_EQ(entry.mProfile.mPlayerCell, "Balmora");
+        EXPECT_EQ(entry.mProfile.mInGameTime.mDay, 16);
+        EXPECT_EQ(entry.mProfile.mTimePlayed, 3600);
+        EXPECT_EQ(entry.mProfile.mDescription, "Quicksave");
+        EXPECT_THAT(entry.mProfile.mScreenshot, IsEmpty());
+        EXPECT_EQ(result.at("Autosave.omwsave").mFileSize, 13);
+    }
+
+    TEST_F(MWStateSlotIndexTest, writeShouldReplaceExistingIndex)
+    {
+        SlotIndex index;
+        index.emplace("Quicksave.omwsave", SlotIndexEntry {42, 1654441200000000000, makeProfile()});
+        writeSlotIndex(mPath, index);
+        writeSlotIndex(mPath, SlotIndex());
+        EXPECT_THAT(readSlotIndex(mPath), IsEmpty());
+        boost::filesystem::path temporaryPath = mPath;
+        temporaryPath += ".tmp";
+        EXPECT_FALSE(boost::filesystem::exists(temporaryPath));
+    }
+
+    TEST_F(MWStateSlotIndexTest, entryShouldBeValidForUnchangedFile)
+    {
+        boost::filesystem::ofstream(mPath, std::ios::binary) << "save";
+        const SlotIndexEntry entry = makeSlotIndexEntry(mPath, makeProfile());
+        EXPECT_EQ(entry.mFileSize, 4);
+        EXPECT_TRUE(isSlotIndexEntryValid(entry, mPath));
+    }
+
+    TEST_F(MWStateSlotIndexTest, entryShouldBeInvalidForFileChangedWithinSecond)
+    {
+        boost::filesystem::ofstream(mPath, std::ios::binary) << "save";
+        const SlotIndexEntry entry = makeSlotIndexEntry(mPath, makeProfile());
+        const std::filesystem::path path(mPath.native());
+        std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::milliseconds(1));
+        EXPECT_FALSE(isSlotIndexEntryValid(entry, mPath));
+    }
+
+    TEST_F(MWStateSlotIndexTest, entryShouldBeInvalidForAbsentFile)
+    {
+        EXPECT_FALSE(isSlotIndexEntryValid(SlotIndexEntry {0, 0, makeProfile()}, mPath));
+    }
+
+    TEST_F(MWStateSlotIndexTest, makeEntryShouldDropScreenshot)
+    {
+        boost::filesystem::ofstream(mPath, std::ios::binary) << "save";
+        ESM::SavedGame profile = makeProfile();
+        profile.mScreenshot = {'a', 'b'};
+        EXPECT_THAT(makeSlotIndexEntry(mPath, profile).mProfile.mScreenshot, IsEmpty());
+    }
+}
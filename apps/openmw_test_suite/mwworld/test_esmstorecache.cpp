@@ -0,0 +1,146 @@
+#include "apps/openmw/mwworld/esmstorecache.hpp"
+#include "apps/openmw/mwworld/esmstore.hpp"
+
+#include <components/esm3/esmreader.hpp>
+#include <components/esm3/esmwriter.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <sstream>
+
+#include "../testing_util.hpp"
+
+namespace
+{
+    using namespace testing;
+    using namespace MWWorld;
+
+    ESM::Apparatus makeApparatus(const std::string& id, const std::string& name)
+    {
+        ESM::Apparatus record;
+        record.blank();
+        record.mId = id;
+        record.mName = name;
+        return record;
+    }
+
+    std::unique_ptr<std::istream> makeContentFile(const std::vector<ESM::Apparatus>& records,
+        ToUTF8::Utf8Encoder& encoder)
+    {
+        auto stream = std::make_unique<std::stringstream>();
+        ESM::ESMWriter writer;
+        writer.setEncoder(&encoder);
+        writer.setFormat(0);
+        writer.save(*stream);
+        for (const ESM::Apparatus& record : records)
+        {
+            writer.startRecord(ESM::Apparatus::sRecordId);
+            record.save(writer);
+            writer.endRecord(ESM::Apparatus::sRecordId);
+        }
+        return stream;
+    }
+
+    std::vector<std::string> getNames(const Store<ESM::Apparatus>& store)
+    {
+        std::vector<std::string> result;
+        for (const ESM::Apparatus& record : store)
+            result.push_back(record.mName);
+        return result;
+    }
+
+    struct MWWorldEsmStoreCacheTest : Test
+    {
+        const boost::filesystem::path mPath {TestingOpenMW::temporaryFilePath("esmstore.cache")};
+        const std::vector<ContentFileStamp> mContentFiles {
+            ContentFileStamp {"Morrowind.esm", 79837557, 1024102800123456789},
+            ContentFileStamp {"Tribunal.esm", 4565686, 1035940926987654321},
+        };
+        ToUTF8::Utf8Encoder mEncoder {ToUTF8::WINDOWS_1252};
+        // Not ASCII to check the records are converted back to the content files encoding
+        const std::vector<ESM::Apparatus> mRecords {
+            makeApparatus("mortar", "Mortar and Pestle"),
+            makeApparatus("alembic", "Caf\xC3\xA9 Alembic"),
+        };
+        ESMStore mStore;
+
+        MWWorldEsmStoreCacheTest()
+        {
+            boost::filesystem::remove(mPath);
+        }
+
+        void load(ESMStore& store, const std::vector<ESM::Apparatus>& records)
+        {
+            ESM::ESMReader reader;
+            reader.setEncoder(&mEncoder);
+            reader.open(makeContentFile(records, mEncoder), "content");
+            ESM::Dialogue* dialogue = nullptr;
+            store.load(reader, nullptr, dialogue);
+            store.setUp();
+        }
+    };
+
+    TEST_F(MWWorldEsmStoreCacheTest, readShouldReturnFalseForMissingFile)
+    {
+        ESMStore store;
+        EXPECT_FALSE(readEsmStoreCache(mPath, mContentFiles, mEncoder, store));
+    }
+
+    TEST_F(MWWorldEsmStoreCacheTest, readShouldLoadWrittenRecordsInOriginalOrder)
+    {
+        load(mStore, mRecords);
+        writeEsmStoreCache(mPath, mContentFiles, mEncoder, mStore);
+
+        ESMStore store;
+        ASSERT_TRUE(readEsmStoreCache(mPath, mContentFiles, mEncoder, store));
+        store.setUp();
+        EXPECT_THAT(getNames(store.get<ESM::Apparatus>()), ElementsAre("Mortar and Pestle", "Caf\xC3\xA9 Alembic"));
+        EXPECT_EQ(store.find("alembic"), ESM::REC_APPA);
+    }
+
+    TEST_F(MWWorldEsmStoreCacheTest, readShouldReturnFalseForChangedContentFile)
+    {
+        load(mStore, mRecords);
+        writeEsmStoreCache(mPath, mContentFiles, mEncoder, mStore);
+        std::vector<ContentFileStamp> contentFiles = mContentFiles;
+        contentFiles[1].mSize += 1;
+        ESMStore store;
+        EXPECT_FALSE(readEsmStoreCache(mPath, contentFiles, mEncoder, store));
+        EXPECT_EQ(store.get<ESM::Apparatus>().getSize(), 0);
+    }
+
+    TEST_F(MWWorldEsmStoreCacheTest, readShouldReturnFalseForChangedEncoding)
+    {
+        load(mStore, mRecords);
+        writeEsmStoreCache(mPath, mContentFiles, mEncoder, mStore);
+        ToUTF8::Utf8Encoder encoder(ToUTF8::WINDOWS_1251);
+        ESMStore store;
+        EXPECT_FALSE(readEsmStoreCache(mPath, mContentFiles, encoder, store));
+    }
+
+    TEST_F(MWWorldEsmStoreCacheTest, readShouldReturnFalseForCorruptedFile)
+    {
+        {
+            boost::filesystem::ofstream stream(mPath, std::ios::binary);
+            stream << "TES3 garbage";
+        }
+        ESMStore store;
+        EXPECT_FALSE(readEsmStoreCache(mPath, mContentFiles, mEncoder, store));
+    }
+
+    TEST_F(MWWorldEsmStoreCacheTest, loadShouldSkipCachedRecordsOfContentFiles)
+    {
+        load(mStore, mRecords);
+        writeEsmStoreCache(mPath, mContentFiles, mEncoder, mStore);
+
+        ESMStore store;
+        ASSERT_TRUE(readEsmStoreCache(mPath, mContentFiles, mEncoder, store));
+        load(store, {makeApparatus("mortar", "Changed")});
+        EXPECT_THAT(getNames(store.get<ESM::Apparatus>()), ElementsAre("Mortar and Pestle", "Caf\xC3\xA9 Alembic"));
+    }
+}
@@ -0,0 +1,88 @@
+#include "apps/openmw/mwworld/refcountcache.hpp"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <chrono>
+#include <filesystem>
+
+#include "../testing_util.hpp"
+
+namespace
+{
+    using namespace testing;
+    using namespace MWWorld;
+
+    struct MWWorldRefCountCacheTest : Test
+    {
+        const boost::filesystem::path mPath {TestingOpenMW::temporaryFilePath("refcounts.cache")};
+        const std::vector<ContentFileStamp> mContentFiles {
+            ContentFileStamp {"Morrowind.esm", 79837557, 1024102800123456789},
+            ContentFileStamp {"Tribunal.esm", 4565686, 1035940926987654321},
+        };
+        const ToUTF8::FromType mEncoding = ToUTF8::WINDOWS_1252;
+        const RefCounts mRefCounts {{"chargen boat", 1}, {"ex_common_door_01", 42}};
+
+        MWWorldRefCountCacheTest()
+        {
+            boost::filesystem::remove(mPath);
+        }
+    };
+
+    TEST_F(MWWorldRefCountCacheTest, readShouldReturnNothingForMissingFile)
+    {
+        EXPECT_EQ(readRefCountCache(mPath, mContentFiles, mEncoding), std::nullopt);
+    }
+
+    TEST_F(MWWorldRefCountCacheTest, readShouldReturnWrittenRefCounts)
+    {
+        writeRefCountCache(mPath, mContentFiles, mEncoding, mRefCounts);
+        EXPECT_THAT(readRefCountCache(mPath, mContentFiles, mEncoding), Optional(mRefCounts));
+    }
+
+    TEST_F(MWWorldRefCountCacheTest, readShouldReturnNothingForChangedContentFile)
+    {
+        writeRefCountCache(mPath, mContentFiles, mEncoding, mRefCounts);
+        std::vector<ContentFileStamp> contentFiles = mContentFiles;
+        contentFiles[1].mModificationTime += 1;
+        EXPECT_EQ(readRefCountCache(mPath, contentFiles, mEncoding), std::nullopt);
+    }
+
+    TEST_F(MWWorldRefCountCacheTest, readShouldReturnNothingForChangedEncoding)
+    {
+        writeRefCountCache(mPath, mContentFiles, mEncoding, mRefCounts);
+        EXPECT_EQ(readRefCountCache(mPath, mContentFiles, ToUTF8::WINDOWS_1251), std::nullopt);
+    }
+
+    TEST_F(MWWorldRefCountCacheTest, makeContentFileStampShouldNoticeChangeWithinSecond)
+    {
+        {
+            boost::filesystem::ofstream stream(mPath, std::ios::binary);
+            stream << "a";
+        }
+        const ContentFileStamp before = makeContentFileStamp(mPath);
+        const auto modificationTime = std::filesystem::last_write_time(std::filesystem::path(mPath.native()));
+        std::filesystem::last_write_time(std::filesystem::path(mPath.native()),
+            modificationTime + std::chrono::milliseconds(1));
+        EXPECT_NE(makeContentFileStamp(mPath), before);
+    }
+
+    TEST_F(MWWorldRefCountCacheTest, readShouldReturnNothingForChangedLoadOrder)
+    {
+        writeRefCountCache(mPath, mContentFiles, mEncoding, mRefCounts);
+        const std::vector<ContentFileStamp> contentFiles {mContentFiles[1], mContentFiles[0]};
+        EXPECT_EQ(readRefCountCache(mPath, contentFiles, mEncoding), std::nullopt);
+    }
+
+    TEST_F(MWWorldRefCountCacheTest, readShouldReturnNothingForCorruptedFile)
+    {
+        {
+            boost::filesystem::ofstream stream(mPath, std::ios::binary);
+            stream << "ORCC garbage";
+        }
+        EXPECT_EQ(readRefCountCache(mPath, mContentFiles, mEncoding), std::nullopt);
+    }
+}
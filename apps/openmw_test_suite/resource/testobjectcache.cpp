@@ -0,0 +1,216 @@
+#include <components/resource/objectcache.hpp>
+
+#include <osg/Image>
+#include <osg/Object>
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+    using namespace testing;
+    using namespace Resource;
+
+    struct Object : osg::Object
+    {
+        Object() = default;
+
+        Object(const Object& other, const osg::CopyOp& copyOp)
+            : osg::Object(other, copyOp)
+        {
+        }
+
+        META_Object(ResourceTest, Object)
+    };
+
+    osg::ref_ptr<osg::Image> makeImage(int size)
+    {
+        osg::ref_ptr<osg::Image> image = new osg::Image;
+        image->allocateImage(size, size, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+        return image;
+    }
+
+    struct ResourceObjectCacheTest : Test
+    {
+        osg::ref_ptr<ObjectCache> mCache = new ObjectCache;
+    };
+
+    TEST_F(ResourceObjectCacheTest, getOrLoad_should_add_loaded_object_to_cache)
+    {
+        const osg::ref_ptr<osg::Object> object = new Object;
+        EXPECT_EQ(mCache->getOrLoad("key", [&] { return object; }), object);
+        EXPECT_EQ(mCache->getRefFromObjectCache("key"), object);
+    }
+
+    TEST_F(ResourceObjectCacheTest, getOrLoad_should_not_load_cached_object)
+    {
+        const osg::ref_ptr<osg::Object> object = new Object;
+        mCache->addEntryToObjectCache("key", object);
+        EXPECT_EQ(mCache->getOrLoad("key", [] () -> osg::ref_ptr<osg::Object> { throw std::logic_error("load"); }), object);
+    }
+
+    TEST_F(ResourceObjectCacheTest, getOrLoad_should_not_add_null_to_cache)
+    {
+        EXPECT_EQ(mCache->getOrLoad("key", [] { return osg::ref_ptr<osg::Object>(); }), nullptr);
+        EXPECT_EQ(mCache->getCacheSize(), 0u);
+    }
+
+    TEST_F(ResourceObjectCacheTest, getOrLoad_should_rethrow_exception_and_allow_to_load_again)
+    {
+        EXPECT_THROW(mCache->getOrLoad("key", [] () -> osg::ref_ptr<osg::Object> { throw std::runtime_error("load"); }),
+            std::runtime_error);
+        EXPECT_EQ(mCache->getCacheSize(), 0u);
+        const osg::ref_ptr<osg::Object> object = new Object;
+        EXPECT_EQ(mCache->getOrLoad("key", [&] { return object; }), object);
+    }
+
+    TEST_F(ResourceObjectCacheTest, getOrLoad_should_wait_for_concurrent_load_of_the_same_key)
+    {
+        const osg::ref_ptr<osg::Object> object = new Object;
+        std::promise<void> loadStarted;
+        std::promise<void> finishLoad;
+        std::thread loader([&]
+        {
+            mCache->getOrLoad("key", [&]
+            {
+                loadStarted.set_value();
+                finishLoad.get_future().wait();
+                return object;
+            });
+        });
+        loadStarted.get_future().wait();
+        std::future<osg::ref_ptr<osg::Object>> waiting = std::async(std::launch::async, [&]
+        {
+            return mCache->getOrLoad("key", [] () -> osg::ref_ptr<osg::Object> { throw std::logic_error("load"); });
+        });
+        while (mCache->getNumDeduplicatedLoads() == 0)
+            std::this_thread::yield();
+        finishLoad.set_value();
+        loader.join();
+        EXPECT_EQ(waiting.get(), object);
+        EXPECT_EQ(mCache->getNumDeduplicatedLoads(), 1u);
+    }
+
+    TEST_F(ResourceObjectCacheTest, getOrLoad_should_rethrow_exception_of_concurrent_load_of_the_same_key)
+    {
+        std::promise<void> loadStarted;
+        std::promise<void> finishLoad;
+        std::thread loader([&]
+        {
+            EXPECT_THROW(mCache->getOrLoad("key", [&] () -> osg::ref_ptr<osg::Object>
+            {
+                loadStarted.set_value();
+                finishLoad.get_future().wait();
+                throw std::runtime_error("load");
+            }), std::runtime_error);
+        });
+        loadStarted.get_future().wait();
+        std::future<osg::ref_ptr<osg::Object>> waiting = std::async(std::launch::async, [&]
+        {
+            return mCache->getOrLoad("key", [] () -> osg::ref_ptr<osg::Object> { throw std::logic_error("load"); });
+        });
+        while (mCache->getNumDeduplicatedLoads() == 0)
+            std::this_thread::yield();
+        finishLoad.set_value();
+        loader.join();
+        EXPECT_THROW(waiting.get(), std::runtime_error);
+    }
+
+    TEST_F(ResourceObjectCacheTest, should_not_estimate_size_without_max_size)
+    {
+        mCache->addEntryToObjectCache("a", makeImage(16));
+        EXPECT_EQ(mCache->getTotalSize(), 0u);
+    }
+
+    TEST_F(ResourceObjectCacheTest, setMaxSize_should_estimate_size_of_objects_added_without_max_size)
+    {
+        mCache->addEntryToObjectCache("a", makeImage(16));
+        mCache->addEntryToObjectCache("b", makeImage(16));
+        mCache->setMaxSize(1024);
+        EXPECT_EQ(mCache->getCacheSize(), 1u);
+        EXPECT_EQ(mCache->getTotalSize(), 1024u);
+    }
+
+    TEST_F(ResourceObjectCacheTest, should_account_estimated_size_of_images)
+    {
+        mCache->setMaxSize(1024 * 1024);
+        mCache->addEntryToObjectCache("a", makeImage(16));
+        mCache->addEntryToObjectCache("b", makeImage(8));
+        EXPECT_EQ(mCache->getTotalSize(), 16u * 16 * 4 + 8 * 8 * 4);
+        mCache->removeFromObjectCache("a");
+        EXPECT_EQ(mCache->getTotalSize(), 8u * 8 * 4);
+        mCache->clear();
+        EXPECT_EQ(mCache->getTotalSize(), 0u);
+    }
+
+    TEST_F(ResourceObjectCacheTest, should_evict_least_recently_used_unreferenced_objects_over_max_size)
+    {
+        mCache->setMaxSize(3 * 1024);
+        mCache->addEntryToObjectCache("a", makeImage(16));
+        mCache->addEntryToObjectCache("b", makeImage(16));
+        mCache->addEntryToObjectCache("c", makeImage(16));
+        EXPECT_NE(mCache->getRefFromObjectCache("a"), nullptr);
+        mCache->addEntryToObjectCache("d", makeImage(16));
+        EXPECT_EQ(mCache->getRefFromObjectCache("b"), nullptr);
+        EXPECT_NE(mCache->getRefFromObjectCache("a"), nullptr);
+        EXPECT_NE(mCache->getRefFromObjectCache("c"), nullptr);
+        EXPECT_NE(mCache->getRefFromObjectCache("d"), nullptr);
+        EXPECT_EQ(mCache->getTotalSize(), 3u * 1024);
+    }
+
+    TEST_F(ResourceObjectCacheTest, should_not_evict_objects_with_external_references)
+    {
+        mCache->setMaxSize(1024);
+        const osg::ref_ptr<osg::Image> a = makeImage(16);
+        const osg::ref_ptr<osg::Image> b = makeImage(16);
+        mCache->addEntryToObjectCache("a", a);
+        mCache->addEntryToObjectCache("b", b);
+        EXPECT_EQ(mCache->getCacheSize(), 2u);
+        EXPECT_EQ(mCache->getTotalSize(), 2u * 1024);
+    }
+
+    TEST_F(ResourceObjectCacheTest, removeLeastRecentlyUsedObjectsInCache_should_evict_objects_no_longer_referenced)
+    {
+        mCache->setMaxSize(1024);
+        osg::ref_ptr<osg::Image> a = makeImage(16);
+        mCache->addEntryToObjectCache("a", a);
+        mCache->addEntryToObjectCache("b", makeImage(16));
+        EXPECT_EQ(mCache->getCacheSize(), 2u);
+        a = nullptr;
+        mCache->removeLeastRecentlyUsedObjectsInCache();
+        EXPECT_EQ(mCache->getRefFromObjectCache("a"), nullptr);
+        EXPECT_NE(mCache->getRefFromObjectCache("b"), nullptr);
+    }
+
+    TEST_F(ResourceObjectCacheTest, adding_object_with_cached_key_should_replace_it_and_mark_as_used)
+    {
+        mCache->setMaxSize(2 * 1024);
+        mCache->addEntryToObjectCache("a", makeImage(16));
+        mCache->addEntryToObjectCache("b", makeImage(16));
+        mCache->addEntryToObjectCache("a", makeImage(8));
+        EXPECT_EQ(mCache->getTotalSize(), 1024u + 8 * 8 * 4);
+        mCache->addEntryToObjectCache("c", makeImage(16));
+        EXPECT_EQ(mCache->getRefFromObjectCache("b"), nullptr);
+        EXPECT_NE(mCache->getRefFromObjectCache("a"), nullptr);
+        EXPECT_NE(mCache->getRefFromObjectCache("c"), nullptr);
+    }
+
+    TEST_F(ResourceObjectCacheTest, adding_objects_should_not_evict_after_failed_eviction_until_next_update)
+    {
+        mCache->setMaxSize(1024);
+        osg::ref_ptr<osg::Image> a = makeImage(16);
+        mCache->addEntryToObjectCache("a", a);
+        const osg::ref_ptr<osg::Image> b = makeImage(16);
+        mCache->addEntryToObjectCache("b", b);
+        a = nullptr;
+        mCache->addEntryToObjectCache("c", makeImage(16));
+        EXPECT_EQ(mCache->getCacheSize(), 3u);
+        mCache->removeLeastRecentlyUsedObjectsInCache();
+        EXPECT_EQ(mCache->getRefFromObjectCache("a"), nullptr);
+        EXPECT_NE(mCache->getRefFromObjectCache("b"), nullptr);
+        EXPECT_EQ(mCache->getRefFromObjectCache("c"), nullptr);
+    }
+}
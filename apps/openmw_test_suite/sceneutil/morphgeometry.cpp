@@ -0,0 +1,155 @@
+#include <components/sceneutil/morphgeometry.hpp>
+
+#include <osg/NodeVisitor>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    osg::ref_ptr<osg::Vec3Array> makeOffsets(std::size_t size, const std::vector<unsigned int>& moved)
+    {
+        osg::ref_ptr<osg::Vec3Array> result(new osg::Vec3Array(size));
+        for (unsigned int vertex : moved)
+            (*result)[vertex] = osg::Vec3f(static_cast<float>(vertex), 1, 2);
+        return result;
+    }
+
+    TEST(SceneUtilSparseOffsetsTest, shouldHaveNoSpansForZeroOffsets)
+    {
+        const SparseOffsets offsets(*makeOffsets(5, {}));
+        EXPECT_EQ(offsets.getVerticesCount(), 5);
+        EXPECT_THAT(offsets.getSpans(), IsEmpty());
+        EXPECT_THAT(offsets.getValues(), IsEmpty());
+    }
+
+    TEST(SceneUtilSparseOffsetsTest, shouldKeepSmallGapsInsideSpan)
+    {
+        const SparseOffsets offsets(*makeOffsets(14, {1, 2, 5, 9, 13}));
+        ASSERT_EQ(offsets.getSpans().size(), 3);
+        EXPECT_EQ(offsets.getSpans()[0].mFirstVertex, 1);
+        EXPECT_EQ(offsets.getSpans()[0].mVerticesCount, 5);
+        EXPECT_EQ(offsets.getSpans()[0].mOffset, 0);
+        EXPECT_EQ(offsets.getSpans()[1].mFirstVertex, 9);
+        EXPECT_EQ(offsets.getSpans()[1].mVerticesCount, 1);
+        EXPECT_EQ(offsets.getSpans()[1].mOffset, 5);
+        EXPECT_EQ(offsets.getSpans()[2].mFirstVertex, 13);
+        EXPECT_EQ(offsets.getSpans()[2].mVerticesCount, 1);
+        EXPECT_EQ(offsets.getSpans()[2].mOffset, 6);
+    }
+
+    TEST(SceneUtilSparseOffsetsTest, valuesShouldMatchDenseOffsets)
+    {
+        const osg::ref_ptr<osg::Vec3Array> dense = makeOffsets(10, {0, 3, 4, 9});
+        const SparseOffsets offsets(*dense);
+        std::vector<osg::Vec3f> restored(dense->size());
+        for (const SparseOffsets::Span& span : offsets.getSpans())
+            for (unsigned int i = 0; i < span.mVerticesCount; ++i)
+                restored[span.mFirstVertex + i] = offsets.getValues()[span.mOffset + i];
+        EXPECT_EQ(restored, std::vector<osg::Vec3f>(dense->begin(), dense->end()));
+    }
+
+    struct CaptureVerticesVisitor : osg::NodeVisitor
+    {
+        std::vector<osg::Vec3f> mVertices;
+
+        explicit CaptureVerticesVisitor(unsigned int frame)
+            : osg::NodeVisitor(CULL_VISITOR, TRAVERSE_NONE)
+        {
+            setTraversalNumber(frame);
+        }
+
+        using osg::NodeVisitor::apply;
+
+        void apply(osg::Geometry& geometry) override
+        {
+            const osg::Vec3Array& vertices = static_cast<const osg::Vec3Array&>(*geometry.getVertexArray());
+            mVertices.assign(vertices.begin(), vertices.end());
+        }
+    };
+
+    struct SceneUtilMorphGeometryTest : Test
+    {
+        static constexpr std::size_t sVerticesCount = 12;
+
+        osg::ref_ptr<osg::Vec3Array> mBase = new osg::Vec3Array(sVerticesCount);
+        std::array<osg::ref_ptr<osg::Vec3Array>, 2> mTargets {
+            makeOffsets(sVerticesCount, {1, 2, 5, 9}),
+            makeOffsets(sVerticesCount, {2, 3, 10}),
+        };
+        osg::ref_ptr<MorphGeometry> mGeometry = new MorphGeometry;
+
+        SceneUtilMorphGeometryTest()
+        {
+            for (std::size_t i = 0; i < sVerticesCount; ++i)
+                (*mBase)[i] = osg::Vec3f(static_cast<float>(i), -static_cast<float>(i), 10);
+            for (osg::Vec3f& offset : *mTargets[1])
+                offset *= -0.5f;
+            osg::ref_ptr<osg::Geometry> source(new osg::Geometry);
+            source->setVertexArray(new osg::Vec3Array(*mBase));
+            mGeometry->setSourceGeometry(source);
+            mGeometry->addMorphTarget(mBase);
+            for (const osg::ref_ptr<osg::Vec3Array>& target : mTargets)
+                mGeometry->addMorphTarget(target, 0);
+        }
+
+        std::vector<osg::Vec3f> blendDense(const std::array<float, 2>& weights) const
+        {
+            std::vector<osg::Vec3f> result(mBase->begin(), mBase->end());
+            for (std::size_t i = 0; i < mTargets.size(); ++i)
+                for (std::size_t vertex = 0; vertex < sVerticesCount; ++vertex)
+                    result[vertex] += (*mTargets[i])[vertex] * weights[i];
+            return result;
+        }
+
+        std::vector<osg::Vec3f> cull(unsigned int frame, const std::array<float, 2>& weights)
+        {
+            for (std::size_t i = 0; i < weights.size(); ++i)
+                mGeometry->getMorphTarget(static_cast<unsigned int>(i + 1)).setWeight(weights[i]);
+            mGeometry->dirty();
+            CaptureVerticesVisitor visitor(frame);
+            mGeometry->accept(visitor);
+            return visitor.mVertices;
+        }
+    };
+
+    void expectNear(const std::vector<osg::Vec3f>& actual, const std::vector<osg::Vec3f>& expected)
+    {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (std::size_t i = 0; i < actual.size(); ++i)
+            for (int j = 0; j < 3; ++j)
+                EXPECT_NEAR(actual[i][j], expected[i][j], 1e-5f) << "vertex=" << i << " component=" << j;
+    }
+
+    TEST_F(SceneUtilMorphGeometryTest, cullShouldMatchDenseBlendWhenWeightsChangeAcrossFrames)
+    {
+        const std::array<float, 2> a {0.5f, 0.25f};
+        const std::array<float, 2> b {0, 1};
+        const std::array<float, 2> zero {0, 0};
+        // Each internal geometry is restored from the weights it was blended with two frames ago
+        const std::vector<std::array<float, 2>> frames {a, b, a, zero, b, a, a};
+        for (std::size_t i = 0; i < frames.size(); ++i)
+        {
+            SCOPED_TRACE("frame=" + std::to_string(i + 1));
+            expectNear(cull(static_cast<unsigned int>(i + 1), frames[i]), blendDense(frames[i]));
+        }
+    }
+
+    TEST_F(SceneUtilMorphGeometryTest, cullShouldKeepLastBlendWhenWeightsAreNotChanged)
+    {
+        const std::array<float, 2> a {0.5f, 0.25f};
+        const std::array<float, 2> zero {0, 0};
+        expectNear(cull(1, a), blendDense(a));
+        expectNear(cull(2, a), blendDense(a));
+        expectNear(cull(3, zero), blendDense(zero));
+        expectNear(cull(4, zero), blendDense(zero));
+        expectNear(cull(5, a), blendDense(a));
+    }
+}
@@ -0,0 +1,111 @@
+#include <components/sceneutil/skinning.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <numeric>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    // Rotation around z by 90 degrees, scale by 2 and translation by (10, 20, 30) in osg::Matrixf layout
+    constexpr float sMatrix[16] = {
+        0, 2, 0, 0,
+        -2, 0, 0, 0,
+        0, 0, 2, 0,
+        10, 20, 30, 1,
+    };
+
+    SoAVec3Array makeVectors(std::size_t count)
+    {
+        SoAVec3Array result;
+        for (std::size_t i = 0; i < count; ++i)
+            result.push_back(static_cast<float>(i), static_cast<float>(i) * 0.5f - 3, 1 - static_cast<float>(i) * 0.25f);
+        return result;
+    }
+
+    TEST(SceneUtilSkinningTest, transformPointsShouldApplyMatrixAsOsgPreMult)
+    {
+        SoAVec3Array src;
+        src.push_back(1, 2, 3);
+        const unsigned short indices[] = {0};
+        float dst[3] = {};
+        transformPoints(sMatrix, src, 0, 1, indices, dst, 3);
+        EXPECT_THAT(dst, ElementsAre(10 - 4, 20 + 2, 30 + 6));
+    }
+
+    TEST(SceneUtilSkinningTest, transformVectorsShouldIgnoreTranslation)
+    {
+        SoAVec3Array src;
+        src.push_back(1, 2, 3);
+        const unsigned short indices[] = {0};
+        float dst[3] = {};
+        transformVectors(sMatrix, src, 0, 1, indices, dst, 3);
+        EXPECT_THAT(dst, ElementsAre(-4, 2, 6));
+    }
+
+    TEST(SceneUtilSkinningTest, shouldWriteOnlyXyzOfVertexWithStride)
+    {
+        SoAVec3Array src;
+        src.push_back(1, 2, 3);
+        const unsigned short indices[] = {1};
+        std::vector<float> dst(8, 42);
+        transformVectors(sMatrix, src, 0, 1, indices, dst.data(), 4);
+        EXPECT_THAT(dst, ElementsAre(42, 42, 42, 42, -4, 2, 6, 42));
+    }
+
+    TEST(SceneUtilSkinningTest, addScaledShouldAddScaledSourceToDestination)
+    {
+        const std::vector<float> src {1, 2, 3, 4, 5};
+        std::vector<float> dst {10, 20, 30, 40, 50};
+        addScaled(src.data(), 0.5f, src.size(), dst.data());
+        EXPECT_THAT(dst, ElementsAre(10.5f, 21, 31.5f, 42, 52.5f));
+    }
+
+    TEST(SceneUtilSkinningTest, addScaledShouldNotWriteOutsideOfCount)
+    {
+        const std::vector<float> src(6, 1);
+        std::vector<float> dst(6, 0);
+        addScaled(src.data(), 2, 5, dst.data());
+        EXPECT_THAT(dst, ElementsAre(2, 2, 2, 2, 2, 0));
+    }
+
+    struct SceneUtilSkinningCountTest : TestWithParam<std::size_t> {};
+
+    TEST_P(SceneUtilSkinningCountTest, simdAndScalarShouldGiveSameResult)
+    {
+        const std::size_t count = GetParam();
+        const std::size_t offset = 3;
+        const SoAVec3Array src = makeVectors(count + offset);
+        std::vector<unsigned short> indices(count);
+        std::iota(indices.rbegin(), indices.rend(), static_cast<unsigned short>(0));
+        for (std::size_t stride : {3, 4})
+        {
+            std::vector<float> expected(count * stride, -1);
+            std::vector<float> result(count * stride, -1);
+            transformPointsScalar(sMatrix, src, offset, count, indices.data(), expected.data(), stride);
+            transformPoints(sMatrix, src, offset, count, indices.data(), result.data(), stride);
+            EXPECT_EQ(result, expected) << stride;
+            transformVectorsScalar(sMatrix, src, offset, count, indices.data(), expected.data(), stride);
+            transformVectors(sMatrix, src, offset, count, indices.data(), result.data(), stride);
+            EXPECT_EQ(result, expected) << stride;
+        }
+    }
+
+    TEST_P(SceneUtilSkinningCountTest, simdAndScalarAddScaledShouldGiveSameResult)
+    {
+        const std::size_t count = GetParam();
+        std::vector<float> src(count);
+        std::iota(src.begin(), src.end(), 0.25f);
+        std::vector<float> expected(count, 3);
+        std::vector<float> result(count, 3);
+        addScaledScalar(src.data(), 0.3f, count, expected.data());
+        addScaled(src.data(), 0.3f, count, result.data());
+        EXPECT_EQ(result, expected);
+    }
+
+    INSTANTIATE_TEST_SUITE_P(Counts, SceneUtilSkinningCountTest, Values(0, 1, 3, 4, 5, 8, 11));
+}
@@ -0,0 +1,46 @@
+#include <components/settings/settings.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <thread>
+
+namespace
+{
+    using namespace testing;
+    using namespace Settings;
+
+    struct SettingsManagerTest : Test
+    {
+        ~SettingsManagerTest()
+        {
+            Manager::clear();
+        }
+    };
+
+    TEST_F(SettingsManagerTest, getThreadsCountShouldReturnZeroForNegativeValue)
+    {
+        Manager::mDefaultSettings[{"Test", "threads"}] = "-1";
+        EXPECT_EQ(Manager::getThreadsCount("threads", "Test"), 0);
+    }
+
+    TEST_F(SettingsManagerTest, getThreadsCountShouldReturnPositiveValue)
+    {
+        Manager::mDefaultSettings[{"Test", "threads"}] = "3";
+        EXPECT_EQ(Manager::getThreadsCount("threads", "Test"), 3);
+    }
+
+    TEST_F(SettingsManagerTest, getThreadsCountShouldReturnNumberOfCoresMinusOneForZero)
+    {
+        Manager::mDefaultSettings[{"Test", "threads"}] = "0";
+        EXPECT_EQ(Manager::getThreadsCount("threads", "Test"),
+                  std::max<std::size_t>(1, std::thread::hardware_concurrency()) - 1);
+    }
+
+    TEST_F(SettingsManagerTest, getThreadsCountShouldPreferUserValue)
+    {
+        Manager::mDefaultSettings[{"Test", "threads"}] = "-1";
+        Manager::mUserSettings[{"Test", "threads"}] = "2";
+        EXPECT_EQ(Manager::getThreadsCount("threads", "Test"), 2);
+    }
+}
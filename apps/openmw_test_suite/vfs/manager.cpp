@@ -0,0 +1,105 @@
+#include <components/vfs/manager.hpp>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "../testing_util.hpp"
+
+namespace
+{
+    using namespace testing;
+    using namespace TestingOpenMW;
+
+    struct VFSManagerTest : Test
+    {
+        VFSTestFile mFile1 {"content1"};
+        VFSTestFile mFile2 {"content2"};
+        VFSTestFile mFile3 {"content3"};
+        VFS::Manager mManager {false};
+
+        VFSManagerTest()
+        {
+            mManager.addArchive(std::make_unique<VFSTestData>(std::map<std::string, VFS::File*> {
+                {"meshes/a.nif", &mFile1},
+                {"meshes/b/c.nif", &mFile2},
+                {"textures/a.dds", &mFile3},
+            }));
+            mManager.buildIndex();
+        }
+
+        static std::string read(Files::IStreamPtr&& stream)
+        {
+            return std::string(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
+        }
+    };
+
+    TEST_F(VFSManagerTest, existsShouldFindNormalizedPath)
+    {
+        EXPECT_TRUE(mManager.exists("meshes/a.nif"));
+    }
+
+    TEST_F(VFSManagerTest, existsShouldNormalizeCaseAndSlashes)
+    {
+        EXPECT_TRUE(mManager.exists("Meshes\\B\\C.NIF"));
+    }
+
+    TEST_F(VFSManagerTest, existsShouldReturnFalseForMissingPath)
+    {
+        EXPECT_FALSE(mManager.exists("meshes/c.nif"));
+        EXPECT_FALSE(mManager.exists("meshes"));
+        EXPECT_FALSE(mManager.exists(""));
+    }
+
+    TEST_F(VFSManagerTest, getShouldOpenFile)
+    {
+        EXPECT_EQ(read(mManager.get("Textures\\A.dds")), "content3");
+    }
+
+    TEST_F(VFSManagerTest, getNormalizedShouldOpenFile)
+    {
+        EXPECT_EQ(read(mManager.getNormalized("meshes/b/c.nif")), "content2");
+    }
+
+    TEST_F(VFSManagerTest, getShouldThrowForMissingPath)
+    {
+        EXPECT_ERROR(mManager.get("Meshes/D.nif"), "Resource 'meshes/d.nif' not found");
+    }
+
+    TEST_F(VFSManagerTest, getRecursiveDirectoryIteratorShouldReturnSortedFilesWithPrefix)
+    {
+        std::vector<std::string> files;
+        for (const std::string& file : mManager.getRecursiveDirectoryIterator("Meshes/"))
+            files.push_back(file);
+        EXPECT_THAT(files, ElementsAre("meshes/a.nif", "meshes/b/c.nif"));
+    }
+
+    TEST_F(VFSManagerTest, getRecursiveDirectoryIteratorForEmptyPathShouldReturnAllFiles)
+    {
+        std::vector<std::string> files;
+        for (const std::string& file : mManager.getRecursiveDirectoryIterator(""))
+            files.push_back(file);
+        EXPECT_THAT(files, ElementsAre("meshes/a.nif", "meshes/b/c.nif", "textures/a.dds"));
+    }
+
+    TEST_F(VFSManagerTest, resetShouldClearIndex)
+    {
+        mManager.reset();
+        EXPECT_FALSE(mManager.exists("meshes/a.nif"));
+    }
+
+    TEST(VFSManagerManyFilesTest, existsShouldFindEveryFile)
+    {
+        VFSTestFile file("content");
+        std::map<std::string, VFS::File*> files;
+        for (int i = 0; i < 1000; ++i)
+            files.emplace("file" + std::to_string(i), &file);
+        const auto manager = createTestVFS(files);
+        for (const auto& [name, _] : files)
+            EXPECT_TRUE(manager->exists(name)) << name;
+        EXPECT_FALSE(manager->exists("file1000"));
+    }
+}
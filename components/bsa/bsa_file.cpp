@@ -22,9 +22,12 @@
  */
 
 #include "bsa_file.hpp"
+#include "memorystream.hpp"
 
 #include <components/files/constrainedfilestream.hpp>
 
+#include <boost/iostreams/device/mapped_file.hpp>
+
 #include <algorithm>
 #include <cassert>
 #include <cstring>
@@ -255,12 +258,39 @@ void Bsa::BSAFile::close()
 
     mFiles.clear();
     mStringBuf.clear();
+    mMappedFile.reset();
     mIsLoaded = false;
 }
 
+void Bsa::BSAFile::enableMemoryMapping()
+{
+    if (!mIsLoaded)
+        fail("Unable to map the archive into memory: the archive is not opened");
+
+    try
+    {
+        mMappedFile = std::make_shared<const boost::iostreams::mapped_file_source>(mFilename);
+    }
+    catch (const std::exception& e)
+    {
+        fail(std::string("Failed to map the archive into memory: ") + e.what());
+    }
+}
+
+Files::IStreamPtr Bsa::BSAFile::openRegion(std::size_t offset, std::size_t size)
+{
+    if (mMappedFile == nullptr)
+        return Files::openConstrainedFileStream(mFilename, offset, size);
+
+    if (offset > mMappedFile->size() || size > mMappedFile->size() - offset)
+        fail("Requested region is outside of the mapped archive");
+
+    return std::make_unique<MappedInputStream>(mMappedFile, offset, size);
+}
+
 Files::IStreamPtr Bsa::BSAFile::getFile(const FileStruct *file)
 {
-    return Files::openConstrainedFileStream(mFilename, file->offset, file->fileSize);
+    return openRegion(file->offset, file->fileSize);
 }
 
 void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
@@ -268,6 +298,9 @@ void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
     if (!mIsLoaded)
         fail("Unable to add file " + filename + " the archive is not opened");
 
+    // The archive is about to be rewritten, so the mapping would no longer match its contents
+    mMappedFile.reset();
+
     auto newStartOfDataBuffer = 12 + (12 + 8) * (mFiles.size() + 1) + mStringBuf.size() + filename.size() + 1;
     if (mFiles.empty())
         std::filesystem::resize_file(mFilename, newStartOfDataBuffer);
@@ -25,11 +25,17 @@
 #define BSA_BSA_FILE_H
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include <components/files/istreamptr.hpp>
 
+namespace boost::iostreams
+{
+    class mapped_file_source;
+}
+
 namespace Bsa
 {
 
@@ -87,6 +93,9 @@ protected:
     /// Used for error messages
     std::string mFilename;
 
+    /// Read-only mapping of the whole archive, set when memory mapping is enabled
+    std::shared_ptr<const boost::iostreams::mapped_file_source> mMappedFile;
+
     /// Error handling
     [[noreturn]] void fail(const std::string &msg);
 
@@ -94,6 +103,10 @@ protected:
     virtual void readHeader();
     virtual void writeHeader();
 
+    /// Open a stream over the given region of the archive. Reads from the mapping
+    /// when memory mapping is enabled, otherwise opens a new file stream.
+    Files::IStreamPtr openRegion(std::size_t offset, std::size_t size);
+
 public:
     /* -----------------------------------
      * BSA management methods
@@ -114,6 +127,13 @@ public:
 
     void close();
 
+    /// Map the whole archive into memory. Streams returned by getFile afterwards are
+    /// views into the mapping and don't need a file handle of their own.
+    /// @note The mapping is kept alive by the streams, so they may outlive the archive.
+    void enableMemoryMapping();
+
+    bool isMemoryMapped() const { return mMappedFile != nullptr; }
+
     /* -----------------------------------
      * Archive file routines
      * -----------------------------------
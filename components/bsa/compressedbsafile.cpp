@@ -25,30 +25,73 @@
 #include "compressedbsafile.hpp"
 
 #include <stdexcept>
+#include <algorithm>
 #include <cassert>
 #include <filesystem>
 #include <fstream>
 
 #include <lz4frame.h>
+#include <zlib.h>
 
+#include <boost/iostreams/device/mapped_file.hpp>
 
-#include <boost/iostreams/filtering_streambuf.hpp>
-#include <boost/iostreams/copy.hpp>
-
-#if defined(_MSC_VER)
-    #pragma warning (push)
-    #pragma warning (disable : 4706)
-    #include <boost/iostreams/filter/zlib.hpp>
-    #pragma warning (pop)
-#else
-    #include <boost/iostreams/filter/zlib.hpp>
-#endif
-
-#include <boost/iostreams/device/array.hpp>
 #include <components/bsa/memorystream.hpp>
 #include <components/misc/strings/lower.hpp>
 #include <components/files/constrainedfilestream.hpp>
 
+namespace
+{
+    /// Decompression contexts are expensive to set up, so every thread keeps its own and reuses it
+    struct LZ4DecompressionContext
+    {
+        LZ4F_dctx* mContext = nullptr;
+
+        LZ4DecompressionContext()
+        {
+            const LZ4F_errorCode_t errorCode = LZ4F_createDecompressionContext(&mContext, LZ4F_VERSION);
+            if (LZ4F_isError(errorCode))
+                throw std::runtime_error(std::string("Failed to create LZ4 decompression context: ") + LZ4F_getErrorName(errorCode));
+        }
+
+        ~LZ4DecompressionContext()
+        {
+            LZ4F_freeDecompressionContext(mContext);
+        }
+    };
+
+    struct ZlibDecompressionContext
+    {
+        z_stream mStream {};
+
+        ZlibDecompressionContext()
+        {
+            if (inflateInit(&mStream) != Z_OK)
+                throw std::runtime_error(std::string("Failed to create zlib decompression context: ")
+                                         + (mStream.msg != nullptr ? mStream.msg : "unknown error"));
+        }
+
+        ~ZlibDecompressionContext()
+        {
+            inflateEnd(&mStream);
+        }
+    };
+
+    LZ4F_dctx* getLZ4DecompressionContext()
+    {
+        thread_local LZ4DecompressionContext context;
+        // Previous use may have failed in the middle of a frame
+        LZ4F_resetDecompressionContext(context.mContext);
+        return context.mContext;
+    }
+
+    z_stream& getZlibDecompressionContext()
+    {
+        thread_local ZlibDecompressionContext context;
+        inflateReset(&context.mStream);
+        return context.mStream;
+    }
+}
+
 namespace Bsa
 {
 //special marker for invalid records,
@@ -207,6 +250,7 @@ void CompressedBSAFile::readHeader()
         folderCount = 1; // TODO: not tested - unit test necessary
 
     mFiles.clear();
+    mFileRecords.clear();
     std::vector<std::string> fullPaths;
     
     for (std::uint32_t i = 0; i < folderCount; ++i)
@@ -236,6 +280,7 @@ void CompressedBSAFile::readHeader()
             fileStruct.fileSize = file.getSizeWithoutCompressionFlag();
             fileStruct.offset = file.offset;
             mFiles.push_back(fileStruct);
+            mFileRecords.push_back(file);
 
             fullPaths.push_back(folder);
         }
@@ -324,9 +369,18 @@ CompressedBSAFile::FileRecord CompressedBSAFile::getFileRecord(const std::string
     return iter->second;
 }
 
-Files::IStreamPtr CompressedBSAFile::getFile(const FileStruct* file) 
+CompressedBSAFile::FileRecord CompressedBSAFile::getFileRecord(const FileStruct* file) const
+{
+    // Files from getList() map directly to their records, anything else is looked up by name
+    const std::less<const FileStruct*> less;
+    if (!mFiles.empty() && !less(file, mFiles.data()) && less(file, mFiles.data() + mFiles.size()))
+        return mFileRecords[static_cast<std::size_t>(file - mFiles.data())];
+    return getFileRecord(file->name());
+}
+
+Files::IStreamPtr CompressedBSAFile::getFile(const FileStruct* file)
 {
-    FileRecord fileRec = getFileRecord(file->name());
+    FileRecord fileRec = getFileRecord(file);
     if (!fileRec.isValid()) {
         fail("File not found: " + std::string(file->name()));
     }
@@ -353,7 +407,7 @@ Files::IStreamPtr CompressedBSAFile::getFile(const FileRecord& fileRecord)
     size_t size = fileRecord.getSizeWithoutCompressionFlag();
     size_t uncompressedSize = size;
     bool compressed = fileRecord.isCompressed(mCompressedByDefault);
-    Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilename, fileRecord.offset, size);
+    Files::IStreamPtr streamPtr = openRegion(fileRecord.offset, size);
     std::istream* fileStream = streamPtr.get();
     if (mEmbeddedFileNames)
     {
@@ -363,38 +417,42 @@ Files::IStreamPtr CompressedBSAFile::getFile(const FileRecord& fileRecord)
         fileStream->ignore(length);
         size -= length + sizeof(char);
     }
+    if (!compressed && isMemoryMapped())
+    {
+        // Stored as is, so the view into the mapping can be handed out without copying
+        const std::size_t headerSize = fileRecord.getSizeWithoutCompressionFlag() - size;
+        return openRegion(fileRecord.offset + headerSize, size);
+    }
     if (compressed)
     {
-        fileStream->read(reinterpret_cast<char*>(&uncompressedSize), sizeof(uint32_t));
+        uint32_t storedSize = 0;
+        fileStream->read(reinterpret_cast<char*>(&storedSize), sizeof(uint32_t));
+        uncompressedSize = storedSize;
         size -= sizeof(uint32_t);
     }
     auto memoryStreamPtr = std::make_unique<MemoryInputStream>(uncompressedSize);
 
     if (compressed)
     {
-        if (mVersion != 0x69) // Non-SSE: zlib
+        std::vector<char> buffer;
+        const char* input = nullptr;
+        if (isMemoryMapped())
         {
-            boost::iostreams::filtering_streambuf<boost::iostreams::input> inputStreamBuf;
-            inputStreamBuf.push(boost::iostreams::zlib_decompressor());
-            inputStreamBuf.push(*fileStream);
-
-            boost::iostreams::basic_array_sink<char> sr(memoryStreamPtr->getRawData(), uncompressedSize);
-            boost::iostreams::copy(inputStreamBuf, sr);
+            // Decompress straight from the mapping
+            const std::size_t headerSize = fileRecord.getSizeWithoutCompressionFlag() - size;
+            input = mMappedFile->data() + fileRecord.offset + headerSize;
         }
-        else // SSE: lz4
+        else
         {
-            auto buffer = std::vector<char>(size);
+            buffer.resize(size);
             fileStream->read(buffer.data(), size);
-            LZ4F_decompressionContext_t context = nullptr;
-            LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
-            LZ4F_decompressOptions_t options = {};
-            LZ4F_errorCode_t errorCode = LZ4F_decompress(context, memoryStreamPtr->getRawData(), &uncompressedSize, buffer.data(), &size, &options);
-            if (LZ4F_isError(errorCode))
-                fail("LZ4 decompression error (file " + mFilename + "): " + LZ4F_getErrorName(errorCode));
-            errorCode = LZ4F_freeDecompressionContext(context);
-            if (LZ4F_isError(errorCode))
-                fail("LZ4 decompression error (file " + mFilename + "): " + LZ4F_getErrorName(errorCode));
+            input = buffer.data();
         }
+
+        if (mVersion != 0x69) // Non-SSE: zlib
+            decompressZlib(input, size, memoryStreamPtr->getRawData(), uncompressedSize);
+        else // SSE: lz4
+            decompressLZ4(input, size, memoryStreamPtr->getRawData(), uncompressedSize);
     }
     else
     {
@@ -404,6 +462,28 @@ Files::IStreamPtr CompressedBSAFile::getFile(const FileRecord& fileRecord)
     return std::make_unique<Files::StreamWithBuffer<MemoryInputStream>>(std::move(memoryStreamPtr));
 }
 
+void CompressedBSAFile::decompressZlib(const char* input, std::size_t inputSize, char* output, std::size_t outputSize)
+{
+    z_stream& stream = getZlibDecompressionContext();
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input));
+    stream.avail_in = static_cast<uInt>(inputSize);
+    stream.next_out = reinterpret_cast<Bytef*>(output);
+    stream.avail_out = static_cast<uInt>(outputSize);
+    const int result = inflate(&stream, Z_FINISH);
+    if (result != Z_STREAM_END)
+        fail("zlib decompression error (file " + mFilename + "): "
+             + (stream.msg != nullptr ? std::string(stream.msg) : std::to_string(result)));
+}
+
+void CompressedBSAFile::decompressLZ4(const char* input, std::size_t inputSize, char* output, std::size_t outputSize)
+{
+    LZ4F_dctx* context = getLZ4DecompressionContext();
+    LZ4F_decompressOptions_t options = {};
+    const LZ4F_errorCode_t errorCode = LZ4F_decompress(context, output, &outputSize, input, &inputSize, &options);
+    if (LZ4F_isError(errorCode))
+        fail("LZ4 decompression error (file " + mFilename + "): " + LZ4F_getErrorName(errorCode));
+}
+
 BsaVersion CompressedBSAFile::detectVersion(const std::string& filePath)
 {
     std::ifstream input(std::filesystem::path(filePath), std::ios_base::binary);
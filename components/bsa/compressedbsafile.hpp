@@ -76,18 +76,24 @@ namespace Bsa
         };
         std::map<std::uint64_t, FolderRecord> mFolders;
 
+        /// File records in the same order as mFiles, to avoid hashing the name on every getFile call
+        std::vector<FileRecord> mFileRecords;
+
         FileRecord getFileRecord(const std::string& str) const;
+        FileRecord getFileRecord(const FileStruct* file) const;
         
         void getBZString(std::string& str, std::istream& filestream);
         //mFiles used by OpenMW will contain uncompressed file sizes
         void convertCompressedSizesToUncompressed();
-        /// \brief Normalizes given filename or folder and generates format-compatible hash. See https://en.uesp.net/wiki/Tes4Mod:Hash_Calculation.
-        static std::uint64_t generateHash(std::string stem, std::string extension) ;
         Files::IStreamPtr getFile(const FileRecord& fileRecord);
+        void decompressZlib(const char* input, std::size_t inputSize, char* output, std::size_t outputSize);
+        void decompressLZ4(const char* input, std::size_t inputSize, char* output, std::size_t outputSize);
     public:
         using BSAFile::open;
         using BSAFile::getList;
         using BSAFile::getFilename;
+        using BSAFile::enableMemoryMapping;
+        using BSAFile::isMemoryMapped;
 
         CompressedBSAFile();
         virtual ~CompressedBSAFile();
@@ -95,11 +101,15 @@ namespace Bsa
         //checks version of BSA from file header
         static BsaVersion detectVersion(const std::string& filePath);
 
+        /// \brief Normalizes given filename or folder and generates format-compatible hash. See https://en.uesp.net/wiki/Tes4Mod:Hash_Calculation.
+        static std::uint64_t generateHash(std::string stem, std::string extension);
+
         /// Read header information from the input source
         void readHeader() override;
        
         Files::IStreamPtr getFile(const char* filePath);
         Files::IStreamPtr getFile(const FileStruct* fileStruct);
+
         void addFile(const std::string& filename, std::istream& file);
     };
 }
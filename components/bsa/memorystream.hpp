@@ -28,8 +28,11 @@
 
 #include <vector>
 #include <istream>
+#include <memory>
 #include <components/files/memorystream.hpp>
 
+#include <boost/iostreams/device/mapped_file.hpp>
+
 namespace Bsa
 {
 /**
@@ -54,5 +57,23 @@ public:
     }
 };
 
+/**
+    Read-only view of a region of a memory mapped archive.
+
+    Reads are served directly from the mapping. The mapping is shared with the
+    archive and stays valid until the last view referring to it is destroyed.
+ */
+class MappedInputStream : public Files::MemBuf, public std::istream {
+public:
+    MappedInputStream(std::shared_ptr<const boost::iostreams::mapped_file_source> file, std::size_t offset, std::size_t size)
+        : Files::MemBuf(file->data() + offset, size)
+        , std::istream(static_cast<std::streambuf*>(this))
+        , mFile(std::move(file))
+    {}
+
+private:
+    std::shared_ptr<const boost::iostreams::mapped_file_source> mFile;
+};
+
 }
 #endif
@@ -207,4 +207,53 @@ namespace Compiler
         for (const auto & mKeyword : mKeywords)
             keywords.push_back (mKeyword.first);
     }
+
+    std::uint64_t Extensions::getHash() const
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+
+        const auto add = [&] (const auto& value)
+        {
+            for (unsigned char byte : value)
+            {
+                hash ^= byte;
+                hash *= 1099511628211ull;
+            }
+            // Separator, so adjacent values can't be shifted into each other
+            hash ^= 0xff;
+            hash *= 1099511628211ull;
+        };
+
+        const auto addInt = [&] (int value)
+        {
+            add(std::to_string(value));
+        };
+
+        for (const auto& [keyword, index] : mKeywords)
+        {
+            add(keyword);
+            addInt(index);
+        }
+
+        for (const auto& [index, function] : mFunctions)
+        {
+            addInt(index);
+            add(std::string(1, function.mReturn));
+            add(function.mArguments);
+            addInt(function.mCode);
+            addInt(function.mCodeExplicit);
+            addInt(function.mSegment);
+        }
+
+        for (const auto& [index, instruction] : mInstructions)
+        {
+            addInt(index);
+            add(instruction.mArguments);
+            addInt(instruction.mCode);
+            addInt(instruction.mCodeExplicit);
+            addInt(instruction.mSegment);
+        }
+
+        return hash;
+    }
 }
@@ -113,8 +113,11 @@ namespace DetourNavigator
 
         bool isWritingDbJob(const Job& job)
         {
-            return job.mGeneratedNavMeshData != nullptr;
+            return job.mGeneratedNavMeshData != nullptr || job.mHasNoNavMeshData;
         }
+
+        // Tile graph is rewritten as a whole, so changes are written when there are no more db jobs or too many of them
+        constexpr std::size_t maxTileGraphChanges = 1024;
     }
 
     std::ostream& operator<<(std::ostream& stream, JobStatus value)
@@ -339,7 +342,7 @@ namespace DetourNavigator
                     {
                         case JobStatus::Done:
                             unlockTile(job->mAgentBounds, job->mChangedTile);
-                            if (job->mGeneratedNavMeshData != nullptr)
+                            if (isWritingDbJob(*job))
                                 mDbWorker->enqueueJob(job);
                             else
                                 removeJob(job);
@@ -486,6 +489,11 @@ namespace DetourNavigator
         {
             Log(Debug::Debug) << "Null navmesh data for job " << job.mId;
             navMeshCacheItem.lock()->markAsEmpty(job.mChangedTile);
+            if (mSettings.get().mWriteToNavMeshDb)
+            {
+                const std::shared_ptr<const TileGraph> graph = getTileGraph(job.mAgentBounds, job.mWorldspace);
+                job.mHasNoNavMeshData = graph != nullptr && graph->find(job.mChangedTile) != nullptr;
+            }
             return JobStatus::Done;
         }
 
@@ -671,6 +679,22 @@ namespace DetourNavigator
         mJobs.erase(job);
     }
 
+    void AsyncNavMeshUpdater::setTileGraph(const AgentBounds& agentBounds, std::string_view worldspace,
+        std::shared_ptr<const TileGraph> graph)
+    {
+        mTileGraphs.lock()->insert_or_assign(std::make_tuple(agentBounds, std::string(worldspace)), std::move(graph));
+    }
+
+    std::shared_ptr<const TileGraph> AsyncNavMeshUpdater::getTileGraph(const AgentBounds& agentBounds,
+        std::string_view worldspace) const
+    {
+        const auto locked = mTileGraphs.lockConst();
+        const auto it = locked->find(std::make_tuple(agentBounds, std::string(worldspace)));
+        if (it == locked->end())
+            return nullptr;
+        return it->second;
+    }
+
     void DbJobQueue::push(JobIt job)
     {
         const std::lock_guard lock(mMutex);
@@ -772,6 +796,15 @@ namespace DetourNavigator
                 Log(Debug::Error) << "DbWorker exception: " << e.what();
             }
         }
+
+        try
+        {
+            writeTileGraphChanges();
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "DbWorker exception while writing tile graph: " << e.what();
+        }
     }
 
     void DbWorker::processJob(JobIt job)
@@ -805,6 +838,9 @@ namespace DetourNavigator
         if (isWritingDbJob(*job))
         {
             process([&] (JobIt job) { processWritingJob(job); });
+            // Before the job is removed so the tile graph is up to date when all jobs are done
+            if (mQueue.getStats().mWritingJobs == 0)
+                process([&] (JobIt) { writeTileGraphChanges(); });
             mUpdater.removeJob(job);
             return;
         }
@@ -814,10 +850,108 @@ namespace DetourNavigator
         mUpdater.enqueueJob(job);
     }
 
+    void DbWorker::loadTileGraph(const Job& job)
+    {
+        if (!mLoadedTileGraphs.emplace(job.mAgentBounds, job.mWorldspace).second)
+            return;
+
+        const auto data = mDb->getTileGraph(job.mWorldspace, serialize(mRecastSettings, job.mAgentBounds));
+        if (!data.has_value() || data->mVersion != mVersion)
+            return;
+
+        auto graph = std::make_shared<TileGraph>();
+        if (!deserialize(data->mData, *graph))
+        {
+            Log(Debug::Warning) << "Failed to deserialize tile graph for worldspace \"" << job.mWorldspace << "\"";
+            return;
+        }
+
+        Log(Debug::Debug) << "Loaded tile graph with " << graph->size() << " nodes for worldspace \""
+            << job.mWorldspace << "\"";
+        mUpdater.setTileGraph(job.mAgentBounds, job.mWorldspace, std::move(graph));
+    }
+
+    void DbWorker::updateTileGraph(const Job& job, std::optional<TileSides> sides)
+    {
+        // Tile graph is built by navmeshtool and would go out of sync with tiles generated for changed content
+        if (mUpdater.getTileGraph(job.mAgentBounds, job.mWorldspace) == nullptr)
+            return;
+
+        auto& changes = mTileGraphChanges[std::make_tuple(job.mAgentBounds, job.mWorldspace)];
+        if (changes.insert_or_assign(job.mChangedTile, sides).second)
+            ++mTileGraphChangesCount;
+
+        if (mTileGraphChangesCount >= maxTileGraphChanges)
+            writeTileGraphChanges();
+    }
+
+    void DbWorker::writeTileGraphChanges()
+    {
+        auto tileGraphChanges = std::move(mTileGraphChanges);
+        mTileGraphChanges.clear();
+        mTileGraphChangesCount = 0;
+
+        for (auto& [key, changes] : tileGraphChanges)
+        {
+            const auto& [agentBounds, worldspace] = key;
+            const std::shared_ptr<const TileGraph> graph = mUpdater.getTileGraph(agentBounds, worldspace);
+            if (graph == nullptr)
+                continue;
+
+            bool changed = false;
+            std::vector<TileGraphNode> nodes;
+            nodes.reserve(graph->size() + changes.size());
+            for (const TileGraphNode& node : graph->getNodes())
+            {
+                const auto it = changes.find(node.mPosition);
+                if (it == changes.end())
+                {
+                    nodes.push_back(node);
+                    continue;
+                }
+                if (it->second.has_value())
+                {
+                    changed = changed || *it->second != node.mSides;
+                    nodes.push_back(TileGraphNode {node.mPosition, *it->second});
+                }
+                else
+                    changed = true;
+                changes.erase(it);
+            }
+            for (const auto& [position, sides] : changes)
+            {
+                if (!sides.has_value())
+                    continue;
+                nodes.push_back(TileGraphNode {position, *sides});
+                changed = true;
+            }
+
+            if (!changed)
+                continue;
+
+            auto updated = std::make_shared<const TileGraph>(std::move(nodes));
+            Log(Debug::Debug) << "Update tile graph with " << updated->size() << " nodes for worldspace \""
+                << worldspace << "\"";
+            const std::vector<std::byte> data = serialize(*updated);
+            mUpdater.setTileGraph(agentBounds, worldspace, std::move(updated));
+            if (mWriteToDb)
+                mDb->replaceTileGraph(worldspace, serialize(mRecastSettings, agentBounds), mVersion, data);
+        }
+    }
+
     void DbWorker::processReadingJob(JobIt job)
     {
         Log(Debug::Debug) << "Processing db read job " << job->mId;
 
+        try
+        {
+            loadTileGraph(*job);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to load tile graph: " << e.what();
+        }
+
         if (job->mInput.empty())
         {
             Log(Debug::Debug) << "Serializing input for job " << job->mId;
@@ -851,6 +985,12 @@ namespace DetourNavigator
 
         Log(Debug::Debug) << "Processing db write job " << job->mId;
 
+        if (job->mHasNoNavMeshData)
+        {
+            updateTileGraph(*job, std::nullopt);
+            return;
+        }
+
         if (job->mInput.empty())
         {
             Log(Debug::Debug) << "Serializing input for job " << job->mId;
@@ -864,6 +1004,7 @@ namespace DetourNavigator
             Log(Debug::Debug) << "Update db tile by job " << job->mId;
             job->mGeneratedNavMeshData->mUserId = cachedTileData->mTileId;
             mDb->updateTile(cachedTileData->mTileId, mVersion, serialize(*job->mGeneratedNavMeshData));
+            updateTileGraph(*job, getPortalSides(job->mGeneratedNavMeshData->mPolyMesh));
             return;
         }
 
@@ -879,5 +1020,6 @@ namespace DetourNavigator
         mDb->insertTile(mNextTileId, job->mWorldspace, job->mChangedTile,
                         mVersion, job->mInput, serialize(*job->mGeneratedNavMeshData));
         ++mNextTileId;
+        updateTileGraph(*job, getPortalSides(job->mGeneratedNavMeshData->mPolyMesh));
     }
 }
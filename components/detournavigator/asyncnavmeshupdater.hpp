@@ -13,6 +13,7 @@
 #include "guardednavmeshcacheitem.hpp"
 #include "sharednavmeshcacheitem.hpp"
 #include "stats.hpp"
+#include "tilegraph.hpp"
 
 #include <osg/Vec3f>
 
@@ -26,8 +27,10 @@
 #include <thread>
 #include <tuple>
 #include <list>
+#include <map>
 #include <optional>
 #include <iosfwd>
+#include <string>
 
 class dtNavMesh;
 
@@ -61,6 +64,7 @@ namespace DetourNavigator
         std::shared_ptr<RecastMesh> mRecastMesh;
         std::optional<TileData> mCachedTileData;
         std::unique_ptr<PreparedNavMeshData> mGeneratedNavMeshData;
+        bool mHasNoNavMeshData = false; // tile node is removed from the tile graph by DbWorker
 
         Job(const AgentBounds& agentBounds, std::weak_ptr<GuardedNavMeshCacheItem> navMeshCacheItem,
             std::string_view worldspace, const TilePosition& changedTile, ChangeType changeType, int distanceToPlayer,
@@ -129,10 +133,20 @@ namespace DetourNavigator
         DbJobQueue mQueue;
         std::atomic_bool mShouldStop {false};
         std::atomic_size_t mGetTileCount {0};
+        std::set<std::tuple<AgentBounds, std::string>> mLoadedTileGraphs;
+        // Node sides by tile, empty to remove the node
+        std::map<std::tuple<AgentBounds, std::string>, std::map<TilePosition, std::optional<TileSides>>> mTileGraphChanges;
+        std::size_t mTileGraphChangesCount = 0;
         std::thread mThread;
 
         inline void run() noexcept;
 
+        inline void loadTileGraph(const Job& job);
+
+        inline void updateTileGraph(const Job& job, std::optional<TileSides> sides);
+
+        inline void writeTileGraphChanges();
+
         inline void processJob(JobIt job);
 
         inline void processReadingJob(JobIt job);
@@ -161,6 +175,12 @@ namespace DetourNavigator
 
         void removeJob(JobIt job);
 
+        void setTileGraph(const AgentBounds& agentBounds, std::string_view worldspace,
+            std::shared_ptr<const TileGraph> graph);
+
+        std::shared_ptr<const TileGraph> getTileGraph(const AgentBounds& agentBounds,
+            std::string_view worldspace) const;
+
     private:
         std::reference_wrapper<const Settings> mSettings;
         std::reference_wrapper<TileCachedRecastMeshManager> mRecastMeshManager;
@@ -179,6 +199,7 @@ namespace DetourNavigator
         std::map<std::tuple<AgentBounds, TilePosition>, std::chrono::steady_clock::time_point> mLastUpdates;
         std::set<std::tuple<AgentBounds, TilePosition>> mPresentTiles;
         std::vector<std::thread> mThreads;
+        Misc::ScopeGuarded<std::map<std::tuple<AgentBounds, std::string>, std::shared_ptr<const TileGraph>>> mTileGraphs;
         std::unique_ptr<DbWorker> mDbWorker;
         std::atomic_size_t mDbGetTileHits {0};
 
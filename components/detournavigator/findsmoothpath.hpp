@@ -251,12 +251,12 @@ namespace DetourNavigator
         return Status::Success;
     }
 
+    /// Uses given query object to avoid reallocating its node pool for each path, it's initialized for navMesh here
     template <class OutputIterator>
-    Status findSmoothPath(const dtNavMesh& navMesh, const osg::Vec3f& halfExtents, const float stepSize,
-            const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags, const AreaCosts& areaCosts,
-            const Settings& settings, float endTolerance, OutputIterator out)
+    Status findSmoothPath(dtNavMeshQuery& navMeshQuery, const dtNavMesh& navMesh, const osg::Vec3f& halfExtents,
+            const float stepSize, const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags,
+            const AreaCosts& areaCosts, const Settings& settings, float endTolerance, OutputIterator out)
     {
-        dtNavMeshQuery navMeshQuery;
         if (!initNavMeshQuery(navMeshQuery, navMesh, settings.mDetour.mMaxNavMeshQueryNodes))
             return Status::InitNavMeshQueryFailed;
 
@@ -299,6 +299,16 @@ namespace DetourNavigator
 
         return partialPath ? Status::PartialPath : Status::Success;
     }
+
+    template <class OutputIterator>
+    Status findSmoothPath(const dtNavMesh& navMesh, const osg::Vec3f& halfExtents, const float stepSize,
+            const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags, const AreaCosts& areaCosts,
+            const Settings& settings, float endTolerance, OutputIterator out)
+    {
+        dtNavMeshQuery navMeshQuery;
+        return findSmoothPath(navMeshQuery, navMesh, halfExtents, stepSize, start, end, includeFlags, areaCosts,
+            settings, endTolerance, out);
+    }
 }
 
 #endif
@@ -10,7 +10,12 @@
 
 #include <components/resource/bulletshape.hpp>
 
+#include <osg/Vec2f>
+#include <osg/Vec3f>
+
+#include <memory>
 #include <string_view>
+#include <vector>
 
 namespace ESM
 {
@@ -28,6 +33,8 @@ namespace DetourNavigator
     struct Settings;
     struct AgentBounds;
     struct Stats;
+    struct PathQuery;
+    class PathRequest;
 
     struct ObjectShapes
     {
@@ -175,6 +182,23 @@ namespace DetourNavigator
          */
         virtual std::map<AgentBounds, SharedNavMeshCacheItem> getNavMeshes() const = 0;
 
+        /**
+         * @brief requestPath queues a path search to be done in background starting from the next update call.
+         * @param query defines the path the same way as findPath arguments do.
+         * @return request to check for the result. Dropping it before the search starts cancels the request.
+         */
+        virtual std::shared_ptr<const PathRequest> requestPath(const PathQuery& query) = 0;
+
+        /**
+         * @brief findTileRoute finds a coarse route over navmesh tiles using a tile graph built by navmeshtool.
+         * Tiles don't have to be loaded so the route can be used to choose intermediate targets for long paths.
+         * Path requests with PathQuery::mMaxDistance find the same route in background threads.
+         * @return centers of the route tiles in real coordinates from start to end, empty when there is no tile
+         * graph for the agent or no route.
+         */
+        virtual std::vector<osg::Vec2f> findTileRoute(const AgentBounds& agentBounds, const osg::Vec3f& start,
+            const osg::Vec3f& end) const = 0;
+
         virtual const Settings& getSettings() const = 0;
 
         virtual Stats getStats() const = 0;
@@ -12,6 +12,7 @@ namespace DetourNavigator
     NavigatorImpl::NavigatorImpl(const Settings& settings, std::unique_ptr<NavMeshDb>&& db)
         : mSettings(settings)
         , mNavMeshManager(mSettings, std::move(db))
+        , mPathRequests(mSettings)
     {
     }
 
@@ -151,6 +152,7 @@ namespace DetourNavigator
         removeUnusedNavMeshes();
         for (const auto& v : mAgents)
             mNavMeshManager.update(playerPosition, v.first);
+        mPathRequests.update();
     }
 
     void NavigatorImpl::wait(Loading::Listener& listener, WaitConditionType waitConditionType)
@@ -169,6 +171,25 @@ namespace DetourNavigator
         return mNavMeshManager.getNavMeshes();
     }
 
+    std::shared_ptr<const PathRequest> NavigatorImpl::requestPath(const PathQuery& query)
+    {
+        auto request = std::make_shared<PathRequest>(query, mNavMeshManager.getNavMesh(query.mAgentBounds),
+            query.mMaxDistance > 0 ? mNavMeshManager.getTileGraph(query.mAgentBounds) : nullptr);
+        std::shared_ptr<const PathRequest> result = request;
+        mPathRequests.push(std::move(request));
+        return result;
+    }
+
+    std::vector<osg::Vec2f> NavigatorImpl::findTileRoute(const AgentBounds& agentBounds, const osg::Vec3f& start,
+        const osg::Vec3f& end) const
+    {
+        const std::shared_ptr<const TileGraph> graph = mNavMeshManager.getTileGraph(agentBounds);
+        if (graph == nullptr)
+            return {};
+        TileRouteSearch search;
+        return DetourNavigator::findTileRoute(*graph, mSettings.mRecast, start, end, maxTileRouteVisitedNodes, search);
+    }
+
     const Settings& NavigatorImpl::getSettings() const
     {
         return mSettings;
@@ -176,7 +197,9 @@ namespace DetourNavigator
 
     Stats NavigatorImpl::getStats() const
     {
-        return mNavMeshManager.getStats();
+        Stats result = mNavMeshManager.getStats();
+        result.mPathRequests = mPathRequests.getStats();
+        return result;
     }
 
     RecastMeshTiles NavigatorImpl::getRecastMeshTiles() const
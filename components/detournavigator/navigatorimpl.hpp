@@ -3,6 +3,7 @@
 
 #include "navigator.hpp"
 #include "navmeshmanager.hpp"
+#include "pathrequestqueue.hpp"
 
 #include <set>
 #include <memory>
@@ -56,6 +57,11 @@ namespace DetourNavigator
 
         std::map<AgentBounds, SharedNavMeshCacheItem> getNavMeshes() const override;
 
+        std::shared_ptr<const PathRequest> requestPath(const PathQuery& query) override;
+
+        std::vector<osg::Vec2f> findTileRoute(const AgentBounds& agentBounds, const osg::Vec3f& start,
+            const osg::Vec3f& end) const override;
+
         const Settings& getSettings() const override;
 
         Stats getStats() const override;
@@ -67,6 +73,7 @@ namespace DetourNavigator
     private:
         Settings mSettings;
         NavMeshManager mNavMeshManager;
+        PathRequestQueue mPathRequests;
         std::optional<TilePosition> mLastPlayerPosition;
         std::map<AgentBounds, std::size_t> mAgents;
         std::unordered_map<ObjectId, ObjectId> mAvoidIds;
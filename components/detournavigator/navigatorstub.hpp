@@ -2,6 +2,7 @@
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVIGATORSTUB_H
 
 #include "navigator.hpp"
+#include "pathrequestqueue.hpp"
 #include "settings.hpp"
 #include "stats.hpp"
 
@@ -62,6 +63,17 @@ namespace DetourNavigator
             return {};
         }
 
+        std::shared_ptr<const PathRequest> requestPath(const PathQuery& query) override
+        {
+            return std::make_shared<const PathRequest>(query, mEmptyNavMeshCacheItem, nullptr);
+        }
+
+        std::vector<osg::Vec2f> findTileRoute(const AgentBounds& /*agentBounds*/, const osg::Vec3f& /*start*/,
+            const osg::Vec3f& /*end*/) const override
+        {
+            return {};
+        }
+
         const Settings& getSettings() const override
         {
             return mDefaultSettings;
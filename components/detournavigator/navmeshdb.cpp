@@ -48,6 +48,17 @@ namespace DetourNavigator
             CREATE UNIQUE INDEX IF NOT EXISTS index_unique_shapes_by_name_and_type_and_hash
                 ON shapes (name, type, hash);
 
+            CREATE TABLE IF NOT EXISTS tile_graphs (
+                tile_graph_id INTEGER PRIMARY KEY,
+                worldspace TEXT NOT NULL,
+                input BLOB NOT NULL,
+                version INTEGER NOT NULL,
+                data BLOB
+            );
+
+            CREATE UNIQUE INDEX IF NOT EXISTS index_unique_tile_graphs_by_worldspace_and_input
+                ON tile_graphs (worldspace, input);
+
             COMMIT;
         )";
 
@@ -73,6 +84,12 @@ namespace DetourNavigator
                AND input = :input
         )";
 
+        constexpr std::string_view getTileDataByIdQuery = R"(
+            SELECT tile_id, version, data
+              FROM tiles
+             WHERE tile_id = :tile_id
+        )";
+
         constexpr std::string_view insertTileQuery = R"(
             INSERT INTO tiles ( tile_id,  worldspace,  version,  tile_position_x,  tile_position_y,  input,  data)
                    VALUES     (:tile_id, :worldspace, :version, :tile_position_x, :tile_position_y, :input, :data)
@@ -128,6 +145,18 @@ namespace DetourNavigator
                    VALUES      (:shape_id, :name, :type, :hash)
         )";
 
+        constexpr std::string_view getTileGraphQuery = R"(
+            SELECT version, data
+              FROM tile_graphs
+             WHERE worldspace = :worldspace
+               AND input = :input
+        )";
+
+        constexpr std::string_view replaceTileGraphQuery = R"(
+            INSERT OR REPLACE INTO tile_graphs ( worldspace,  input,  version,  data)
+                               VALUES          (:worldspace, :input, :version, :data)
+        )";
+
         constexpr std::string_view vacuumQuery = R"(
             VACUUM;
         )";
@@ -169,6 +198,7 @@ namespace DetourNavigator
         , mGetMaxTileId(*mDb, DbQueries::GetMaxTileId {})
         , mFindTile(*mDb, DbQueries::FindTile {})
         , mGetTileData(*mDb, DbQueries::GetTileData {})
+        , mGetTileDataById(*mDb, DbQueries::GetTileDataById {})
         , mInsertTile(*mDb, DbQueries::InsertTile {})
         , mUpdateTile(*mDb, DbQueries::UpdateTile {})
         , mDeleteTilesAt(*mDb, DbQueries::DeleteTilesAt {})
@@ -177,6 +207,8 @@ namespace DetourNavigator
         , mGetMaxShapeId(*mDb, DbQueries::GetMaxShapeId {})
         , mFindShapeId(*mDb, DbQueries::FindShapeId {})
         , mInsertShape(*mDb, DbQueries::InsertShape {})
+        , mGetTileGraph(*mDb, DbQueries::GetTileGraph {})
+        , mReplaceTileGraph(*mDb, DbQueries::ReplaceTileGraph {})
         , mVacuum(*mDb, DbQueries::Vacuum {})
     {
         const std::uint64_t dbPageSize = getPageSize(*mDb);
@@ -220,6 +252,16 @@ namespace DetourNavigator
         return result;
     }
 
+    std::optional<TileData> NavMeshDb::getTileDataById(TileId tileId)
+    {
+        TileData result;
+        auto row = std::tie(result.mTileId, result.mVersion, result.mData);
+        if (&row == request(*mDb, mGetTileDataById, &row, 1, tileId))
+            return {};
+        result.mData = Misc::decompress(result.mData);
+        return result;
+    }
+
     int NavMeshDb::insertTile(TileId tileId, std::string_view worldspace, const TilePosition& tilePosition,
         TileVersion version, const std::vector<std::byte>& input, const std::vector<std::byte>& data)
     {
@@ -271,6 +313,24 @@ namespace DetourNavigator
         return execute(*mDb, mInsertShape, shapeId, name, type, hash);
     }
 
+    std::optional<TileGraphData> NavMeshDb::getTileGraph(std::string_view worldspace,
+        const std::vector<std::byte>& input)
+    {
+        TileGraphData result;
+        auto row = std::tie(result.mVersion, result.mData);
+        if (&row == request(*mDb, mGetTileGraph, &row, 1, worldspace, input))
+            return {};
+        result.mData = Misc::decompress(result.mData);
+        return result;
+    }
+
+    int NavMeshDb::replaceTileGraph(std::string_view worldspace, const std::vector<std::byte>& input,
+        TileVersion version, const std::vector<std::byte>& data)
+    {
+        const std::vector<std::byte> compressedData = Misc::compress(data);
+        return execute(*mDb, mReplaceTileGraph, worldspace, input, version, compressedData);
+    }
+
     void NavMeshDb::vacuum()
     {
         execute(*mDb, mVacuum);
@@ -311,6 +371,16 @@ namespace DetourNavigator
             Sqlite3::bindParameter(db, statement, ":input", input);
         }
 
+        std::string_view GetTileDataById::text() noexcept
+        {
+            return getTileDataByIdQuery;
+        }
+
+        void GetTileDataById::bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId)
+        {
+            Sqlite3::bindParameter(db, statement, ":tile_id", tileId);
+        }
+
         std::string_view InsertTile::text() noexcept
         {
             return insertTileQuery;
@@ -416,6 +486,32 @@ namespace DetourNavigator
             Sqlite3::bindParameter(db, statement, ":hash", hash);
         }
 
+        std::string_view GetTileGraph::text() noexcept
+        {
+            return getTileGraphQuery;
+        }
+
+        void GetTileGraph::bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
+            const std::vector<std::byte>& input)
+        {
+            Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
+            Sqlite3::bindParameter(db, statement, ":input", input);
+        }
+
+        std::string_view ReplaceTileGraph::text() noexcept
+        {
+            return replaceTileGraphQuery;
+        }
+
+        void ReplaceTileGraph::bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
+            const std::vector<std::byte>& input, TileVersion version, const std::vector<std::byte>& data)
+        {
+            Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
+            Sqlite3::bindParameter(db, statement, ":input", input);
+            Sqlite3::bindParameter(db, statement, ":version", version);
+            Sqlite3::bindParameter(db, statement, ":data", data);
+        }
+
         std::string_view Vacuum::text() noexcept
         {
             return vacuumQuery;
@@ -45,6 +45,12 @@ namespace DetourNavigator
         std::vector<std::byte> mData;
     };
 
+    struct TileGraphData
+    {
+        TileVersion mVersion;
+        std::vector<std::byte> mData;
+    };
+
     enum class ShapeType
     {
         Collision = 1,
@@ -75,6 +81,12 @@ namespace DetourNavigator
                 const TilePosition& tilePosition, const std::vector<std::byte>& input);
         };
 
+        struct GetTileDataById
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId);
+        };
+
         struct InsertTile
         {
             static std::string_view text() noexcept;
@@ -131,6 +143,20 @@ namespace DetourNavigator
                 ShapeType type, const Sqlite3::ConstBlob& hash);
         };
 
+        struct GetTileGraph
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
+                const std::vector<std::byte>& input);
+        };
+
+        struct ReplaceTileGraph
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
+                const std::vector<std::byte>& input, TileVersion version, const std::vector<std::byte>& data);
+        };
+
         struct Vacuum
         {
             static std::string_view text() noexcept;
@@ -153,6 +179,8 @@ namespace DetourNavigator
         std::optional<TileData> getTileData(std::string_view worldspace,
             const TilePosition& tilePosition, const std::vector<std::byte>& input);
 
+        std::optional<TileData> getTileDataById(TileId tileId);
+
         int insertTile(TileId tileId, std::string_view worldspace, const TilePosition& tilePosition,
             TileVersion version, const std::vector<std::byte>& input, const std::vector<std::byte>& data);
 
@@ -170,6 +198,11 @@ namespace DetourNavigator
 
         int insertShape(ShapeId shapeId, std::string_view name, ShapeType type, const Sqlite3::ConstBlob& hash);
 
+        std::optional<TileGraphData> getTileGraph(std::string_view worldspace, const std::vector<std::byte>& input);
+
+        int replaceTileGraph(std::string_view worldspace, const std::vector<std::byte>& input, TileVersion version,
+            const std::vector<std::byte>& data);
+
         void vacuum();
 
     private:
@@ -177,6 +210,7 @@ namespace DetourNavigator
         Sqlite3::Statement<DbQueries::GetMaxTileId> mGetMaxTileId;
         Sqlite3::Statement<DbQueries::FindTile> mFindTile;
         Sqlite3::Statement<DbQueries::GetTileData> mGetTileData;
+        Sqlite3::Statement<DbQueries::GetTileDataById> mGetTileDataById;
         Sqlite3::Statement<DbQueries::InsertTile> mInsertTile;
         Sqlite3::Statement<DbQueries::UpdateTile> mUpdateTile;
         Sqlite3::Statement<DbQueries::DeleteTilesAt> mDeleteTilesAt;
@@ -185,6 +219,8 @@ namespace DetourNavigator
         Sqlite3::Statement<DbQueries::GetMaxShapeId> mGetMaxShapeId;
         Sqlite3::Statement<DbQueries::FindShapeId> mFindShapeId;
         Sqlite3::Statement<DbQueries::InsertShape> mInsertShape;
+        Sqlite3::Statement<DbQueries::GetTileGraph> mGetTileGraph;
+        Sqlite3::Statement<DbQueries::ReplaceTileGraph> mReplaceTileGraph;
         Sqlite3::Statement<DbQueries::Vacuum> mVacuum;
     };
 }
@@ -263,6 +263,11 @@ namespace DetourNavigator
         return getCached(agentBounds);
     }
 
+    std::shared_ptr<const TileGraph> NavMeshManager::getTileGraph(const AgentBounds& agentBounds) const
+    {
+        return mAsyncNavMeshUpdater.getTileGraph(agentBounds, mRecastMeshManager.getWorldspace());
+    }
+
     std::map<AgentBounds, SharedNavMeshCacheItem> NavMeshManager::getNavMeshes() const
     {
         return mCache;
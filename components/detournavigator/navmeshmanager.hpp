@@ -58,6 +58,8 @@ namespace DetourNavigator
 
         std::map<AgentBounds, SharedNavMeshCacheItem> getNavMeshes() const;
 
+        std::shared_ptr<const TileGraph> getTileGraph(const AgentBounds& agentBounds) const;
+
         Stats getStats() const;
 
         RecastMeshTiles getRecastMeshTiles() const;
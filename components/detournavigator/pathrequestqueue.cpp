@@ -0,0 +1,225 @@
+#include "pathrequestqueue.hpp"
+#include "findsmoothpath.hpp"
+#include "navmeshcacheitem.hpp"
+#include "settings.hpp"
+#include "settingsutils.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/misc/guarded.hpp>
+
+#include <DetourNavMeshQuery.h>
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        bool isFound(const PathQuery& query, Status status)
+        {
+            return status == Status::Success || (query.mAcceptPartialPath && status == Status::PartialPath);
+        }
+
+        osg::Vec3f getStraightLimitedEnd(const PathQuery& query)
+        {
+            const osg::Vec3f startToEnd = query.mEnd - query.mStart;
+            const float distance = startToEnd.length();
+            if (query.mMaxDistance <= 0 || distance <= query.mMaxDistance)
+                return query.mEnd;
+            return query.mStart + startToEnd * query.mMaxDistance / distance;
+        }
+
+        // Head to the farthest tile of the coarse route within the limit instead of going straight to the end
+        // that may lead into a dead end
+        std::optional<osg::Vec3f> getRouteLimitedEnd(const TileGraph& graph, const RecastSettings& settings,
+            const PathQuery& query, TileRouteSearch& search)
+        {
+            const osg::Vec3f startToEnd = query.mEnd - query.mStart;
+            const osg::Vec2f start2d(query.mStart.x(), query.mStart.y());
+            const float distance2d = (osg::Vec2f(query.mEnd.x(), query.mEnd.y()) - start2d).length();
+            if (distance2d <= query.mMaxDistance)
+                return std::nullopt;
+            const std::vector<osg::Vec2f> route = findTileRoute(graph, settings, query.mStart, query.mEnd,
+                maxTileRouteVisitedNodes, search);
+            for (auto it = route.rbegin(); it != route.rend(); ++it)
+            {
+                const float waypointDistance = (*it - start2d).length();
+                if (waypointDistance > query.mMaxDistance)
+                    continue;
+                const float z = query.mStart.z() + startToEnd.z() * waypointDistance / distance2d;
+                return osg::Vec3f(it->x(), it->y(), z);
+            }
+            return std::nullopt;
+        }
+    }
+
+    PathRequest::PathRequest(const PathQuery& query, const SharedNavMeshCacheItem& navMesh,
+            std::shared_ptr<const TileGraph> tileGraph)
+        : mQuery(query)
+        , mNavMesh(navMesh)
+        , mTileGraph(std::move(tileGraph))
+        , mEnd(getStraightLimitedEnd(query))
+        , mReady(navMesh == nullptr)
+    {
+    }
+
+    PathRequestQueue::PathRequestQueue(const Settings& settings)
+        : mSettings(settings)
+    {
+        if (settings.mAsyncPathFinderThreads == 0)
+            mNavMeshQuery = std::make_unique<dtNavMeshQuery>();
+        for (std::size_t i = 0; i < settings.mAsyncPathFinderThreads; ++i)
+            mThreads.emplace_back([&] { process(); });
+    }
+
+    PathRequestQueue::~PathRequestQueue()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mShouldStop = true;
+        }
+        mHasJob.notify_all();
+        for (std::thread& thread : mThreads)
+            thread.join();
+    }
+
+    void PathRequestQueue::push(std::shared_ptr<PathRequest>&& request)
+    {
+        if (request->isReady())
+            return;
+        mPushed.push_back(std::move(request));
+    }
+
+    void PathRequestQueue::update()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            std::move(mPushed.begin(), mPushed.end(), std::back_inserter(mQueue));
+            mBatchStart = std::chrono::steady_clock::now();
+        }
+        mPushed.clear();
+
+        if (!mThreads.empty())
+        {
+            mHasJob.notify_all();
+            return;
+        }
+
+        // At least one request is processed per frame to make progress even with a small budget
+        while (true)
+        {
+            std::shared_ptr<PathRequest> request;
+            {
+                const std::lock_guard lock(mMutex);
+                request = takeRequest();
+            }
+            if (request == nullptr)
+                return;
+            processRequest(*mNavMeshQuery, mTileRouteSearch, *request);
+            const std::lock_guard lock(mMutex);
+            ++mSolved;
+            if (isBudgetExceeded(std::chrono::steady_clock::now()))
+                return;
+        }
+    }
+
+    PathRequestQueueStats PathRequestQueue::getStats() const
+    {
+        PathRequestQueueStats result;
+        const std::lock_guard lock(mMutex);
+        result.mQueued = mPushed.size() + mQueue.size();
+        result.mProcessing = mProcessing;
+        result.mSolved = mSolved;
+        result.mCancelled = mCancelled;
+        return result;
+    }
+
+    bool PathRequestQueue::isBudgetExceeded(std::chrono::steady_clock::time_point now) const
+    {
+        const std::chrono::milliseconds budget = mSettings.get().mAsyncPathFinderFrameBudget;
+        return budget.count() > 0 && now - mBatchStart >= budget;
+    }
+
+    std::shared_ptr<PathRequest> PathRequestQueue::takeRequest()
+    {
+        while (!mQueue.empty())
+        {
+            std::shared_ptr<PathRequest> request = std::move(mQueue.front());
+            mQueue.pop_front();
+            // Nobody is waiting for the result
+            if (request.use_count() == 1)
+            {
+                ++mCancelled;
+                continue;
+            }
+            return request;
+        }
+        return nullptr;
+    }
+
+    void PathRequestQueue::process() noexcept
+    {
+        Log(Debug::Debug) << "Start process path requests by thread=" << std::this_thread::get_id();
+        dtNavMeshQuery navMeshQuery;
+        TileRouteSearch tileRouteSearch;
+        while (true)
+        {
+            std::shared_ptr<PathRequest> request;
+            {
+                std::unique_lock lock(mMutex);
+                mHasJob.wait(lock, [&]
+                {
+                    return mShouldStop || (!mQueue.empty() && !isBudgetExceeded(std::chrono::steady_clock::now()));
+                });
+                if (mShouldStop)
+                    break;
+                request = takeRequest();
+                if (request == nullptr)
+                    continue;
+                ++mProcessing;
+            }
+            processRequest(navMeshQuery, tileRouteSearch, *request);
+            const std::lock_guard lock(mMutex);
+            --mProcessing;
+            ++mSolved;
+        }
+        Log(Debug::Debug) << "Stop path requests processing by thread=" << std::this_thread::get_id();
+    }
+
+    void PathRequestQueue::processRequest(dtNavMeshQuery& navMeshQuery, TileRouteSearch& tileRouteSearch,
+        PathRequest& request) const
+    {
+        const Settings& settings = mSettings;
+        const PathQuery& query = request.mQuery;
+        const auto findPath = [&] (Flags includeFlags)
+        {
+            request.mPath.clear();
+            const auto navMesh = request.mNavMesh->lockConst();
+            return findSmoothPath(navMeshQuery, navMesh->getImpl(),
+                toNavMeshCoordinates(settings.mRecast, query.mAgentBounds.mHalfExtents),
+                toNavMeshCoordinates(settings.mRecast, query.mStepSize), toNavMeshCoordinates(settings.mRecast, query.mStart),
+                toNavMeshCoordinates(settings.mRecast, request.mEnd), includeFlags, query.mAreaCosts, settings,
+                query.mEndTolerance, std::back_inserter(request.mPath));
+        };
+
+        try
+        {
+            if (request.mTileGraph != nullptr && request.mEnd != query.mEnd)
+                if (const auto end = getRouteLimitedEnd(*request.mTileGraph, settings.mRecast, query, tileRouteSearch))
+                    request.mEnd = *end;
+            request.mStatus = findPath(query.mIncludeFlags);
+            if (!isFound(query, request.mStatus) && query.mFallbackIncludeFlags != Flag_none)
+                request.mStatus = findPath(query.mFallbackIncludeFlags);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "PathRequestQueue::processRequest exception: " << e.what();
+            request.mPath.clear();
+            request.mStatus = Status::FindPathOverPolygonsFailed;
+        }
+
+        request.mReady.store(true, std::memory_order_release);
+    }
+}
@@ -0,0 +1,130 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_PATHREQUESTQUEUE_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_PATHREQUESTQUEUE_H
+
+#include "agentbounds.hpp"
+#include "areatype.hpp"
+#include "flags.hpp"
+#include "sharednavmeshcacheitem.hpp"
+#include "stats.hpp"
+#include "status.hpp"
+#include "tilegraph.hpp"
+
+#include <osg/Vec3f>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class dtNavMeshQuery;
+
+namespace DetourNavigator
+{
+    struct Settings;
+
+    struct PathQuery
+    {
+        AgentBounds mAgentBounds;
+        float mStepSize = 0;
+        osg::Vec3f mStart;
+        osg::Vec3f mEnd;
+        Flags mIncludeFlags = Flag_none;
+        // Used for the second attempt when there is no path with mIncludeFlags, Flag_none disables it
+        Flags mFallbackIncludeFlags = Flag_none;
+        bool mAcceptPartialPath = false;
+        AreaCosts mAreaCosts;
+        float mEndTolerance = 0;
+        // Limits distance from mStart to the path end when positive. The end is moved to the farthest tile of the
+        // coarse tile route within the limit or along a straight line when there is no route.
+        float mMaxDistance = 0;
+    };
+
+    /**
+     * @brief PathRequest is shared by the requester and PathRequestQueue. Status and path can be read only when
+     * request is ready. Request is cancelled when requester drops its reference before processing starts.
+     */
+    class PathRequest
+    {
+    public:
+        /**
+         * @param navMesh is used to find the path, request is ready with Status::NavMeshNotFound when it is nullptr.
+         * @param tileGraph is used to limit the path end by the coarse route, may be nullptr.
+         */
+        PathRequest(const PathQuery& query, const SharedNavMeshCacheItem& navMesh,
+            std::shared_ptr<const TileGraph> tileGraph);
+
+        const PathQuery& getQuery() const { return mQuery; }
+
+        /**
+         * @return the end of the path limited by PathQuery::mMaxDistance.
+         */
+        const osg::Vec3f& getEnd() const { return mEnd; }
+
+        bool isReady() const { return mReady.load(std::memory_order_acquire); }
+
+        Status getStatus() const { return mStatus; }
+
+        const std::vector<osg::Vec3f>& getPath() const { return mPath; }
+
+    private:
+        friend class PathRequestQueue;
+
+        const PathQuery mQuery;
+        const SharedNavMeshCacheItem mNavMesh;
+        const std::shared_ptr<const TileGraph> mTileGraph;
+        osg::Vec3f mEnd;
+        Status mStatus = Status::NavMeshNotFound;
+        std::vector<osg::Vec3f> mPath;
+        std::atomic_bool mReady {false};
+    };
+
+    /**
+     * @brief PathRequestQueue finds paths for requests pushed during a frame in background threads. Requests are
+     * handed to threads once per frame by update call. Threads stop to take new requests when frame budget is
+     * exceeded and continue after next update. Without threads requests are processed by update within the budget.
+     */
+    class PathRequestQueue
+    {
+    public:
+        explicit PathRequestQueue(const Settings& settings);
+
+        ~PathRequestQueue();
+
+        void push(std::shared_ptr<PathRequest>&& request);
+
+        void update();
+
+        PathRequestQueueStats getStats() const;
+
+    private:
+        std::reference_wrapper<const Settings> mSettings;
+        mutable std::mutex mMutex;
+        std::condition_variable mHasJob;
+        bool mShouldStop = false;
+        std::deque<std::shared_ptr<PathRequest>> mPushed;
+        std::deque<std::shared_ptr<PathRequest>> mQueue;
+        std::chrono::steady_clock::time_point mBatchStart;
+        std::size_t mProcessing = 0;
+        std::size_t mSolved = 0;
+        std::size_t mCancelled = 0;
+        std::unique_ptr<dtNavMeshQuery> mNavMeshQuery;
+        TileRouteSearch mTileRouteSearch;
+        std::vector<std::thread> mThreads;
+
+        bool isBudgetExceeded(std::chrono::steady_clock::time_point now) const;
+
+        std::shared_ptr<PathRequest> takeRequest();
+
+        void process() noexcept;
+
+        void processRequest(dtNavMeshQuery& navMeshQuery, TileRouteSearch& tileRouteSearch,
+            PathRequest& request) const;
+    };
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include "settings.hpp"
 #include "agentbounds.hpp"
 #include "tilebounds.hpp"
+#include "tilegraph.hpp"
 
 #include <components/serialization/binaryreader.hpp>
 #include <components/serialization/binarywriter.hpp>
@@ -149,6 +150,13 @@ namespace
             visitor(*this, dbRefGeometryObjects);
         }
 
+        template <class Visitor>
+        void operator()(Visitor&& visitor, const RecastSettings& settings, const AgentBounds& agentBounds) const
+        {
+            visitor(*this, settings);
+            visitor(*this, agentBounds);
+        }
+
         template <class Visitor, class T>
         auto operator()(Visitor&& visitor, T& value) const
             -> std::enable_if_t<std::is_same_v<std::decay_t<T>, rcPolyMesh>>
@@ -238,6 +246,39 @@ namespace
             visitor(*this, value.mShapeType);
             visitor(*this, value.mHalfExtents);
         }
+
+        template <class Visitor, class T>
+        auto operator()(Visitor&& visitor, T& value) const
+            -> std::enable_if_t<std::is_same_v<std::decay_t<T>, TileGraphNode>>
+        {
+            visitor(*this, value.mPosition.ptr(), 2);
+            visitor(*this, value.mSides);
+        }
+
+        template <class Visitor>
+        void operator()(Visitor&& visitor, const TileGraph& value) const
+        {
+            visitor(*this, DetourNavigator::tileGraphMagic);
+            visitor(*this, DetourNavigator::tileGraphVersion);
+            visitor(*this, value.getNodes());
+        }
+
+        template <class Visitor>
+        void operator()(Visitor&& visitor, TileGraph& value) const
+        {
+            static_assert(mode == Serialization::Mode::Read);
+            char magic[std::size(DetourNavigator::tileGraphMagic)];
+            visitor(*this, magic);
+            if (std::memcmp(magic, DetourNavigator::tileGraphMagic, sizeof(magic)) != 0)
+                throw std::runtime_error("Bad TileGraph magic");
+            std::uint32_t version = 0;
+            visitor(*this, version);
+            if (version != DetourNavigator::tileGraphVersion)
+                throw std::runtime_error("Bad TileGraph version");
+            std::vector<TileGraphNode> nodes;
+            visitor(*this, nodes);
+            value = TileGraph(std::move(nodes));
+        }
     };
 }
 } // namespace DetourNavigator
@@ -279,4 +320,38 @@ namespace DetourNavigator
             return false;
         }
     }
+
+    std::vector<std::byte> serialize(const RecastSettings& settings, const AgentBounds& agentBounds)
+    {
+        constexpr Format<Serialization::Mode::Write> format;
+        Serialization::SizeAccumulator sizeAccumulator;
+        format(sizeAccumulator, settings, agentBounds);
+        std::vector<std::byte> result(sizeAccumulator.value());
+        format(Serialization::BinaryWriter(result.data(), result.data() + result.size()), settings, agentBounds);
+        return result;
+    }
+
+    std::vector<std::byte> serialize(const TileGraph& value)
+    {
+        constexpr Format<Serialization::Mode::Write> format;
+        Serialization::SizeAccumulator sizeAccumulator;
+        format(sizeAccumulator, value);
+        std::vector<std::byte> result(sizeAccumulator.value());
+        format(Serialization::BinaryWriter(result.data(), result.data() + result.size()), value);
+        return result;
+    }
+
+    bool deserialize(const std::vector<std::byte>& data, TileGraph& value)
+    {
+        try
+        {
+            constexpr Format<Serialization::Mode::Read> format;
+            format(Serialization::BinaryReader(data.data(), data.data() + data.size()), value);
+            return true;
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+    }
 }
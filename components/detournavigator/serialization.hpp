@@ -12,6 +12,7 @@ namespace DetourNavigator
     struct PreparedNavMeshData;
     struct RecastSettings;
     struct AgentBounds;
+    class TileGraph;
 
     constexpr char recastMeshMagic[] = {'r', 'c', 's', 't'};
     constexpr std::uint32_t recastMeshVersion = 2;
@@ -19,12 +20,21 @@ namespace DetourNavigator
     constexpr char preparedNavMeshDataMagic[] = {'p', 'n', 'a', 'v'};
     constexpr std::uint32_t preparedNavMeshDataVersion = 1;
 
+    constexpr char tileGraphMagic[] = {'t', 'g', 'r', 'f'};
+    constexpr std::uint32_t tileGraphVersion = 1;
+
     std::vector<std::byte> serialize(const RecastSettings& settings, const AgentBounds& agentBounds,
         const RecastMesh& recastMesh, const std::vector<DbRefGeometryObject>& dbRefGeometryObjects);
 
     std::vector<std::byte> serialize(const PreparedNavMeshData& value);
 
     bool deserialize(const std::vector<std::byte>& data, PreparedNavMeshData& value);
+
+    std::vector<std::byte> serialize(const RecastSettings& settings, const AgentBounds& agentBounds);
+
+    std::vector<std::byte> serialize(const TileGraph& value);
+
+    bool deserialize(const std::vector<std::byte>& data, TileGraph& value);
 }
 
 #endif
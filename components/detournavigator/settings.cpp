@@ -61,6 +61,8 @@ namespace DetourNavigator
         result.mEnableRecastMeshFileNameRevision = ::Settings::Manager::getBool("enable recast mesh file name revision", "Navigator");
         result.mEnableNavMeshFileNameRevision = ::Settings::Manager::getBool("enable nav mesh file name revision", "Navigator");
         result.mMinUpdateInterval = std::chrono::milliseconds(::Settings::Manager::getInt("min update interval ms", "Navigator"));
+        result.mAsyncPathFinderThreads = static_cast<std::size_t>(std::max(0, ::Settings::Manager::getInt("async path finder threads", "Navigator")));
+        result.mAsyncPathFinderFrameBudget = std::chrono::milliseconds(std::max(0, ::Settings::Manager::getInt("async path finder frame budget ms", "Navigator")));
         result.mEnableNavMeshDiskCache = ::Settings::Manager::getBool("enable nav mesh disk cache", "Navigator");
         result.mWriteToNavMeshDb = ::Settings::Manager::getBool("write to navmeshdb", "Navigator");
         result.mMaxDbFileSize = static_cast<std::uint64_t>(::Settings::Manager::getInt64("max navmeshdb file size", "Navigator"));
@@ -46,10 +46,12 @@ namespace DetourNavigator
         int mWaitUntilMinDistanceToPlayer = 0;
         int mMaxTilesNumber = 0;
         std::size_t mAsyncNavMeshUpdaterThreads = 0;
+        std::size_t mAsyncPathFinderThreads = 0;
         std::size_t mMaxNavMeshTilesCacheSize = 0;
         std::string mRecastMeshPathPrefix;
         std::string mNavMeshPathPrefix;
         std::chrono::milliseconds mMinUpdateInterval;
+        std::chrono::milliseconds mAsyncPathFinderFrameBudget {0};
         std::uint64_t mMaxDbFileSize = 0;
     };
 
@@ -30,11 +30,21 @@ namespace DetourNavigator
                 out.setAttribute(frameNumber, "NavMesh CacheHitRate", static_cast<double>(stats.mCache.mHitCount)
                                  / stats.mCache.mGetCount * 100.0);
         }
+
+        void reportStats(const PathRequestQueueStats& stats, unsigned int frameNumber, osg::Stats& out)
+        {
+            out.setAttribute(frameNumber, "NavMesh PathRequests Queued", static_cast<double>(stats.mQueued));
+            out.setAttribute(frameNumber, "NavMesh PathRequests Processing", static_cast<double>(stats.mProcessing));
+            out.setAttribute(frameNumber, "NavMesh PathRequests Solved", static_cast<double>(stats.mSolved));
+            out.setAttribute(frameNumber, "NavMesh PathRequests Cancelled", static_cast<double>(stats.mCancelled));
+        }
     }
 
     void reportStats(const Stats& stats, unsigned int frameNumber, osg::Stats& out)
     {
         if (stats.mUpdater.has_value())
             reportStats(*stats.mUpdater, frameNumber, out);
+        if (stats.mPathRequests.has_value())
+            reportStats(*stats.mPathRequests, frameNumber, out);
     }
 }
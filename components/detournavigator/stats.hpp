@@ -43,9 +43,18 @@ namespace DetourNavigator
         NavMeshTilesCacheStats mCache;
     };
 
+    struct PathRequestQueueStats
+    {
+        std::size_t mQueued = 0;
+        std::size_t mProcessing = 0;
+        std::size_t mSolved = 0;
+        std::size_t mCancelled = 0;
+    };
+
     struct Stats
     {
         std::optional<AsyncNavMeshUpdaterStats> mUpdater;
+        std::optional<PathRequestQueueStats> mPathRequests;
     };
 
     void reportStats(const Stats& stats, unsigned int frameNumber, osg::Stats& out);
@@ -0,0 +1,261 @@
+#include "tilegraph.hpp"
+#include "settingsutils.hpp"
+
+#include <Recast.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <utility>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        constexpr TileSide tileSides[] = {
+            TileSide_negativeX,
+            TileSide_positiveY,
+            TileSide_positiveX,
+            TileSide_negativeY,
+        };
+
+        // rcBuildPolyMesh marks edges on the tile border as 0x8000 | direction
+        constexpr unsigned short portalFlag = 0x8000;
+
+        TileSide getPortalSide(unsigned short neighbour)
+        {
+            switch (neighbour & 0xf)
+            {
+                case 0: return TileSide_negativeX;
+                case 1: return TileSide_positiveY;
+                case 2: return TileSide_positiveX;
+                case 3: return TileSide_negativeY;
+            }
+            return TileSide_none;
+        }
+
+        bool lessByPosition(const TileGraphNode& lhs, const TileGraphNode& rhs)
+        {
+            return lhs.mPosition < rhs.mPosition;
+        }
+
+        int getDistance(const TilePosition& lhs, const TilePosition& rhs)
+        {
+            return std::abs(lhs.x() - rhs.x()) + std::abs(lhs.y() - rhs.y());
+        }
+
+        constexpr std::size_t noParent = std::numeric_limits<std::size_t>::max();
+    }
+
+    TileGraph::TileGraph(std::vector<TileGraphNode> nodes)
+        : mNodes(std::move(nodes))
+    {
+        std::sort(mNodes.begin(), mNodes.end(), lessByPosition);
+        mNodes.erase(std::unique(mNodes.begin(), mNodes.end(),
+            [] (const TileGraphNode& lhs, const TileGraphNode& rhs) { return lhs.mPosition == rhs.mPosition; }),
+            mNodes.end());
+
+        // Label connected components once to reject unreachable ends without exploring the whole component
+        mComponents.resize(mNodes.size(), noParent);
+        std::vector<std::size_t> stack;
+        std::size_t component = 0;
+        for (std::size_t i = 0; i < mNodes.size(); ++i)
+        {
+            if (mComponents[i] != noParent)
+                continue;
+            mComponents[i] = component;
+            stack.push_back(i);
+            while (!stack.empty())
+            {
+                const std::size_t index = stack.back();
+                stack.pop_back();
+                for (const TileSide side : tileSides)
+                {
+                    if (!isConnected(mNodes[index].mPosition, side))
+                        continue;
+                    const std::size_t neighbourIndex = getIndex(getNeighbour(mNodes[index].mPosition, side));
+                    if (mComponents[neighbourIndex] != noParent)
+                        continue;
+                    mComponents[neighbourIndex] = component;
+                    stack.push_back(neighbourIndex);
+                }
+            }
+            ++component;
+        }
+    }
+
+    std::size_t TileGraph::getIndex(const TilePosition& position) const
+    {
+        const TileGraphNode key {position, TileSide_none};
+        const auto it = std::lower_bound(mNodes.begin(), mNodes.end(), key, lessByPosition);
+        if (it == mNodes.end() || it->mPosition != position)
+            return mNodes.size();
+        return static_cast<std::size_t>(it - mNodes.begin());
+    }
+
+    const TileGraphNode* TileGraph::find(const TilePosition& position) const
+    {
+        const std::size_t index = getIndex(position);
+        if (index == mNodes.size())
+            return nullptr;
+        return &mNodes[index];
+    }
+
+    bool TileGraph::isConnected(const TilePosition& position, TileSide side) const
+    {
+        const TileGraphNode* const node = find(position);
+        if (node == nullptr || (node->mSides & side) == 0)
+            return false;
+        const TileGraphNode* const neighbour = find(getNeighbour(position, side));
+        return neighbour != nullptr && (neighbour->mSides & getOpposite(side)) != 0;
+    }
+
+    std::vector<TilePosition> TileGraph::findRoute(const TilePosition& start, const TilePosition& end,
+        std::size_t maxVisitedNodes, TileRouteSearch& search) const
+    {
+        const std::size_t startIndex = getIndex(start);
+        const std::size_t endIndex = getIndex(end);
+        if (startIndex == mNodes.size() || endIndex == mNodes.size()
+                || mComponents[startIndex] != mComponents[endIndex])
+            return {};
+
+        // Buffers keep initial values between searches, only entries touched by the search are reset
+        std::vector<int>& costs = search.mCosts;
+        std::vector<std::size_t>& parents = search.mParents;
+        std::vector<std::size_t>& visited = search.mVisited;
+        std::vector<std::pair<int, std::size_t>>& open = search.mOpen;
+        if (costs.size() < mNodes.size())
+        {
+            costs.resize(mNodes.size(), std::numeric_limits<int>::max());
+            parents.resize(mNodes.size(), noParent);
+        }
+        const auto update = [&] (std::size_t index, int cost, std::size_t parent)
+        {
+            if (costs[index] == std::numeric_limits<int>::max())
+                visited.push_back(index);
+            costs[index] = cost;
+            parents[index] = parent;
+            open.emplace_back(cost + getDistance(mNodes[index].mPosition, end), index);
+            std::push_heap(open.begin(), open.end(), std::greater<>());
+        };
+
+        update(startIndex, 0, noParent);
+
+        bool found = false;
+        std::size_t expanded = 0;
+        while (!open.empty())
+        {
+            std::pop_heap(open.begin(), open.end(), std::greater<>());
+            const auto [estimate, index] = open.back();
+            open.pop_back();
+
+            if (index == endIndex)
+            {
+                found = true;
+                break;
+            }
+
+            const TileGraphNode& node = mNodes[index];
+            if (estimate - getDistance(node.mPosition, end) > costs[index])
+                continue;
+
+            if (++expanded > maxVisitedNodes)
+                break;
+
+            for (const TileSide side : tileSides)
+            {
+                if ((node.mSides & side) == 0)
+                    continue;
+                const std::size_t neighbourIndex = getIndex(getNeighbour(node.mPosition, side));
+                if (neighbourIndex == mNodes.size() || (mNodes[neighbourIndex].mSides & getOpposite(side)) == 0)
+                    continue;
+                const int cost = costs[index] + 1;
+                if (cost < costs[neighbourIndex])
+                    update(neighbourIndex, cost, index);
+            }
+        }
+
+        std::vector<TilePosition> result;
+        if (found)
+        {
+            for (std::size_t index = endIndex; index != noParent; index = parents[index])
+                result.push_back(mNodes[index].mPosition);
+            std::reverse(result.begin(), result.end());
+        }
+
+        for (const std::size_t index : visited)
+        {
+            costs[index] = std::numeric_limits<int>::max();
+            parents[index] = noParent;
+        }
+        visited.clear();
+        open.clear();
+
+        return result;
+    }
+
+    std::vector<TilePosition> TileGraph::findRoute(const TilePosition& start, const TilePosition& end) const
+    {
+        TileRouteSearch search;
+        return findRoute(start, end, std::numeric_limits<std::size_t>::max(), search);
+    }
+
+    std::vector<osg::Vec2f> findTileRoute(const TileGraph& graph, const RecastSettings& settings,
+        const osg::Vec3f& start, const osg::Vec3f& end, std::size_t maxVisitedNodes, TileRouteSearch& search)
+    {
+        const std::vector<TilePosition> route = graph.findRoute(
+            getTilePosition(settings, toNavMeshCoordinates(settings, start)),
+            getTilePosition(settings, toNavMeshCoordinates(settings, end)), maxVisitedNodes, search);
+        const float tileSize = getRealTileSize(settings);
+        std::vector<osg::Vec2f> result;
+        result.reserve(route.size());
+        for (const TilePosition& tilePosition : route)
+            result.emplace_back((tilePosition.x() + 0.5f) * tileSize, (tilePosition.y() + 0.5f) * tileSize);
+        return result;
+    }
+
+    TileSides getPortalSides(const rcPolyMesh& polyMesh)
+    {
+        TileSides result = TileSide_none;
+        for (int i = 0; i < polyMesh.npolys; ++i)
+        {
+            if (polyMesh.flags[i] == 0)
+                continue;
+            const unsigned short* const neighbours = polyMesh.polys + 2 * i * polyMesh.nvp + polyMesh.nvp;
+            for (int j = 0; j < polyMesh.nvp; ++j)
+            {
+                const unsigned short neighbour = neighbours[j];
+                if (neighbour != RC_MESH_NULL_IDX && (neighbour & portalFlag) != 0)
+                    result |= getPortalSide(neighbour);
+            }
+        }
+        return result;
+    }
+
+    TilePosition getNeighbour(const TilePosition& position, TileSide side)
+    {
+        switch (side)
+        {
+            case TileSide_none: break;
+            case TileSide_negativeX: return TilePosition(position.x() - 1, position.y());
+            case TileSide_positiveY: return TilePosition(position.x(), position.y() + 1);
+            case TileSide_positiveX: return TilePosition(position.x() + 1, position.y());
+            case TileSide_negativeY: return TilePosition(position.x(), position.y() - 1);
+        }
+        return position;
+    }
+
+    TileSide getOpposite(TileSide side)
+    {
+        switch (side)
+        {
+            case TileSide_none: break;
+            case TileSide_negativeX: return TileSide_positiveX;
+            case TileSide_positiveY: return TileSide_negativeY;
+            case TileSide_positiveX: return TileSide_negativeX;
+            case TileSide_negativeY: return TileSide_positiveY;
+        }
+        return TileSide_none;
+    }
+}
@@ -0,0 +1,111 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_TILEGRAPH_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_TILEGRAPH_H
+
+#include "tileposition.hpp"
+
+#include <osg/Vec2f>
+#include <osg/Vec3f>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+struct rcPolyMesh;
+
+namespace DetourNavigator
+{
+    struct RecastSettings;
+
+    // Limits the work of a single route search. A* with a straight line heuristic visits much less tiles for routes
+    // without long detours even in the largest worldspaces.
+    constexpr std::size_t maxTileRouteVisitedNodes = 16384;
+
+    using TileSides = std::uint8_t;
+
+    enum TileSide : TileSides
+    {
+        TileSide_none = 0,
+        TileSide_negativeX = 1 << 0,
+        TileSide_positiveY = 1 << 1,
+        TileSide_positiveX = 1 << 2,
+        TileSide_negativeY = 1 << 3,
+    };
+
+    struct TileGraphNode
+    {
+        TilePosition mPosition;
+        TileSides mSides = TileSide_none;
+    };
+
+    /**
+     * @brief TileRouteSearch keeps TileGraph::findRoute buffers between calls to avoid allocations for each route.
+     * It can be used with different graphs but only by one thread at the same time.
+     */
+    class TileRouteSearch
+    {
+    private:
+        friend class TileGraph;
+
+        std::vector<int> mCosts;
+        std::vector<std::size_t> mParents;
+        std::vector<std::size_t> mVisited;
+        std::vector<std::pair<int, std::size_t>> mOpen;
+    };
+
+    /**
+     * @brief TileGraph is a coarse abstraction of a worldspace navmesh. Each node is a navmesh tile with a set of
+     * sides having walkable polygons on the tile border. Neighbour tiles are connected when both have walkable
+     * polygons on the shared border. Connectivity inside a tile is not tracked so a route over the graph is only
+     * a hint for a detailed search.
+     */
+    class TileGraph
+    {
+    public:
+        TileGraph() = default;
+
+        explicit TileGraph(std::vector<TileGraphNode> nodes);
+
+        const std::vector<TileGraphNode>& getNodes() const { return mNodes; }
+
+        bool empty() const { return mNodes.empty(); }
+
+        std::size_t size() const { return mNodes.size(); }
+
+        const TileGraphNode* find(const TilePosition& position) const;
+
+        bool isConnected(const TilePosition& position, TileSide side) const;
+
+        /**
+         * @brief findRoute finds a shortest sequence of connected tiles from start to end using A*.
+         * Tiles from different connected components are rejected without a search.
+         * @param maxVisitedNodes limits the number of expanded tiles, the route is not found when it is exceeded.
+         * @return tiles positions including start and end, empty when there is no route.
+         */
+        std::vector<TilePosition> findRoute(const TilePosition& start, const TilePosition& end,
+            std::size_t maxVisitedNodes, TileRouteSearch& search) const;
+
+        std::vector<TilePosition> findRoute(const TilePosition& start, const TilePosition& end) const;
+
+    private:
+        std::vector<TileGraphNode> mNodes;
+        std::vector<std::size_t> mComponents;
+
+        std::size_t getIndex(const TilePosition& position) const;
+    };
+
+    /**
+     * @brief findTileRoute converts start and end into tiles positions and finds a route over the graph.
+     * @return centers of the route tiles in real coordinates from start to end, empty when there is no route.
+     */
+    std::vector<osg::Vec2f> findTileRoute(const TileGraph& graph, const RecastSettings& settings,
+        const osg::Vec3f& start, const osg::Vec3f& end, std::size_t maxVisitedNodes, TileRouteSearch& search);
+
+    TileSides getPortalSides(const rcPolyMesh& polyMesh);
+
+    TilePosition getNeighbour(const TilePosition& position, TileSide side);
+
+    TileSide getOpposite(TileSide side);
+}
+
+#endif
@@ -3,6 +3,7 @@
 #include "readerscache.hpp"
 
 #include <components/misc/strings/algorithm.hpp>
+#include <components/files/compressedstream.hpp>
 #include <components/files/openfile.hpp>
 
 #include <stdexcept>
@@ -88,7 +89,11 @@ void ESMReader::resolveParentFileIndices(ReadersCache& readers)
 void ESMReader::openRaw(std::unique_ptr<std::istream>&& stream, std::string_view name)
 {
     close();
-    mEsm = std::move(stream);
+    // Saved games may be written as compressed stream
+    if (Files::isCompressedStream(*stream))
+        mEsm = Files::openCompressedStream(std::move(stream));
+    else
+        mEsm = std::move(stream);
     mCtx.filename = name;
     mEsm->seekg(0, mEsm->end);
     mCtx.leftFile = mFileSize = mEsm->tellg();
@@ -0,0 +1,205 @@
+#include "compressedstream.hpp"
+#include "streamwithbuffer.hpp"
+
+#include <components/misc/compression.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+namespace Files
+{
+    namespace
+    {
+        constexpr char magic[] = {'O', 'M', 'W', 'Z'};
+        constexpr std::uint32_t version = 1;
+        constexpr std::size_t noBlock = std::numeric_limits<std::size_t>::max();
+
+        template <class T>
+        T read(std::istream& stream)
+        {
+            T value;
+            if (!stream.read(reinterpret_cast<char*>(&value), sizeof(value)))
+                throw std::runtime_error("Failed to read compressed stream header");
+            return value;
+        }
+
+        template <class T>
+        void write(std::ostream& stream, const T& value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        std::size_t getHeaderSize(std::size_t blocksCount)
+        {
+            return sizeof(magic) + sizeof(version) + sizeof(std::uint32_t) + sizeof(std::uint64_t)
+                + sizeof(std::uint32_t) + blocksCount * (sizeof(std::uint64_t) + sizeof(std::uint32_t));
+        }
+    }
+
+    CompressedStreamBuf::CompressedStreamBuf(IStreamPtr&& stream)
+        : mStream(std::move(stream))
+        , mOrigin(static_cast<std::uint64_t>(mStream->tellg()))
+        , mCurrentBlock(noBlock)
+    {
+        char fileMagic[sizeof(magic)];
+        if (!mStream->read(fileMagic, sizeof(fileMagic)) || std::memcmp(fileMagic, magic, sizeof(magic)) != 0)
+            throw std::runtime_error("Not a compressed stream");
+        const auto fileVersion = read<std::uint32_t>(*mStream);
+        if (fileVersion != version)
+            throw std::runtime_error("Unsupported compressed stream version: " + std::to_string(fileVersion));
+        mBlockSize = read<std::uint32_t>(*mStream);
+        mSize = read<std::uint64_t>(*mStream);
+        const auto blocksCount = read<std::uint32_t>(*mStream);
+        if (mBlockSize == 0 || (mSize + mBlockSize - 1) / mBlockSize != blocksCount)
+            throw std::runtime_error("Invalid compressed stream header");
+        mBlocks.reserve(blocksCount);
+        for (std::uint32_t i = 0; i < blocksCount; ++i)
+        {
+            const auto offset = read<std::uint64_t>(*mStream);
+            const auto size = read<std::uint32_t>(*mStream);
+            mBlocks.push_back(Block {offset, size});
+        }
+        setg(nullptr, nullptr, nullptr);
+    }
+
+    std::streambuf::int_type CompressedStreamBuf::underflow()
+    {
+        if (gptr() == egptr())
+        {
+            const std::uint64_t position = mBufferOrigin + static_cast<std::uint64_t>(egptr() - eback());
+            if (position >= mSize)
+                return traits_type::eof();
+            seekTo(position);
+        }
+        return traits_type::to_int_type(*gptr());
+    }
+
+    std::streambuf::pos_type CompressedStreamBuf::seekoff(off_type offset, std::ios_base::seekdir whence,
+        std::ios_base::openmode mode)
+    {
+        if ((mode & std::ios_base::out) || !(mode & std::ios_base::in))
+            return traits_type::eof();
+
+        off_type newPos;
+        switch (whence)
+        {
+            case std::ios_base::beg:
+                newPos = offset;
+                break;
+            case std::ios_base::cur:
+                newPos = static_cast<off_type>(mBufferOrigin) + (gptr() - eback()) + offset;
+                // tellg, keep the loaded block
+                if (offset == 0)
+                    return newPos;
+                break;
+            case std::ios_base::end:
+                newPos = static_cast<off_type>(mSize) + offset;
+                break;
+            default:
+                return traits_type::eof();
+        }
+
+        return seekpos(newPos, mode);
+    }
+
+    std::streambuf::pos_type CompressedStreamBuf::seekpos(pos_type pos, std::ios_base::openmode mode)
+    {
+        if ((mode & std::ios_base::out) || !(mode & std::ios_base::in))
+            return traits_type::eof();
+
+        if (static_cast<off_type>(pos) < 0 || static_cast<std::uint64_t>(pos) > mSize)
+            return traits_type::eof();
+
+        const auto position = static_cast<std::uint64_t>(pos);
+        if (position == mSize)
+        {
+            // Block is loaded by underflow if there is something to read
+            mBufferOrigin = position;
+            setg(nullptr, nullptr, nullptr);
+        }
+        else
+            seekTo(position);
+
+        return pos;
+    }
+
+    void CompressedStreamBuf::seekTo(std::uint64_t position)
+    {
+        const std::size_t block = static_cast<std::size_t>(position / mBlockSize);
+        if (block != mCurrentBlock)
+            loadBlock(block);
+        mBufferOrigin = static_cast<std::uint64_t>(block) * mBlockSize;
+        char* const begin = reinterpret_cast<char*>(mBuffer.data());
+        setg(begin, begin + (position - mBufferOrigin), begin + mBuffer.size());
+    }
+
+    void CompressedStreamBuf::loadBlock(std::size_t index)
+    {
+        const Block& block = mBlocks[index];
+        std::vector<std::byte> compressed(block.mSize);
+        mStream->clear();
+        mStream->seekg(static_cast<std::streamoff>(mOrigin + block.mOffset));
+        if (!mStream->read(reinterpret_cast<char*>(compressed.data()), static_cast<std::streamsize>(compressed.size())))
+            throw std::runtime_error("Failed to read compressed block " + std::to_string(index));
+        mCurrentBlock = noBlock;
+        mBuffer = Misc::decompress(compressed);
+        const std::uint64_t expectedSize = std::min<std::uint64_t>(mBlockSize,
+            mSize - static_cast<std::uint64_t>(index) * mBlockSize);
+        if (mBuffer.size() != expectedSize)
+            throw std::runtime_error("Invalid size of compressed block " + std::to_string(index));
+        mCurrentBlock = index;
+    }
+
+    bool isCompressedStream(std::istream& stream)
+    {
+        const auto position = stream.tellg();
+        char fileMagic[sizeof(magic)];
+        const bool result = stream.read(fileMagic, sizeof(fileMagic))
+            && std::memcmp(fileMagic, magic, sizeof(magic)) == 0;
+        stream.clear();
+        stream.seekg(position);
+        return result;
+    }
+
+    IStreamPtr openCompressedStream(IStreamPtr&& stream)
+    {
+        return std::make_unique<StreamWithBuffer<CompressedStreamBuf>>(
+            std::make_unique<CompressedStreamBuf>(std::move(stream)));
+    }
+
+    void writeCompressedStream(std::ostream& stream, std::string_view data, std::uint32_t blockSize)
+    {
+        if (blockSize == 0)
+            throw std::invalid_argument("Compressed stream block size should be greater than zero");
+
+        std::vector<std::vector<std::byte>> blocks;
+        for (std::size_t offset = 0; offset < data.size(); offset += blockSize)
+        {
+            const std::size_t size = std::min<std::size_t>(blockSize, data.size() - offset);
+            const auto begin = reinterpret_cast<const std::byte*>(data.data()) + offset;
+            blocks.push_back(Misc::compress(std::vector<std::byte>(begin, begin + size)));
+        }
+
+        stream.write(magic, sizeof(magic));
+        write(stream, version);
+        write(stream, blockSize);
+        write(stream, static_cast<std::uint64_t>(data.size()));
+        write(stream, static_cast<std::uint32_t>(blocks.size()));
+
+        auto offset = static_cast<std::uint64_t>(getHeaderSize(blocks.size()));
+        for (const std::vector<std::byte>& block : blocks)
+        {
+            write(stream, offset);
+            write(stream, static_cast<std::uint32_t>(block.size()));
+            offset += block.size();
+        }
+
+        for (const std::vector<std::byte>& block : blocks)
+            stream.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(block.size()));
+    }
+}
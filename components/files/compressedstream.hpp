@@ -0,0 +1,64 @@
+#ifndef OPENMW_COMPONENTS_FILES_COMPRESSEDSTREAM_H
+#define OPENMW_COMPONENTS_FILES_COMPRESSEDSTREAM_H
+
+#include "istreamptr.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <streambuf>
+#include <string_view>
+#include <vector>
+
+namespace Files
+{
+    /// Data split into blocks compressed independently with LZ4. A block table follows the header, so a block
+    /// containing any position can be found and decompressed without reading the previous ones.
+    class CompressedStreamBuf final : public std::streambuf
+    {
+    public:
+        /// Reads header and block table, throws on invalid data.
+        explicit CompressedStreamBuf(IStreamPtr&& stream);
+
+        std::uint64_t getSize() const { return mSize; }
+
+        int_type underflow() final;
+
+        pos_type seekoff(off_type offset, std::ios_base::seekdir whence, std::ios_base::openmode mode) final;
+
+        pos_type seekpos(pos_type pos, std::ios_base::openmode mode) final;
+
+    private:
+        struct Block
+        {
+            std::uint64_t mOffset; // relative to the header
+            std::uint32_t mSize;
+        };
+
+        IStreamPtr mStream;
+        std::uint64_t mOrigin;
+        std::uint64_t mSize = 0;
+        std::uint32_t mBlockSize = 0;
+        std::vector<Block> mBlocks;
+        std::size_t mCurrentBlock;
+        std::uint64_t mBufferOrigin = 0;
+        std::vector<std::byte> mBuffer;
+
+        void seekTo(std::uint64_t position);
+
+        void loadBlock(std::size_t index);
+    };
+
+    constexpr std::uint32_t defaultCompressedBlockSize = 256 * 1024;
+
+    /// Returns true if the stream starts with a header written by writeCompressedStream, keeps the stream position.
+    bool isCompressedStream(std::istream& stream);
+
+    /// Returns stream reading decompressed data of the stream written by writeCompressedStream.
+    IStreamPtr openCompressedStream(IStreamPtr&& stream);
+
+    void writeCompressedStream(std::ostream& stream, std::string_view data,
+        std::uint32_t blockSize = defaultCompressedBlockSize);
+}
+
+#endif
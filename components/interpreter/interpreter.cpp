@@ -21,18 +21,34 @@ namespace Interpreter
     }
 
     template<typename T>
-    auto& getDispatcher(const T& segment, unsigned int seg, int opcode)
+    auto getOpcode(const T& segment, int opcode)
     {
         auto it = segment.find(opcode);
-        if (it == segment.end())
+        return it == segment.end() ? nullptr : it->second.get();
+    }
+
+    [[noreturn]] static void abortInvalidCode(Type_Code code)
+    {
+        switch (code >> 30)
         {
-            abortUnknownCode(seg, opcode);
+            case 0: abortUnknownCode(0, code >> 24);
+            case 2: abortUnknownCode(2, (code >> 20) & 0x3ff);
         }
-        return it->second;
+
+        switch (code >> 26)
+        {
+            case 0x30: abortUnknownCode(3, (code >> 8) & 0x3ffff);
+            case 0x32: abortUnknownCode(5, code & 0x3ffffff);
+        }
+
+        abortUnknownSegment (code);
     }
 
-    void Interpreter::execute (Type_Code code)
+    Program::Instruction Interpreter::decode (Type_Code code) const
     {
+        Program::Instruction instruction;
+        instruction.mCode = code;
+
         unsigned int segSpec = code >> 30;
 
         switch (segSpec)
@@ -40,17 +56,17 @@ namespace Interpreter
             case 0:
             {
                 const int opcode = code >> 24;
-                const unsigned int arg0 = code & 0xffffff;
-
-                return getDispatcher(mSegment0, 0, opcode)->execute(mRuntime, arg0);
+                instruction.mOpcode1 = getOpcode(mSegment0, opcode);
+                instruction.mArg0 = code & 0xffffff;
+                return instruction;
             }
 
             case 2:
             {
                 const int opcode = (code >> 20) & 0x3ff;
-                const unsigned int arg0 = code & 0xfffff;
-
-                return getDispatcher(mSegment2, 2, opcode)->execute(mRuntime, arg0);
+                instruction.mOpcode1 = getOpcode(mSegment2, opcode);
+                instruction.mArg0 = code & 0xfffff;
+                return instruction;
             }
         }
 
@@ -61,20 +77,20 @@ namespace Interpreter
             case 0x30:
             {
                 const int opcode = (code >> 8) & 0x3ffff;
-                const unsigned int arg0 = code & 0xff;
-
-                return getDispatcher(mSegment3, 3, opcode)->execute(mRuntime, arg0);
+                instruction.mOpcode1 = getOpcode(mSegment3, opcode);
+                instruction.mArg0 = code & 0xff;
+                return instruction;
             }
 
             case 0x32:
             {
                 const int opcode = code & 0x3ffffff;
-
-                return getDispatcher(mSegment5, 5, opcode)->execute(mRuntime);
+                instruction.mOpcode0 = getOpcode(mSegment5, opcode);
+                return instruction;
             }
         }
 
-        abortUnknownSegment (code);
+        return instruction;
     }
 
     void Interpreter::begin()
@@ -107,25 +123,46 @@ namespace Interpreter
     Interpreter::Interpreter() : mRunning (false)
     {}
 
-    void Interpreter::run (const Type_Code *code, int codeSize, Context& context)
+    Program Interpreter::prepare (const Type_Code *code, int codeSize) const
     {
         assert (codeSize>=4);
 
+        Program program;
+        program.mCode = code;
+        program.mCodeSize = codeSize;
+
+        const int opcodes = static_cast<int> (code[0]);
+        const Type_Code *codeBlock = code + 4;
+
+        program.mInstructions.reserve (opcodes);
+        for (int i = 0; i < opcodes; ++i)
+            program.mInstructions.push_back (decode (codeBlock[i]));
+
+        return program;
+    }
+
+    void Interpreter::run (const Program& program, Context& context)
+    {
         begin();
 
         try
         {
-            mRuntime.configure (code, codeSize, context);
+            mRuntime.configure (program.mCode, program.mCodeSize, context);
 
-            int opcodes = static_cast<int> (code[0]);
-
-            const Type_Code *codeBlock = code + 4;
+            const Program::Instruction *instructions = program.mInstructions.data();
+            const int opcodes = static_cast<int> (program.mInstructions.size());
 
             while (mRuntime.getPC()>=0 && mRuntime.getPC()<opcodes)
             {
-                Type_Code runCode = codeBlock[mRuntime.getPC()];
+                const Program::Instruction& instruction = instructions[mRuntime.getPC()];
                 mRuntime.setPC (mRuntime.getPC()+1);
-                execute (runCode);
+
+                if (instruction.mOpcode1 != nullptr)
+                    instruction.mOpcode1->execute (mRuntime, instruction.mArg0);
+                else if (instruction.mOpcode0 != nullptr)
+                    instruction.mOpcode0->execute (mRuntime);
+                else
+                    abortInvalidCode (instruction.mCode);
             }
         }
         catch (...)
@@ -136,4 +173,9 @@ namespace Interpreter
 
         end();
     }
+
+    void Interpreter::run (const Type_Code *code, int codeSize, Context& context)
+    {
+        run (prepare (code, codeSize), context);
+    }
 }
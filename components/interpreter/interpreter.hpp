@@ -6,6 +6,7 @@
 #include <memory>
 #include <cassert>
 #include <utility>
+#include <vector>
 
 #include "runtime.hpp"
 #include "types.hpp"
@@ -13,6 +14,27 @@
 
 namespace Interpreter
 {
+    /// \brief Compiled code with all opcodes already resolved to their implementations
+    ///
+    /// Running a program dispatches every instruction directly instead of looking up its opcode.
+    /// \note Only valid for the Interpreter that prepared it and as long as the code it was prepared from exists.
+    class Program
+    {
+            friend class Interpreter;
+
+            struct Instruction
+            {
+                Opcode1 *mOpcode1 = nullptr;
+                Opcode0 *mOpcode0 = nullptr;
+                unsigned int mArg0 = 0;
+                Type_Code mCode = 0;
+            };
+
+            const Type_Code *mCode = nullptr;
+            int mCodeSize = 0;
+            std::vector<Instruction> mInstructions;
+    };
+
     class Interpreter
     {
             std::stack<Runtime> mCallstack;
@@ -27,7 +49,7 @@ namespace Interpreter
             Interpreter (const Interpreter&);
             Interpreter& operator= (const Interpreter&);
 
-            void execute (Type_Code code);
+            Program::Instruction decode (Type_Code code) const;
 
             void begin();
 
@@ -68,6 +90,11 @@ namespace Interpreter
                 installSegment(mSegment5, code, std::make_unique<T>(std::forward<TArgs>(args)...));
             }
 
+            /// Resolve the opcodes of \a code. Unknown opcodes only fail once they are executed.
+            Program prepare (const Type_Code *code, int codeSize) const;
+
+            void run (const Program& program, Context& context);
+
             void run (const Type_Code *code, int codeSize, Context& context);
     };
 }
@@ -4,6 +4,8 @@
 #include <luajit.h>
 #endif // NO_LUAJIT
 
+#include <algorithm>
+#include <cstdlib>
 #include <filesystem>
 
 #include <components/debug/debuglog.hpp>
@@ -50,7 +52,154 @@ namespace LuaUtil
         "type", "unpack", "xpcall", "rawequal", "rawget", "rawset", "setmetatable"};
     static const std::string safePackages[] = {"coroutine", "math", "string", "table"};
 
-    LuaState::LuaState(const VFS::Manager* vfs, const ScriptsConfiguration* conf) : mConf(conf), mVFS(vfs)
+    namespace
+    {
+        struct alignas(16) AllocationHeader
+        {
+            int mScriptId;
+        };
+
+        void* plainAllocator(void*, void* ptr, std::size_t, std::size_t nsize)
+        {
+            if (nsize == 0)
+            {
+                std::free(ptr);
+                return nullptr;
+            }
+            return std::realloc(ptr, nsize);
+        }
+
+        // LuaJIT without GC64 doesn't support custom allocators on 64-bit platforms.
+        bool isCustomAllocatorSupported()
+        {
+            static const bool supported = []
+            {
+                lua_State* state = lua_newstate(&plainAllocator, nullptr);
+                if (state == nullptr)
+                    return false;
+                lua_close(state);
+                return true;
+            }();
+            return supported;
+        }
+    }
+
+    sol::state LuaState::createState(LuaState* self)
+    {
+        if (self->mSettings.mProfilerEnabled || self->mSettings.mScriptMemoryLimit > 0)
+        {
+            if (isCustomAllocatorSupported())
+            {
+                self->mTrackingEnabled = true;
+                return sol::state(sol::default_at_panic, &LuaState::trackingAllocator, self);
+            }
+            Log(Debug::Error) << "Lua runtime doesn't support custom allocators; Lua profiler and script memory limit are disabled";
+        }
+        return sol::state();
+    }
+
+    void* LuaState::trackingAllocator(void* ud, void* ptr, std::size_t osize, std::size_t nsize)
+    {
+        LuaState& self = *static_cast<LuaState*>(ud);
+
+        // Every block starts with a header storing the script it's allocated by, so the memory is
+        // returned to the same script when the block is freed by the garbage collector later.
+        AllocationHeader* header = nullptr;
+        if (ptr == nullptr)
+            osize = 0;  // Lua passes the type of the object being allocated instead of the old size.
+        else
+            header = static_cast<AllocationHeader*>(ptr) - 1;
+
+        const int scriptId = header != nullptr ? header->mScriptId
+            : (self.mActiveCalls.empty() ? -1 : self.mActiveCalls.back().mScriptId);
+        const std::int64_t delta = static_cast<std::int64_t>(nsize) - static_cast<std::int64_t>(osize);
+
+        if (nsize == 0)
+        {
+            std::free(header);
+        }
+        else
+        {
+            const std::int64_t limit = self.mSettings.mScriptMemoryLimit;
+            if (delta > 0 && limit > 0 && scriptId >= 0 && self.mScriptStats[scriptId].mMemoryUsage + delta > limit)
+            {
+                ScriptStats& stats = self.mScriptStats[scriptId];
+                if (!stats.mMemoryLimitReported)
+                {
+                    stats.mMemoryLimitReported = true;
+                    Log(Debug::Error) << "Lua script " << (*self.mConf)[scriptId].mScriptPath
+                                      << " exceeded memory limit of " << limit << " bytes";
+                }
+                return nullptr;
+            }
+
+            auto* newHeader = static_cast<AllocationHeader*>(std::realloc(header, sizeof(AllocationHeader) + nsize));
+            if (newHeader == nullptr)
+                return nullptr;
+            newHeader->mScriptId = scriptId;
+            ptr = newHeader + 1;
+        }
+
+        self.mTotalMemoryUsage.fetch_add(delta, std::memory_order_relaxed);
+        if (scriptId >= 0)
+            self.mScriptStats[scriptId].mMemoryUsage += delta;
+
+        return nsize == 0 ? nullptr : ptr;
+    }
+
+    void LuaState::beginScriptCall(int scriptId, std::string_view handler)
+    {
+        if (static_cast<std::size_t>(scriptId) >= mScriptStats.size())
+            mScriptStats.resize(scriptId + 1);
+        mActiveCalls.push_back(ActiveCall {scriptId, handler, std::chrono::steady_clock::now()});
+    }
+
+    void LuaState::endScriptCall()
+    {
+        const ActiveCall call = mActiveCalls.back();
+        mActiveCalls.pop_back();
+        if (!mSettings.mProfilerEnabled)
+            return;
+        const auto duration = std::chrono::steady_clock::now() - call.mStart;
+        if (!mActiveCalls.empty())
+            mActiveCalls.back().mNested += duration;
+        const double time = std::chrono::duration<double>(duration - call.mNested).count();
+        ScriptStats& stats = mScriptStats[call.mScriptId];
+        stats.mFrameTime += time;
+        HandlerStats& handlerStats = stats.mHandlers[call.mHandler];
+        handlerStats.mTime += time;
+        ++handlerStats.mCalls;
+    }
+
+    std::int64_t LuaState::getTotalMemoryUsage()
+    {
+        if (mTrackingEnabled)
+            return mTotalMemoryUsage.load(std::memory_order_relaxed);
+        return static_cast<std::int64_t>(lua_gc(mLua, LUA_GCCOUNT, 0)) * 1024 + lua_gc(mLua, LUA_GCCOUNTB, 0);
+    }
+
+    double LuaState::takeMaxFrameTime()
+    {
+        double result = 0;
+        for (ScriptStats& stats : mScriptStats)
+        {
+            result = std::max(result, stats.mFrameTime);
+            stats.mFrameTime = 0;
+        }
+        return result;
+    }
+
+    void LuaState::resetHandlersStats()
+    {
+        for (ScriptStats& stats : mScriptStats)
+            stats.mHandlers.clear();
+    }
+
+    LuaState::LuaState(const VFS::Manager* vfs, const ScriptsConfiguration* conf, const LuaStateSettings& settings)
+        : mSettings(settings)
+        , mLua(createState(this))
+        , mConf(conf)
+        , mVFS(vfs)
     {
         mLua.open_libraries(sol::lib::base, sol::lib::coroutine, sol::lib::math, sol::lib::bit32,
                             sol::lib::string, sol::lib::table, sol::lib::os, sol::lib::debug);
@@ -1,7 +1,11 @@
 #ifndef COMPONENTS_LUA_LUASTATE_H
 #define COMPONENTS_LUA_LUASTATE_H
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <map>
+#include <vector>
 
 #include <sol/sol.hpp>
 
@@ -17,6 +21,17 @@ namespace LuaUtil
 
     std::string getLuaVersion();
 
+    // Optional instrumentation of the Lua runtime. Any of these features replaces the Lua allocator.
+    struct LuaStateSettings
+    {
+        // Measure time spent in handlers and memory allocated by every script.
+        bool mProfilerEnabled = false;
+
+        // Maximum memory in bytes that can be allocated by a single script (0 = unlimited).
+        // Allocations above the limit fail with a Lua error in the script.
+        std::int64_t mScriptMemoryLimit = 0;
+    };
+
     // Holds Lua state.
     // Provides additional features:
     //   - Load scripts from the virtual filesystem;
@@ -32,7 +47,8 @@ namespace LuaUtil
     class LuaState
     {
     public:
-        explicit LuaState(const VFS::Manager* vfs, const ScriptsConfiguration* conf);
+        explicit LuaState(const VFS::Manager* vfs, const ScriptsConfiguration* conf,
+                          const LuaStateSettings& settings = {});
         ~LuaState();
 
         // Returns underlying sol::state.
@@ -85,13 +101,87 @@ namespace LuaUtil
         sol::function loadFromVFS(const std::string& path);
         sol::environment newInternalLibEnvironment();
 
+        struct HandlerStats
+        {
+            double mTime = 0;  // seconds
+            std::uint64_t mCalls = 0;
+        };
+
+        struct ScriptStats
+        {
+            std::int64_t mMemoryUsage = 0;
+            double mFrameTime = 0;
+            std::map<std::string_view, HandlerStats> mHandlers;
+            bool mMemoryLimitReported = false;
+        };
+
+        // Attributes Lua allocations and, if the profiler is enabled, the time spent until the end
+        // of the scope to the script. Time spent in nested calls of other scripts is not included.
+        // `handler` must be a string literal.
+        class ScriptCallScope
+        {
+        public:
+            ScriptCallScope(LuaState& lua, int scriptId, std::string_view handler)
+                : mLua(lua.mTrackingEnabled ? &lua : nullptr)
+            {
+                if (mLua != nullptr)
+                    mLua->beginScriptCall(scriptId, handler);
+            }
+
+            ~ScriptCallScope()
+            {
+                if (mLua != nullptr)
+                    mLua->endScriptCall();
+            }
+
+            ScriptCallScope(const ScriptCallScope&) = delete;
+            ScriptCallScope& operator=(const ScriptCallScope&) = delete;
+
+        private:
+            LuaState* mLua;
+        };
+
+        bool isProfilerEnabled() const { return mSettings.mProfilerEnabled && mTrackingEnabled; }
+
+        // Indexed by script id in ScriptsConfiguration. Empty if neither profiler nor memory limit is enabled.
+        const std::vector<ScriptStats>& getScriptStats() const { return mScriptStats; }
+
+        // Memory allocated by all scripts and by the engine inside of the Lua state.
+        std::int64_t getTotalMemoryUsage();
+
+        // Returns the maximum time spent by one script since the previous call.
+        double takeMaxFrameTime();
+
+        void resetHandlersStats();
+
     private:
+        struct ActiveCall
+        {
+            int mScriptId;
+            std::string_view mHandler;
+            std::chrono::steady_clock::time_point mStart;
+            std::chrono::steady_clock::duration mNested {};
+        };
+
         static sol::protected_function_result throwIfError(sol::protected_function_result&&);
         template <typename... Args>
         friend sol::protected_function_result call(const sol::protected_function& fn, Args&&... args);
 
+        static sol::state createState(LuaState* self);
+        static void* trackingAllocator(void* ud, void* ptr, std::size_t osize, std::size_t nsize);
+
+        void beginScriptCall(int scriptId, std::string_view handler);
+        void endScriptCall();
+
         sol::function loadScriptAndCache(const std::string& path);
 
+        // Used by the allocator, so should be initialized before and destroyed after mLua.
+        const LuaStateSettings mSettings;
+        bool mTrackingEnabled = false;
+        std::vector<ScriptStats> mScriptStats;
+        std::vector<ActiveCall> mActiveCalls;
+        std::atomic<std::int64_t> mTotalMemoryUsage {0};
+
         sol::state mLua;
         const ScriptsConfiguration* mConf;
         sol::table mSandboxEnv;
@@ -75,6 +75,7 @@ namespace LuaUtil
 
         try
         {
+            const LuaState::ScriptCallScope scope(mLua, scriptId, "start");
             sol::object scriptOutput = mLua.runInNewSandbox(path, mNamePrefix, mAPI, script.mHiddenData);
             if (scriptOutput == sol::nil)
                 return true;
@@ -188,11 +189,13 @@ namespace LuaUtil
         }
         if (prev && script.mOnOverride)
         {
+            const LuaState::ScriptCallScope scope(mLua, scriptId, HANDLER_INTERFACE_OVERRIDE);
             try { LuaUtil::call(*script.mOnOverride, *prev->mInterface); }
             catch (std::exception& e) { printError(scriptId, "onInterfaceOverride failed", e); }
         }
         if (next && next->mOnOverride)
         {
+            const LuaState::ScriptCallScope scope(mLua, nextId, HANDLER_INTERFACE_OVERRIDE);
             try { LuaUtil::call(*next->mOnOverride, *script.mInterface); }
             catch (std::exception& e) { printError(nextId, "onInterfaceOverride failed", e); }
         }
@@ -226,6 +229,7 @@ namespace LuaUtil
                 sol::object prevInterface = sol::nil;
                 if (prev)
                     prevInterface = *prev->mInterface;
+                const LuaState::ScriptCallScope scope(mLua, nextId, HANDLER_INTERFACE_OVERRIDE);
                 try { LuaUtil::call(*next->mOnOverride, prevInterface); }
                 catch (std::exception& e) { printError(nextId, "onInterfaceOverride failed", e); }
             }
@@ -277,6 +281,7 @@ namespace LuaUtil
         EventHandlerList& list = it->second;
         for (int i = list.size() - 1; i >= 0; --i)
         {
+            const LuaState::ScriptCallScope scope(mLua, list[i].mScriptId, EVENT_HANDLERS);
             try
             {
                 sol::object res = LuaUtil::call(list[i].mFn, data);
@@ -299,6 +304,7 @@ namespace LuaUtil
 
     void ScriptsContainer::callOnInit(int scriptId, const sol::function& onInit, std::string_view data)
     {
+        const LuaState::ScriptCallScope scope(mLua, scriptId, HANDLER_INIT);
         try
         {
             LuaUtil::call(onInit, deserialize(mLua.sol(), data, mSerializer));
@@ -333,6 +339,7 @@ namespace LuaUtil
             savedScript.mScriptPath = script.mPath;
             if (script.mOnSave)
             {
+                const LuaState::ScriptCallScope scope(mLua, scriptId, HANDLER_SAVE);
                 try
                 {
                     sol::object state = LuaUtil::call(*script.mOnSave);
@@ -390,6 +397,7 @@ namespace LuaUtil
             }
             if (onLoad)
             {
+                const LuaState::ScriptCallScope scope(mLua, scriptId, HANDLER_LOAD);
                 try
                 {
                     sol::object state = deserialize(mLua.sol(), scriptInfo.mSavedData->mData, mSavedDataDeserializer);
@@ -496,6 +504,7 @@ namespace LuaUtil
 
     void ScriptsContainer::callTimer(const Timer& t)
     {
+        const LuaState::ScriptCallScope scope(mLua, t.mScriptId, "timer");
         try
         {
             Script& script = getScript(t.mScriptId);
@@ -98,6 +98,8 @@ namespace LuaUtil
         bool addCustomScript(int scriptId);
 
         bool hasScript(int scriptId) const { return mScripts.count(scriptId) != 0; }
+
+        LuaState& getLuaState() { return mLua; }
         void removeScript(int scriptId);
 
         void processTimers(double simulationTime, double gameTime);
@@ -171,6 +173,7 @@ namespace LuaUtil
         {
             for (Handler& handler : handlers.mList)
             {
+                const LuaState::ScriptCallScope scope(mLua, handler.mScriptId, handlers.mName);
                 try { LuaUtil::call(handler.mFn, args...); }
                 catch (std::exception& e)
                 {
@@ -259,8 +262,15 @@ namespace LuaUtil
         template <typename... Args>
         sol::object call(Args&&... args) const
         {
-            if (isValid())
+            sol::object scriptId = mHiddenData[ScriptsContainer::sScriptIdKey];
+            if (scriptId != sol::nil)
+            {
+                const ScriptsContainer::ScriptId id = scriptId.as<ScriptsContainer::ScriptId>();
+                if (id.mContainer == nullptr)
+                    return LuaUtil::call(mFunc, std::forward<Args>(args)...);
+                const LuaState::ScriptCallScope scope(id.mContainer->getLuaState(), id.mIndex, "callback");
                 return LuaUtil::call(mFunc, std::forward<Args>(args)...);
+            }
             else
                 Log(Debug::Debug) << "Ignored callback to the removed script "
                                   << mHiddenData.get<std::string>(ScriptsContainer::sScriptDebugNameKey);
@@ -0,0 +1,288 @@
+#ifndef OPENMW_COMPONENTS_MISC_SPATIALGRID_H
+#define OPENMW_COMPONENTS_MISC_SPATIALGRID_H
+
+#include <osg/Vec3f>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Misc
+{
+    /// Uniform grid over the XY plane to find objects close to a point without visiting all of them.
+    /// Objects are identified by a key, the owner has to call move whenever an object position changes.
+    /// Cells are stored densely over the area covered by objects. Objects outside of this area when it
+    /// can't grow further are kept in a separate list checked by every query.
+    template <class Key, class KeyHash = std::hash<Key>>
+    class SpatialGrid
+    {
+        public:
+            explicit SpatialGrid(float cellSize, std::size_t maxCells = 1 << 14)
+                : mCellSize(cellSize)
+                , mMaxCells(maxCells)
+            {}
+
+            float getCellSize() const { return mCellSize; }
+
+            std::size_t size() const { return mLocations.size(); }
+
+            bool empty() const { return mLocations.empty(); }
+
+            /// Adds an object or moves it when it's already added
+            void insert(const Key& key, const osg::Vec3f& position)
+            {
+                const auto [it, inserted] = mLocations.try_emplace(key);
+                if (inserted)
+                    place(it, position);
+                else
+                    moveObject(it, position);
+            }
+
+            /// Updates the object position
+            /// \return false when there is no such object
+            bool move(const Key& key, const osg::Vec3f& position)
+            {
+                const auto it = mLocations.find(key);
+                if (it == mLocations.end())
+                    return false;
+                moveObject(it, position);
+                return true;
+            }
+
+            bool erase(const Key& key)
+            {
+                const auto it = mLocations.find(key);
+                if (it == mLocations.end())
+                    return false;
+                removeFromCell(it->second);
+                mLocations.erase(it);
+                if (mLocations.empty())
+                    clear();
+                return true;
+            }
+
+            void clear()
+            {
+                mLocations.clear();
+                mBounds = Bounds {};
+                mCells.clear();
+                mNextRefit = sMinOutsideToRefit;
+            }
+
+            /// Calls function(key, position) for each object not further than radius from center
+            template <class Function>
+            void forEachInRadius(const osg::Vec3f& center, float radius, Function&& function) const
+            {
+                visitInRadius(center, radius, [&] (const Key& key, const osg::Vec3f& position)
+                {
+                    function(key, position);
+                    return false;
+                });
+            }
+
+            /// \return true if predicate(key, position) is true for any object not further than radius from center
+            template <class Predicate>
+            bool anyInRadius(const osg::Vec3f& center, float radius, Predicate&& predicate) const
+            {
+                return visitInRadius(center, radius, predicate);
+            }
+
+        private:
+            static constexpr std::size_t sMinOutsideToRefit = 16;
+
+            /// Inclusive range of cell coordinates, empty by default
+            struct Bounds
+            {
+                std::int32_t mMinX = 0;
+                std::int32_t mMinY = 0;
+                std::int32_t mMaxX = -1;
+                std::int32_t mMaxY = -1;
+
+                bool isEmpty() const { return mMaxX < mMinX || mMaxY < mMinY; }
+
+                bool contains(std::int32_t x, std::int32_t y) const
+                {
+                    return x >= mMinX && x <= mMaxX && y >= mMinY && y <= mMaxY;
+                }
+
+                std::size_t getWidth() const { return isEmpty() ? 0 : static_cast<std::size_t>(mMaxX - mMinX) + 1; }
+
+                std::size_t getHeight() const { return isEmpty() ? 0 : static_cast<std::size_t>(mMaxY - mMinY) + 1; }
+
+                std::size_t getCellsCount() const { return getWidth() * getHeight(); }
+
+                void add(std::int32_t x, std::int32_t y)
+                {
+                    if (isEmpty())
+                    {
+                        *this = Bounds {x, y, x, y};
+                        return;
+                    }
+                    mMinX = std::min(mMinX, x);
+                    mMinY = std::min(mMinY, y);
+                    mMaxX = std::max(mMaxX, x);
+                    mMaxY = std::max(mMaxY, y);
+                }
+            };
+
+            struct Location
+            {
+                std::size_t mCell = 0;
+                std::size_t mSlot = 0;
+            };
+
+            struct Object
+            {
+                Key mKey;
+                osg::Vec3f mPosition;
+            };
+
+            using Locations = std::unordered_map<Key, Location, KeyHash>;
+
+            float mCellSize;
+            std::size_t mMaxCells;
+            Locations mLocations;
+            Bounds mBounds;
+            // Row-major cells within mBounds followed by the objects outside of them
+            std::vector<std::vector<Object>> mCells;
+            std::size_t mNextRefit = sMinOutsideToRefit;
+
+            std::int32_t getCellCoordinate(float value) const
+            {
+                // Clamp to keep huge query radiuses from overflowing
+                constexpr float limit = 1 << 30;
+                return static_cast<std::int32_t>(std::clamp(std::floor(value / mCellSize), -limit, limit));
+            }
+
+            std::size_t getOutsideCell() const { return mCells.size() - 1; }
+
+            std::size_t getCell(std::int32_t x, std::int32_t y) const
+            {
+                if (!mBounds.contains(x, y))
+                    return getOutsideCell();
+                return static_cast<std::size_t>(y - mBounds.mMinY) * mBounds.getWidth()
+                    + static_cast<std::size_t>(x - mBounds.mMinX);
+            }
+
+            std::size_t getCell(const osg::Vec3f& position) const
+            {
+                return getCell(getCellCoordinate(position.x()), getCellCoordinate(position.y()));
+            }
+
+            void place(typename Locations::iterator it, const osg::Vec3f& position)
+            {
+                const std::int32_t x = getCellCoordinate(position.x());
+                const std::int32_t y = getCellCoordinate(position.y());
+                if (mCells.empty() || !mBounds.contains(x, y))
+                    cover(x, y);
+                const std::size_t cell = getCell(x, y);
+                std::vector<Object>& objects = mCells[cell];
+                it->second = Location {cell, objects.size()};
+                objects.push_back(Object {it->first, position});
+            }
+
+            void removeFromCell(const Location& location)
+            {
+                std::vector<Object>& objects = mCells[location.mCell];
+                if (location.mSlot + 1 != objects.size())
+                {
+                    objects[location.mSlot] = std::move(objects.back());
+                    mLocations.find(objects[location.mSlot].mKey)->second.mSlot = location.mSlot;
+                }
+                objects.pop_back();
+            }
+
+            void moveObject(typename Locations::iterator it, const osg::Vec3f& position)
+            {
+                const std::size_t cell = getCell(position);
+                if (it->second.mCell == cell && cell != getOutsideCell())
+                {
+                    mCells[cell][it->second.mSlot].mPosition = position;
+                    return;
+                }
+                removeFromCell(it->second);
+                place(it, position);
+            }
+
+            /// Tries to extend the covered area to include given cell
+            void cover(std::int32_t x, std::int32_t y)
+            {
+                Bounds extended = mBounds;
+                extended.add(x, y);
+                if (extended.getCellsCount() <= mMaxCells)
+                    return relayout(extended);
+
+                // Objects are too far from each other. Refit only when enough of them are outside
+                // so the covered area follows objects moving away from it altogether.
+                const std::size_t outside = mCells.back().size();
+                if (outside < mNextRefit)
+                    return;
+                Bounds fit;
+                fit.add(x, y);
+                for (const std::vector<Object>& objects : mCells)
+                    for (const Object& object : objects)
+                        fit.add(getCellCoordinate(object.mPosition.x()), getCellCoordinate(object.mPosition.y()));
+                if (fit.getCellsCount() <= mMaxCells)
+                    return relayout(fit);
+                mNextRefit = 2 * outside;
+            }
+
+            void relayout(const Bounds& bounds)
+            {
+                std::vector<std::vector<Object>> cells(bounds.getCellsCount() + 1);
+                std::swap(cells, mCells);
+                mBounds = bounds;
+                mNextRefit = sMinOutsideToRefit;
+                for (std::vector<Object>& objects : cells)
+                {
+                    for (Object& object : objects)
+                    {
+                        const std::size_t cell = getCell(object.mPosition);
+                        mLocations.find(object.mKey)->second = Location {cell, mCells[cell].size()};
+                        mCells[cell].push_back(std::move(object));
+                    }
+                }
+            }
+
+            template <class Visitor>
+            bool visitInRadius(const osg::Vec3f& center, float radius, Visitor&& visitor) const
+            {
+                if (mCells.empty())
+                    return false;
+
+                const float radius2 = radius * radius;
+                const auto visitObjects = [&] (const std::vector<Object>& objects)
+                {
+                    for (const Object& object : objects)
+                        if ((object.mPosition - center).length2() <= radius2 && visitor(object.mKey, object.mPosition))
+                            return true;
+                    return false;
+                };
+
+                const std::int32_t minX = std::max(mBounds.mMinX, getCellCoordinate(center.x() - radius));
+                const std::int32_t maxX = std::min(mBounds.mMaxX, getCellCoordinate(center.x() + radius));
+                const std::int32_t minY = std::max(mBounds.mMinY, getCellCoordinate(center.y() - radius));
+                const std::int32_t maxY = std::min(mBounds.mMaxY, getCellCoordinate(center.y() + radius));
+                if (minX <= maxX)
+                {
+                    for (std::int32_t y = minY; y <= maxY; ++y)
+                    {
+                        const std::size_t begin = getCell(minX, y);
+                        const std::size_t end = begin + static_cast<std::size_t>(maxX - minX) + 1;
+                        for (std::size_t cell = begin; cell < end; ++cell)
+                            if (visitObjects(mCells[cell]))
+                                return true;
+                    }
+                }
+
+                return visitObjects(mCells[getOutsideCell()]);
+            }
+    };
+}
+
+#endif
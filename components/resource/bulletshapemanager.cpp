@@ -123,12 +123,9 @@ osg::ref_ptr<const BulletShape> BulletShapeManager::getShape(const std::string &
 {
     const std::string normalized = mVFS->normalizeFilename(name);
 
-    osg::ref_ptr<BulletShape> shape;
-    osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(normalized);
-    if (obj)
-        shape = osg::ref_ptr<BulletShape>(static_cast<BulletShape*>(obj.get()));
-    else
+    osg::ref_ptr<osg::Object> obj = mCache->getOrLoad(normalized, [&] () -> osg::ref_ptr<osg::Object>
     {
+        osg::ref_ptr<BulletShape> shape;
         if (Misc::getFileExtension(normalized) == "nif")
         {
             NifBullet::BulletNifLoader loader;
@@ -173,9 +170,9 @@ osg::ref_ptr<const BulletShape> BulletShapeManager::getShape(const std::string &
             }
         }
 
-        mCache->addEntryToObjectCache(normalized, shape);
-    }
-    return shape;
+        return shape;
+    });
+    return osg::ref_ptr<const BulletShape>(static_cast<BulletShape*>(obj.get()));
 }
 
 osg::ref_ptr<BulletShapeInstance> BulletShapeManager::cacheInstance(const std::string &name)
@@ -225,6 +222,10 @@ void BulletShapeManager::reportStats(unsigned int frameNumber, osg::Stats *stats
 {
     stats->setAttribute(frameNumber, "Shape", mCache->getCacheSize());
     stats->setAttribute(frameNumber, "Shape Instance", mInstanceCache->getCacheSize());
+    stats->setAttribute(frameNumber, "Shape Dedup", mCache->getNumDeduplicatedLoads());
+    stats->setAttribute(frameNumber, "Shape Memory", mCache->getTotalSize() / (1024.0 * 1024.0));
+    if (const std::size_t maxSize = mCache->getMaxSize(); maxSize > 0)
+        stats->setAttribute(frameNumber, "Shape Budget", maxSize / (1024.0 * 1024.0));
 }
 
 }
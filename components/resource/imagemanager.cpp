@@ -87,10 +87,7 @@ namespace Resource
     {
         const std::string normalized = mVFS->normalizeFilename(filename);
 
-        osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(normalized);
-        if (obj)
-            return osg::ref_ptr<osg::Image>(static_cast<osg::Image*>(obj.get()));
-        else
+        osg::ref_ptr<osg::Object> obj = mCache->getOrLoad(normalized, [&] () -> osg::ref_ptr<osg::Object>
         {
             Files::IStreamPtr stream;
             try
@@ -100,7 +97,6 @@ namespace Resource
             catch (std::exception& e)
             {
                 Log(Debug::Error) << "Failed to open image: " << e.what();
-                mCache->addEntryToObjectCache(normalized, mWarningImage);
                 return mWarningImage;
             }
 
@@ -109,7 +105,6 @@ namespace Resource
             if (!reader)
             {
                 Log(Debug::Error) << "Error loading " << filename << ": no readerwriter for '" << ext << "' found";
-                mCache->addEntryToObjectCache(normalized, mWarningImage);
                 return mWarningImage;
             }
 
@@ -122,7 +117,6 @@ namespace Resource
                 if (stream->gcount() != 18)
                 {
                     Log(Debug::Error) << "Error loading " << filename << ": couldn't read TGA header";
-                    mCache->addEntryToObjectCache(normalized, mWarningImage);
                     return mWarningImage;
                 }
                 int type = header[2];
@@ -140,7 +134,6 @@ namespace Resource
             if (!result.success())
             {
                 Log(Debug::Error) << "Error loading " << filename << ": " << result.message() << " code " << result.status();
-                mCache->addEntryToObjectCache(normalized, mWarningImage);
                 return mWarningImage;
             }
 
@@ -153,7 +146,6 @@ namespace Resource
                 if (!uncompress)
                 {
                     Log(Debug::Error) << "Error loading " << filename << ": no S3TC texture compression support installed";
-                    mCache->addEntryToObjectCache(normalized, mWarningImage);
                     return mWarningImage;
                 }
                 else
@@ -183,9 +175,9 @@ namespace Resource
                 image = newImage;
             }
 
-            mCache->addEntryToObjectCache(normalized, image);
             return image;
-        }
+        });
+        return osg::ref_ptr<osg::Image>(static_cast<osg::Image*>(obj.get()));
     }
 
     osg::Image *ImageManager::getWarningImage()
@@ -196,6 +188,10 @@ namespace Resource
     void ImageManager::reportStats(unsigned int frameNumber, osg::Stats *stats) const
     {
         stats->setAttribute(frameNumber, "Image", mCache->getCacheSize());
+        stats->setAttribute(frameNumber, "Image Dedup", mCache->getNumDeduplicatedLoads());
+        stats->setAttribute(frameNumber, "Image Memory", mCache->getTotalSize() / (1024.0 * 1024.0));
+        if (const std::size_t maxSize = mCache->getMaxSize(); maxSize > 0)
+            stats->setAttribute(frameNumber, "Image Budget", maxSize / (1024.0 * 1024.0));
     }
 
 }
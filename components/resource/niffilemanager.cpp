@@ -46,21 +46,17 @@ namespace Resource
 
     Nif::NIFFilePtr NifFileManager::get(const std::string &name)
     {
-        osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(name);
-        if (obj)
-            return static_cast<NifFileHolder*>(obj.get())->mNifFile;
-        else
+        osg::ref_ptr<osg::Object> obj = mCache->getOrLoad(name, [&] () -> osg::ref_ptr<osg::Object>
         {
-            Nif::NIFFilePtr file (new Nif::NIFFile(mVFS->get(name), name));
-            obj = new NifFileHolder(file);
-            mCache->addEntryToObjectCache(name, obj);
-            return file;
-        }
+            return new NifFileHolder(Nif::NIFFilePtr(new Nif::NIFFile(mVFS->get(name), name)));
+        });
+        return static_cast<NifFileHolder*>(obj.get())->mNifFile;
     }
 
     void NifFileManager::reportStats(unsigned int frameNumber, osg::Stats *stats) const
     {
         stats->setAttribute(frameNumber, "Nif", mCache->getCacheSize());
+        stats->setAttribute(frameNumber, "Nif Dedup", mCache->getNumDeduplicatedLoads());
     }
 
 }
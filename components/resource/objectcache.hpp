@@ -3,6 +3,9 @@
 // - removeExpiredObjectsInCache no longer keeps a lock while the unref happens.
 // - template allows customized KeyType.
 // - objects with uninitialized time stamp are not removed.
+// - getOrLoad merges concurrent loads of the same key into a single load.
+// - estimated size of cached objects is tracked, unreferenced objects are evicted in LRU order when over the size limit.
+// - objects are kept in a list ordered by the last use, so the eviction doesn't sort the cache.
 
 /* -*-c++-*- OpenSceneGraph - Copyright (C) 1998-2006 Robert Osfield
  *
@@ -24,9 +27,17 @@
 #include <osg/ref_ptr>
 #include <osg/Node>
 
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <list>
 #include <string>
 #include <map>
 #include <mutex>
+#include <vector>
+
+#include "objectsize.hpp"
 
 namespace osg
 {
@@ -59,8 +70,8 @@ class GenericObjectCache : public osg::Referenced
             {
                 // If ref count is greater than 1, the object has an external reference.
                 // If the timestamp is yet to be initialized, it needs to be updated too.
-                if (itr->second.first->referenceCount()>1 || itr->second.second == 0.0)
-                    itr->second.second = referenceTime;
+                if (itr->second.mObject->referenceCount()>1 || itr->second.mTimeStamp == 0.0)
+                    itr->second.mTimeStamp = referenceTime;
             }
         }
 
@@ -77,10 +88,10 @@ class GenericObjectCache : public osg::Referenced
                 typename ObjectCacheMap::iterator oitr = _objectCache.begin();
                 while(oitr != _objectCache.end())
                 {
-                    if (oitr->second.second<=expiryTime)
+                    if (oitr->second.mTimeStamp<=expiryTime)
                     {
-                        objectsToRemove.push_back(oitr->second.first);
-                        _objectCache.erase(oitr++);
+                        objectsToRemove.push_back(oitr->second.mObject);
+                        erase(oitr++);
                     }
                     else
                         ++oitr;
@@ -90,18 +101,41 @@ class GenericObjectCache : public osg::Referenced
             objectsToRemove.clear();
         }
 
+        /** Remove least recently used objects without external references until the estimated size of the cache
+          * fits into the maximum size. Objects referenced elsewhere in the application are never removed.*/
+        void removeLeastRecentlyUsedObjectsInCache()
+        {
+            std::vector<osg::ref_ptr<osg::Object> > objectsToRemove;
+            {
+                std::lock_guard<std::mutex> lock(_objectCacheMutex);
+                // External references may be released since the last eviction
+                _evictionBlocked = false;
+                evictLeastRecentlyUsed(objectsToRemove, nullptr);
+            }
+            // note, actual unref happens outside of the lock
+            objectsToRemove.clear();
+        }
+
         /** Remove all objects in the cache regardless of having external references or expiry times.*/
         void clear()
         {
             std::lock_guard<std::mutex> lock(_objectCacheMutex);
             _objectCache.clear();
+            _usageOrder.clear();
+            _totalSize = 0;
+            _evictionBlocked = false;
         }
 
         /** Add a key,object,timestamp triple to the Registry::ObjectCache.*/
         void addEntryToObjectCache(const KeyType& key, osg::Object* object, double timestamp = 0.0)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            _objectCache[key]=ObjectTimeStampPair(object,timestamp);
+            const std::size_t size = object != nullptr ? estimateSize(*object) : 0;
+            std::vector<osg::ref_ptr<osg::Object> > objectsToRemove;
+            {
+                std::lock_guard<std::mutex> lock(_objectCacheMutex);
+                insert(key, object, timestamp, size, objectsToRemove);
+            }
+            objectsToRemove.clear();
         }
 
         /** Remove Object from cache.*/
@@ -109,7 +143,8 @@ class GenericObjectCache : public osg::Referenced
         {
             std::lock_guard<std::mutex> lock(_objectCacheMutex);
             typename ObjectCacheMap::iterator itr = _objectCache.find(key);
-            if (itr!=_objectCache.end()) _objectCache.erase(itr);
+            if (itr!=_objectCache.end())
+                erase(itr);
         }
 
         /** Get an ref_ptr<Object> from the object cache*/
@@ -118,10 +153,75 @@ class GenericObjectCache : public osg::Referenced
             std::lock_guard<std::mutex> lock(_objectCacheMutex);
             typename ObjectCacheMap::iterator itr = _objectCache.find(key);
             if (itr!=_objectCache.end())
-                return itr->second.first;
+            {
+                touch(itr->second);
+                return itr->second.mObject;
+            }
             else return nullptr;
         }
 
+        /** Get an ref_ptr<Object> from the object cache, or call load() and add its result to the cache if it's not there yet.
+          * If another thread is already loading the same key, wait for its result instead of loading it again.
+          * Exceptions thrown by load() are rethrown in all waiting threads. Null results are not added to the cache.*/
+        template <class Function>
+        osg::ref_ptr<osg::Object> getOrLoad(const KeyType& key, Function&& load)
+        {
+            std::promise<osg::ref_ptr<osg::Object>> promise;
+            {
+                std::unique_lock<std::mutex> lock(_objectCacheMutex);
+                typename ObjectCacheMap::iterator itr = _objectCache.find(key);
+                if (itr != _objectCache.end())
+                {
+                    touch(itr->second);
+                    return itr->second.mObject;
+                }
+                typename PendingLoadMap::iterator pending = _pendingLoads.find(key);
+                if (pending != _pendingLoads.end())
+                {
+                    const std::shared_future<osg::ref_ptr<osg::Object>> result = pending->second;
+                    lock.unlock();
+                    ++_deduplicatedLoads;
+                    return result.get();
+                }
+                _pendingLoads.emplace(key, promise.get_future().share());
+            }
+
+            osg::ref_ptr<osg::Object> object;
+            std::size_t size = 0;
+            try
+            {
+                object = load();
+                if (object != nullptr)
+                    size = estimateSize(*object);
+            }
+            catch (...)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_objectCacheMutex);
+                    _pendingLoads.erase(key);
+                }
+                promise.set_exception(std::current_exception());
+                throw;
+            }
+
+            std::vector<osg::ref_ptr<osg::Object> > objectsToRemove;
+            {
+                std::lock_guard<std::mutex> lock(_objectCacheMutex);
+                if (object != nullptr)
+                    insert(key, object, 0.0, size, objectsToRemove);
+                _pendingLoads.erase(key);
+            }
+            objectsToRemove.clear();
+            promise.set_value(object);
+            return object;
+        }
+
+        /** Get the number of getOrLoad calls which waited for a load started by another thread. */
+        unsigned int getNumDeduplicatedLoads() const
+        {
+            return _deduplicatedLoads;
+        }
+
         /** Check if an object is in the cache, and if it is, update its usage time stamp. */
         bool checkInObjectCache(const KeyType& key, double timeStamp)
         {
@@ -129,7 +229,8 @@ class GenericObjectCache : public osg::Referenced
             typename ObjectCacheMap::iterator itr = _objectCache.find(key);
             if (itr!=_objectCache.end())
             {
-                itr->second.second = timeStamp;
+                itr->second.mTimeStamp = timeStamp;
+                touch(itr->second);
                 return true;
             }
             else return false;
@@ -141,7 +242,7 @@ class GenericObjectCache : public osg::Referenced
             std::lock_guard<std::mutex> lock(_objectCacheMutex);
             for(typename ObjectCacheMap::iterator itr = _objectCache.begin(); itr != _objectCache.end(); ++itr)
             {
-                osg::Object* object = itr->second.first.get();
+                osg::Object* object = itr->second.mObject.get();
                 object->releaseGLObjects(state);
             }
         }
@@ -152,7 +253,7 @@ class GenericObjectCache : public osg::Referenced
             std::lock_guard<std::mutex> lock(_objectCacheMutex);
             for(typename ObjectCacheMap::iterator itr = _objectCache.begin(); itr != _objectCache.end(); ++itr)
             {
-                osg::Object* object = itr->second.first.get();
+                osg::Object* object = itr->second.mObject.get();
                 if (object)
                 {
                     osg::Node* node = dynamic_cast<osg::Node*>(object);
@@ -168,7 +269,7 @@ class GenericObjectCache : public osg::Referenced
         {
             std::lock_guard<std::mutex> lock(_objectCacheMutex);
             for (typename ObjectCacheMap::iterator it = _objectCache.begin(); it != _objectCache.end(); ++it)
-                f(it->first, it->second.first.get());
+                f(it->first, it->second.mObject.get());
         }
 
         /** Get the number of objects in the cache. */
@@ -178,16 +279,139 @@ class GenericObjectCache : public osg::Referenced
             return _objectCache.size();
         }
 
+        /** Get the estimated size of all objects in the cache in bytes. */
+        std::size_t getTotalSize() const
+        {
+            std::lock_guard<std::mutex> lock(_objectCacheMutex);
+            return _totalSize;
+        }
+
+        /** Set the estimated size in bytes above which unreferenced objects are evicted, 0 means no limit.
+          * Sizes are estimated only while there is a limit, objects cached before are estimated when it's set.*/
+        void setMaxSize(std::size_t maxSize)
+        {
+            std::vector<osg::ref_ptr<osg::Object> > objectsToRemove;
+            {
+                std::lock_guard<std::mutex> lock(_objectCacheMutex);
+                if (_maxSize == 0 && maxSize != 0)
+                {
+                    for (typename ObjectCacheMap::iterator itr = _objectCache.begin(); itr != _objectCache.end(); ++itr)
+                    {
+                        const std::size_t size = itr->second.mObject != nullptr ? estimateObjectSize(*itr->second.mObject) : 0;
+                        _totalSize += size - itr->second.mSize;
+                        itr->second.mSize = size;
+                    }
+                }
+                _maxSize = maxSize;
+                _evictionBlocked = false;
+                evictLeastRecentlyUsed(objectsToRemove, nullptr);
+            }
+            objectsToRemove.clear();
+        }
+
+        std::size_t getMaxSize() const
+        {
+            return _maxSize;
+        }
+
     protected:
 
         virtual ~GenericObjectCache() {}
 
-        typedef std::pair<osg::ref_ptr<osg::Object>, double >           ObjectTimeStampPair;
-        typedef std::map<KeyType, ObjectTimeStampPair >             ObjectCacheMap;
+        struct Item;
+
+        // Least recently used first, points to the elements of _objectCache
+        typedef std::list<std::pair<const KeyType, Item>*>             UsageList;
+
+        struct Item
+        {
+            osg::ref_ptr<osg::Object> mObject;
+            double mTimeStamp;
+            std::size_t mSize;
+            typename UsageList::iterator mUsage;
+        };
+
+        typedef std::map<KeyType, Item>                                 ObjectCacheMap;
+        typedef std::map<KeyType, std::shared_future<osg::ref_ptr<osg::Object>>> PendingLoadMap;
 
         ObjectCacheMap                          _objectCache;
+        UsageList                               _usageOrder;
+        PendingLoadMap                          _pendingLoads;
+        std::atomic_uint                        _deduplicatedLoads {0};
+        std::size_t                             _totalSize = 0;
+        std::atomic<std::size_t>                _maxSize {0};
+        bool                                    _evictionBlocked = false;
         mutable std::mutex                      _objectCacheMutex;
 
+    private:
+
+        // Estimating requires a full traversal of nodes, it's not worth it without a limit to check.
+        std::size_t estimateSize(const osg::Object& object) const
+        {
+            if (_maxSize == 0)
+                return 0;
+            return estimateObjectSize(object);
+        }
+
+        // Expects _objectCacheMutex to be locked.
+        void touch(Item& item)
+        {
+            _usageOrder.splice(_usageOrder.end(), _usageOrder, item.mUsage);
+        }
+
+        // Expects _objectCacheMutex to be locked.
+        void erase(typename ObjectCacheMap::iterator itr)
+        {
+            _totalSize -= itr->second.mSize;
+            _usageOrder.erase(itr->second.mUsage);
+            _objectCache.erase(itr);
+        }
+
+        // Expects _objectCacheMutex to be locked, removed objects are moved to objectsToRemove to be unreferenced after unlocking.
+        void insert(const KeyType& key, osg::Object* object, double timestamp, std::size_t size,
+            std::vector<osg::ref_ptr<osg::Object> >& objectsToRemove)
+        {
+            const auto [itr, inserted] = _objectCache.try_emplace(key);
+            Item& item = itr->second;
+            if (inserted)
+                item.mUsage = _usageOrder.insert(_usageOrder.end(), &*itr);
+            else
+            {
+                if (item.mObject != nullptr)
+                    objectsToRemove.push_back(item.mObject);
+                _totalSize -= item.mSize;
+                touch(item);
+            }
+            item.mObject = object;
+            item.mTimeStamp = timestamp;
+            item.mSize = size;
+            _totalSize += size;
+            evictLeastRecentlyUsed(objectsToRemove, object);
+        }
+
+        // The object that has just been added is kept even if nothing else references it yet. When nothing more can
+        // be evicted only removeLeastRecentlyUsedObjectsInCache and setMaxSize try again, so adding objects while all
+        // others are referenced doesn't walk the whole cache each time.
+        void evictLeastRecentlyUsed(std::vector<osg::ref_ptr<osg::Object> >& objectsToRemove, const osg::Object* keep)
+        {
+            if (_maxSize == 0 || _totalSize <= _maxSize || _evictionBlocked)
+                return;
+
+            typename UsageList::iterator usage = _usageOrder.begin();
+            while (usage != _usageOrder.end() && _totalSize > _maxSize)
+            {
+                const typename UsageList::iterator current = usage++;
+                const Item& item = (*current)->second;
+                if (item.mObject == nullptr || item.mObject == keep || item.mObject->referenceCount() != 1
+                    || item.mSize == 0)
+                    continue;
+                objectsToRemove.push_back(item.mObject);
+                erase(_objectCache.find((*current)->first));
+            }
+
+            _evictionBlocked = _totalSize > _maxSize;
+        }
+
 };
 
 class ObjectCache : public GenericObjectCache<std::string>
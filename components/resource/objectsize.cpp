@@ -0,0 +1,137 @@
+#include "objectsize.hpp"
+
+#include <unordered_set>
+
+#include <osg/Geometry>
+#include <osg/Image>
+#include <osg/NodeVisitor>
+
+#include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+#include <BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleIndexVertexArray.h>
+
+#include <components/sceneutil/morphgeometry.hpp>
+#include <components/sceneutil/riggeometry.hpp>
+
+#include "bulletshape.hpp"
+
+namespace Resource
+{
+    namespace
+    {
+        class GeometrySizeVisitor : public osg::NodeVisitor
+        {
+        public:
+            GeometrySizeVisitor()
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            {
+                setNodeMaskOverride(0xffffffff);
+            }
+
+            void apply(osg::Drawable& drawable) override
+            {
+                if (auto rig = dynamic_cast<SceneUtil::RigGeometry*>(&drawable))
+                    addGeometry(rig->getSourceGeometry().get());
+                else if (auto morph = dynamic_cast<SceneUtil::MorphGeometry*>(&drawable))
+                {
+                    addGeometry(morph->getSourceGeometry().get());
+                    addBufferData(morph->getBasePositions());
+                    for (const SceneUtil::MorphGeometry::MorphTarget& target : morph->getMorphTargetList())
+                        addMorphOffsets(target.getOffsets());
+                }
+                else
+                    addGeometry(drawable.asGeometry());
+            }
+
+            std::size_t mSize = 0;
+
+        private:
+            std::unordered_set<const osg::Referenced*> mVisited;
+
+            void addBufferData(const osg::BufferData* data)
+            {
+                if (data != nullptr && mVisited.insert(data).second)
+                    mSize += data->getTotalDataSize();
+            }
+
+            void addMorphOffsets(const SceneUtil::SparseOffsets* offsets)
+            {
+                if (offsets != nullptr && mVisited.insert(offsets).second)
+                    mSize += offsets->getMemorySize();
+            }
+
+            void addGeometry(const osg::Geometry* geometry)
+            {
+                if (geometry == nullptr)
+                    return;
+                addBufferData(geometry->getVertexArray());
+                addBufferData(geometry->getNormalArray());
+                addBufferData(geometry->getColorArray());
+                addBufferData(geometry->getSecondaryColorArray());
+                addBufferData(geometry->getFogCoordArray());
+                for (const osg::ref_ptr<osg::Array>& array : geometry->getTexCoordArrayList())
+                    addBufferData(array.get());
+                for (const osg::ref_ptr<osg::Array>& array : geometry->getVertexAttribArrayList())
+                    addBufferData(array.get());
+                for (const osg::ref_ptr<osg::PrimitiveSet>& primitives : geometry->getPrimitiveSetList())
+                    if (const osg::DrawElements* elements = primitives->getDrawElements())
+                        addBufferData(elements);
+            }
+        };
+
+        std::size_t getTriangleMeshSize(const btStridingMeshInterface* meshInterface)
+        {
+            const auto array = dynamic_cast<const btTriangleIndexVertexArray*>(meshInterface);
+            if (array == nullptr)
+                return 0;
+            std::size_t result = 0;
+            const IndexedMeshArray& meshes = const_cast<btTriangleIndexVertexArray*>(array)->getIndexedMeshArray();
+            for (int i = 0; i < meshes.size(); ++i)
+                result += static_cast<std::size_t>(meshes[i].m_numTriangles) * meshes[i].m_triangleIndexStride
+                    + static_cast<std::size_t>(meshes[i].m_numVertices) * meshes[i].m_vertexStride;
+            return result;
+        }
+
+        std::size_t getCollisionShapeSize(const btCollisionShape* shape)
+        {
+            if (shape == nullptr)
+                return 0;
+            if (const auto compound = dynamic_cast<const btCompoundShape*>(shape))
+            {
+                std::size_t result = 0;
+                for (int i = 0, n = compound->getNumChildShapes(); i < n; ++i)
+                    result += getCollisionShapeSize(compound->getChildShape(i));
+                return result;
+            }
+            if (const auto scaled = dynamic_cast<const btScaledBvhTriangleMeshShape*>(shape))
+                return getCollisionShapeSize(scaled->getChildShape());
+            if (const auto triangleMesh = dynamic_cast<const btBvhTriangleMeshShape*>(shape))
+            {
+                std::size_t result = getTriangleMeshSize(triangleMesh->getMeshInterface());
+                if (btOptimizedBvh* bvh = const_cast<btBvhTriangleMeshShape*>(triangleMesh)->getOptimizedBvh())
+                    result += static_cast<std::size_t>(bvh->getQuantizedNodeArray().size()) * sizeof(btQuantizedBvhNode);
+                return result;
+            }
+            return 0;
+        }
+    }
+
+    std::size_t estimateObjectSize(const osg::Object& object)
+    {
+        if (const auto image = dynamic_cast<const osg::Image*>(&object))
+            return image->getTotalSizeInBytesIncludingMipmaps();
+        if (const auto shape = dynamic_cast<const BulletShape*>(&object))
+            return getCollisionShapeSize(shape->mCollisionShape.get())
+                + getCollisionShapeSize(shape->mAvoidCollisionShape.get());
+        if (const auto node = dynamic_cast<const osg::Node*>(&object))
+        {
+            // const-trickery required because there is no const version of NodeVisitor
+            GeometrySizeVisitor visitor;
+            const_cast<osg::Node*>(node)->accept(visitor);
+            return visitor.mSize;
+        }
+        return 0;
+    }
+}
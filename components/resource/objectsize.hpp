@@ -0,0 +1,18 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_OBJECTSIZE_H
+#define OPENMW_COMPONENTS_RESOURCE_OBJECTSIZE_H
+
+#include <cstddef>
+
+namespace osg
+{
+    class Object;
+}
+
+namespace Resource
+{
+    /// @brief Estimate the amount of memory used by the data of a cached object.
+    /// @note Only image data, geometry arrays and Bullet collision meshes are accounted, other objects are estimated as 0.
+    std::size_t estimateObjectSize(const osg::Object& object);
+}
+
+#endif
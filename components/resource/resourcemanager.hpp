@@ -52,6 +52,7 @@ namespace Resource
         {
             mCache->updateTimeStampOfObjectsInCacheWithExternalReferences(referenceTime);
             mCache->removeExpiredObjectsInCache(referenceTime - mExpiryDelay);
+            mCache->removeLeastRecentlyUsedObjectsInCache();
         }
 
         /// Clear all cache entries.
@@ -61,6 +62,10 @@ namespace Resource
         void setExpiryDelay (double expiryDelay) override { mExpiryDelay = expiryDelay; }
         float getExpiryDelay() const { return mExpiryDelay; }
 
+        /// Estimated size in bytes of cached objects above which objects no longer referenced are evicted
+        /// in least recently used order, regardless of the expiry delay. 0 means no limit.
+        void setMaxCacheSize(std::size_t maxSize) { mCache->setMaxSize(maxSize); }
+
         const VFS::Manager* getVFS() const { return mVFS; }
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override {}
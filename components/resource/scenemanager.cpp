@@ -732,12 +732,9 @@ namespace Resource
 
     osg::ref_ptr<const osg::Node> SceneManager::getTemplate(const std::string &name, bool compile)
     {
-        std::string normalized = mVFS->normalizeFilename(name);
+        const std::string normalized = mVFS->normalizeFilename(name);
 
-        osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(normalized);
-        if (obj)
-            return osg::ref_ptr<const osg::Node>(static_cast<osg::Node*>(obj.get()));
-        else
+        osg::ref_ptr<osg::Object> obj = mCache->getOrLoad(normalized, [&] () -> osg::ref_ptr<osg::Object>
         {
             osg::ref_ptr<osg::Node> loaded;
             try
@@ -754,9 +751,9 @@ namespace Resource
 
                     for (unsigned int i=0; i<sizeof(sMeshTypes)/sizeof(sMeshTypes[0]); ++i)
                     {
-                        normalized = "meshes/marker_error." + std::string(sMeshTypes[i]);
-                        if (mVFS->exists(normalized))
-                            return load(normalized, mVFS, mImageManager, mNifFileManager);
+                        const std::string path = "meshes/marker_error." + std::string(sMeshTypes[i]);
+                        if (mVFS->exists(path))
+                            return load(path, mVFS, mImageManager, mNifFileManager);
                     }
                     Files::IMemStream file(Misc::errorMarker.data(), Misc::errorMarker.size());
                     return loadNonNif("error_marker.osgt", file, mImageManager);
@@ -796,9 +793,9 @@ namespace Resource
             else
                 loaded->getBound();
 
-            mCache->addEntryToObjectCache(normalized, loaded);
             return loaded;
-        }
+        });
+        return osg::ref_ptr<const osg::Node>(static_cast<osg::Node*>(obj.get()));
     }
 
     osg::ref_ptr<osg::Node> SceneManager::getInstance(const std::string& name)
@@ -986,6 +983,10 @@ namespace Resource
         }
 
         stats->setAttribute(frameNumber, "Node", mCache->getCacheSize());
+        stats->setAttribute(frameNumber, "Node Dedup", mCache->getNumDeduplicatedLoads());
+        stats->setAttribute(frameNumber, "Node Memory", mCache->getTotalSize() / (1024.0 * 1024.0));
+        if (const std::size_t maxSize = mCache->getMaxSize(); maxSize > 0)
+            stats->setAttribute(frameNumber, "Node Budget", maxSize / (1024.0 * 1024.0));
     }
 
     Shader::ShaderVisitor *SceneManager::createShaderVisitor(const std::string& shaderPrefix)
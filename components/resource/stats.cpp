@@ -428,6 +428,19 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "Nif",
             "Keyframe",
             "",
+            "Node Dedup",
+            "Shape Dedup",
+            "Image Dedup",
+            "Nif Dedup",
+            "Keyframe Dedup",
+            "",
+            "Node Memory",
+            "Node Budget",
+            "Shape Memory",
+            "Shape Budget",
+            "Image Memory",
+            "Image Budget",
+            "",
             "Groundcover Chunk",
             "Object Chunk",
             "Terrain Chunk",
@@ -446,6 +459,10 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "NavMesh UsedTiles",
             "NavMesh CachedTiles",
             "NavMesh CacheHitRate",
+            "NavMesh PathRequests Queued",
+            "NavMesh PathRequests Processing",
+            "NavMesh PathRequests Solved",
+            "NavMesh PathRequests Cancelled",
             "",
             "Mechanics Actors",
             "Mechanics Objects",
@@ -454,6 +471,13 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "Physics Objects",
             "Physics Projectiles",
             "Physics HeightFields",
+            "Physics LOS Cache",
+            "Physics LOS Hits",
+            "Physics LOS Misses",
+            "Physics LOS Refreshes",
+            "",
+            "Lua Memory",
+            "Lua Max Script",
         });
 
         static const auto longest = std::max_element(statNames.begin(), statNames.end(),
@@ -1,11 +1,48 @@
 #include "morphgeometry.hpp"
 
+#include "skinning.hpp"
+
+#include <algorithm>
 #include <cassert>
 #include <components/resource/scenemanager.hpp>
 
 namespace SceneUtil
 {
 
+namespace
+{
+    // Unmoved vertices between moved ones kept in the same span, copying a few zeros is cheaper than starting a new span
+    constexpr unsigned int sMaxSpanGap = 2;
+}
+
+SparseOffsets::SparseOffsets(const osg::Vec3Array& offsets)
+    : mVerticesCount(offsets.size())
+{
+    const osg::Vec3f zero(0, 0, 0);
+    const auto size = static_cast<unsigned int>(offsets.size());
+    unsigned int vertex = 0;
+    while (vertex < size)
+    {
+        if (offsets[vertex] == zero)
+        {
+            ++vertex;
+            continue;
+        }
+        unsigned int last = vertex;
+        for (unsigned int next = vertex + 1; next < size && next - last <= sMaxSpanGap + 1; ++next)
+            if (offsets[next] != zero)
+                last = next;
+        mSpans.push_back(Span {vertex, last - vertex + 1, mValues.size()});
+        mValues.insert(mValues.end(), offsets.begin() + vertex, offsets.begin() + last + 1);
+        vertex = last + 1;
+    }
+}
+
+std::size_t SparseOffsets::getMemorySize() const
+{
+    return mSpans.size() * sizeof(Span) + mValues.size() * sizeof(osg::Vec3f);
+}
+
 MorphGeometry::MorphGeometry()
     : mLastFrameNumber(0)
     , mDirty(true)
@@ -17,6 +54,7 @@ MorphGeometry::MorphGeometry()
 MorphGeometry::MorphGeometry(const MorphGeometry &copy, const osg::CopyOp &copyop)
     : osg::Drawable(copy, copyop)
     , mMorphTargets(copy.mMorphTargets)
+    , mBasePositions(copy.mBasePositions)
     , mLastFrameNumber(0)
     , mDirty(true)
     , mMorphedBoundingBox(false)
@@ -62,7 +100,15 @@ void MorphGeometry::setSourceGeometry(osg::ref_ptr<osg::Geometry> sourceGeom)
 
 void MorphGeometry::addMorphTarget(osg::Vec3Array *offsets, float weight)
 {
-    mMorphTargets.push_back(MorphTarget(offsets, weight));
+    if (mMorphTargets.empty())
+    {
+        mBasePositions = offsets;
+        mMorphTargets.push_back(MorphTarget(nullptr, weight));
+    }
+    else
+        mMorphTargets.push_back(MorphTarget(new SparseOffsets(*offsets), weight));
+    for (unsigned int i=0; i<2; ++i)
+        mBlendedWeights[i].clear();
     mMorphedBoundingBox = false;
     dirty();
 }
@@ -121,8 +167,8 @@ osg::BoundingBox MorphGeometry::computeBoundingBox() const
         mMorphedBoundingBox = true;
 
         const osg::Vec3Array* sourceVerts = static_cast<const osg::Vec3Array*>(mSourceGeometry->getVertexArray());
-        if (mMorphTargets.size() != 0)
-            sourceVerts = mMorphTargets[0].getOffsets();
+        if (mBasePositions != nullptr)
+            sourceVerts = mBasePositions.get();
         std::vector<osg::BoundingBox> vertBounds(sourceVerts->size());
 
         // Since we don't know what combinations of morphs are being applied we need to keep track of a bounding box for each vertex.
@@ -134,12 +180,16 @@ osg::BoundingBox MorphGeometry::computeBoundingBox() const
 
         for (unsigned int i = 1; i < mMorphTargets.size(); ++i)
         {
-            const osg::Vec3Array& offsets = *mMorphTargets[i].getOffsets();
-            for (unsigned int j=0; j<offsets.size() && j<vertBounds.size(); ++j)
+            const SparseOffsets& offsets = *mMorphTargets[i].getOffsets();
+            for (const SparseOffsets::Span& span : offsets.getSpans())
             {
-                osg::BoundingBox& bounds = vertBounds[j];
-                bounds.expandBy(bounds._max + offsets[j]);
-                bounds.expandBy(bounds._min + offsets[j]);
+                for (unsigned int j=0; j<span.mVerticesCount && span.mFirstVertex + j<vertBounds.size(); ++j)
+                {
+                    const osg::Vec3f& offset = offsets.getValues()[span.mOffset + j];
+                    osg::BoundingBox& bounds = vertBounds[span.mFirstVertex + j];
+                    bounds.expandBy(bounds._max + offset);
+                    bounds.expandBy(bounds._min + offset);
+                }
             }
         }
 
@@ -166,23 +216,53 @@ void MorphGeometry::cull(osg::NodeVisitor *nv)
     }
 
     mDirty = false;
+
+    // dirty() doesn't mean the weights are changed, keep showing the last blended vertices if they are the same
+    if (isBlended(mLastFrameNumber))
+    {
+        osg::Geometry& geom = *getGeometry(mLastFrameNumber);
+        nv->pushOntoNodePath(&geom);
+        nv->apply(geom);
+        nv->popFromNodePath();
+        return;
+    }
+
     mLastFrameNumber = nv->getTraversalNumber();
     osg::Geometry& geom = *getGeometry(mLastFrameNumber);
+    std::vector<float>& blendedWeights = mBlendedWeights[mLastFrameNumber%2];
 
-    const osg::Vec3Array* positionSrc = mMorphTargets[0].getOffsets();
+    const osg::Vec3Array* positionSrc = mBasePositions.get();
     osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
     assert(positionSrc->size() == positionDst->size());
-    for (unsigned int vertex=0; vertex<positionSrc->size(); ++vertex)
-        (*positionDst)[vertex] = (*positionSrc)[vertex];
+    if (blendedWeights.empty())
+        std::copy(positionSrc->begin(), positionSrc->end(), positionDst->begin());
+    else
+    {
+        // Only the vertices moved by the previous blend of this geometry differ from the base positions
+        for (unsigned int i=1; i<mMorphTargets.size(); ++i)
+        {
+            if (blendedWeights[i] == 0.f)
+                continue;
+            for (const SparseOffsets::Span& span : mMorphTargets[i].getOffsets()->getSpans())
+                std::copy_n(positionSrc->begin() + span.mFirstVertex, span.mVerticesCount,
+                            positionDst->begin() + span.mFirstVertex);
+        }
+    }
+
+    blendedWeights.resize(mMorphTargets.size());
+    for (unsigned int i=0; i<mMorphTargets.size(); ++i)
+        blendedWeights[i] = mMorphTargets[i].getWeight();
 
     for (unsigned int i=1; i<mMorphTargets.size(); ++i)
     {
-        float weight = mMorphTargets[i].getWeight();
+        const float weight = blendedWeights[i];
         if (weight == 0.f)
             continue;
-        const osg::Vec3Array* offsets = mMorphTargets[i].getOffsets();
-        for (unsigned int vertex=0; vertex<positionSrc->size(); ++vertex)
-            (*positionDst)[vertex] += (*offsets)[vertex] * weight;
+        const SparseOffsets& offsets = *mMorphTargets[i].getOffsets();
+        assert(offsets.getVerticesCount() == positionDst->size());
+        for (const SparseOffsets::Span& span : offsets.getSpans())
+            addScaled(offsets.getValues()[span.mOffset].ptr(), weight, span.mVerticesCount * 3,
+                      (*positionDst)[span.mFirstVertex].ptr());
     }
 
     positionDst->dirty();
@@ -199,5 +279,16 @@ osg::Geometry* MorphGeometry::getGeometry(unsigned int frame) const
     return mGeometry[frame%2];
 }
 
+bool MorphGeometry::isBlended(unsigned int frame) const
+{
+    const std::vector<float>& blendedWeights = mBlendedWeights[frame%2];
+    if (blendedWeights.size() != mMorphTargets.size())
+        return false;
+    for (unsigned int i=1; i<mMorphTargets.size(); ++i)
+        if (blendedWeights[i] != mMorphTargets[i].getWeight())
+            return false;
+    return true;
+}
+
 
 }
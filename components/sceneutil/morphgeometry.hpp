@@ -3,9 +3,42 @@
 
 #include <osg/Geometry>
 
+#include <cstddef>
+#include <vector>
+
 namespace SceneUtil
 {
 
+    /// @brief Morph target offsets without the vertices the target doesn't move.
+    /// @note Offsets are stored in spans of consecutive vertices, a few unmoved vertices between moved ones are kept
+    /// as zero offsets to not split a span.
+    class SparseOffsets : public osg::Referenced
+    {
+    public:
+        struct Span
+        {
+            unsigned int mFirstVertex;
+            unsigned int mVerticesCount;
+            std::size_t mOffset; // index of the first vertex offset in getValues()
+        };
+
+        explicit SparseOffsets(const osg::Vec3Array& offsets);
+
+        /// Number of vertices in the dense offsets the object is created from.
+        std::size_t getVerticesCount() const { return mVerticesCount; }
+
+        const std::vector<Span>& getSpans() const { return mSpans; }
+
+        const std::vector<osg::Vec3f>& getValues() const { return mValues; }
+
+        std::size_t getMemorySize() const;
+
+    private:
+        std::size_t mVerticesCount;
+        std::vector<Span> mSpans;
+        std::vector<osg::Vec3f> mValues;
+    };
+
     /// @brief Vertex morphing implementation.
     /// @note The internal Geometry used for rendering is double buffered, this allows updates to be done in a thread safe way while
     /// not compromising rendering performance. This is crucial when using osg's default threading model of DrawThreadPerContext.
@@ -27,21 +60,24 @@ namespace SceneUtil
         class MorphTarget
         {
         protected:
-            osg::ref_ptr<osg::Vec3Array> mOffsets;
+            osg::ref_ptr<const SparseOffsets> mOffsets;
             float mWeight;
         public:
-            MorphTarget(osg::Vec3Array* offsets, float w = 1.0) : mOffsets(offsets), mWeight(w) {}
+            MorphTarget(const SparseOffsets* offsets, float w = 1.0) : mOffsets(offsets), mWeight(w) {}
             void setWeight(float weight) { mWeight = weight; }
             float getWeight() const { return mWeight; }
-            osg::Vec3Array* getOffsets() { return mOffsets.get(); }
-            const osg::Vec3Array* getOffsets() const { return mOffsets.get(); }
-            void setOffsets(osg::Vec3Array* offsets) { mOffsets = offsets; }
+            /// Returns nullptr for the first target, see getBasePositions().
+            const SparseOffsets* getOffsets() const { return mOffsets.get(); }
         };
 
         typedef std::vector<MorphTarget> MorphTargetList;
 
+        /// The first target holds the base vertex positions, offsets of the following ones are added to it.
         virtual void addMorphTarget( osg::Vec3Array* offsets, float weight = 1.0 );
 
+        /// Vertex positions of the first morph target.
+        const osg::Vec3Array* getBasePositions() const { return mBasePositions.get(); }
+
         /** Set the MorphGeometry dirty.*/
         void dirty();
 
@@ -70,6 +106,13 @@ namespace SceneUtil
 
         MorphTargetList mMorphTargets;
 
+        osg::ref_ptr<const osg::Vec3Array> mBasePositions;
+
+        // Weights the vertices of each internal geometry are blended with, empty if not blended yet.
+        std::vector<float> mBlendedWeights[2];
+
+        bool isBlended(unsigned int frame) const;
+
         osg::ref_ptr<osg::Geometry> mSourceGeometry;
 
         osg::ref_ptr<osg::Geometry> mGeometry[2];
@@ -5,14 +5,14 @@
 #include <osg/MatrixTransform>
 
 #include "skeleton.hpp"
+#include "skinningqueue.hpp"
 #include "util.hpp"
 
 namespace
 {
-    inline void accumulateMatrix(const osg::Matrixf& invBindMatrix, const osg::Matrixf& matrix, const float weight, osg::Matrixf& result)
+    inline void accumulateMatrix(const osg::Matrixf& m, const float weight, osg::Matrixf& result)
     {
-        osg::Matrixf m = invBindMatrix * matrix;
-        float* ptr = m.ptr();
+        const float* ptr = m.ptr();
         float* ptrresult = result.ptr();
         ptrresult[0] += ptr[0] * weight;
         ptrresult[1] += ptr[1] * weight;
@@ -30,11 +30,38 @@ namespace
         ptrresult[13] += ptr[13] * weight;
         ptrresult[14] += ptr[14] * weight;
     }
+
+    template <class Array>
+    float* getData(Array* array)
+    {
+        if (array == nullptr || array->empty())
+            return nullptr;
+        return array->front().ptr();
+    }
 }
 
 namespace SceneUtil
 {
 
+RigGeometrySkinning::RigGeometrySkinning(RigGeometry& rig, unsigned int frameNumber)
+    : mRig(rig)
+    , mFrameNumber(frameNumber)
+{
+}
+
+void RigGeometrySkinning::doWork()
+{
+    run();
+}
+
+bool RigGeometrySkinning::run()
+{
+    if (mStarted.exchange(true))
+        return false;
+    mRig.skin(mFrameNumber);
+    return true;
+}
+
 RigGeometry::RigGeometry()
     : mSkeleton(nullptr)
     , mLastFrameNumber(0)
@@ -50,6 +77,7 @@ RigGeometry::RigGeometry(const RigGeometry &copy, const osg::CopyOp &copyop)
     , mInfluenceMap(copy.mInfluenceMap)
     , mBone2VertexVector(copy.mBone2VertexVector)
     , mBoneSphereVector(copy.mBoneSphereVector)
+    , mSkinningSource(copy.mSkinningSource)
     , mLastFrameNumber(0)
     , mBoundsFirstFrame(true)
 {
@@ -114,6 +142,8 @@ void RigGeometry::setSourceGeometry(osg::ref_ptr<osg::Geometry> sourceGeometry)
         else
             mSourceTangents = nullptr;
     }
+
+    updateSkinningSource();
 }
 
 osg::ref_ptr<osg::Geometry> RigGeometry::getSourceGeometry() const
@@ -163,22 +193,7 @@ bool RigGeometry::initFromParentSkeleton(osg::NodeVisitor* nv)
         mBoneNodesVector.push_back(bone);
     }
 
-    for (auto& pair : mBone2VertexVector->mData)
-    {
-        for (auto &weight : pair.first)
-        {
-            const std::string& boneName = weight.first.first;
-            Bone* bone = mSkeleton->getBone(boneName);
-            if (!bone)
-            {
-                mBoneNodesVector.push_back(nullptr);
-                Log(Debug::Error) << "Error: RigGeometry did not find bone " << boneName;
-                continue;
-            }
-
-            mBoneNodesVector.push_back(bone);
-        }
-    }
+    mBoneMatrices.resize(mBoneNodesVector.size());
 
     return true;
 }
@@ -205,64 +220,91 @@ void RigGeometry::cull(osg::NodeVisitor* nv)
     mLastFrameNumber = traversalNumber;
     osg::Geometry& geom = *getGeometry(mLastFrameNumber);
 
-    mSkeleton->updateBoneMatrices(traversalNumber);
+    if (mSkinning != nullptr && mSkinning->getFrameNumber() == traversalNumber)
+    {
+        // Take the result of the work queue or skin here if it's not started yet
+        if (!mSkinning->run())
+            mSkinning->waitTillDone();
+    }
+    else
+    {
+        mSkeleton->updateBoneMatrices(traversalNumber);
+        skin(traversalNumber);
+    }
+    mSkinning = nullptr;
 
-    // skinning
-    const osg::Vec3Array* positionSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
-    const osg::Vec3Array* normalSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
-    const osg::Vec4Array* tangentSrc = mSourceTangents;
+    if (SkinningQueue* queue = SkinningQueue::getCurrent())
+        queue->add(*this, *mSkeleton);
 
     osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
     osg::Vec3Array* normalDst = static_cast<osg::Vec3Array*>(geom.getNormalArray());
     osg::Vec4Array* tangentDst = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
 
-    int index = mBoneSphereVector->mData.size();
-    for (auto &pair : mBone2VertexVector->mData)
+    positionDst->dirty();
+    if (normalDst)
+        normalDst->dirty();
+    if (tangentDst)
+        tangentDst->dirty();
+
+    geom.osg::Drawable::dirtyGLObjects();
+
+    nv->pushOntoNodePath(&geom);
+    nv->apply(geom);
+    nv->popFromNodePath();
+}
+
+osg::ref_ptr<RigGeometrySkinning> RigGeometry::prepareSkinning(unsigned int frameNumber)
+{
+    if (!mSkeleton || mLastFrameNumber == frameNumber || (mLastFrameNumber != 0 && !mSkeleton->getActive()))
+        return nullptr;
+
+    // Skeleton is shared by all parts of an actor, so it's updated before skinning them in parallel
+    mSkeleton->updateBoneMatrices(frameNumber);
+
+    mSkinning = new RigGeometrySkinning(*this, frameNumber);
+    return mSkinning;
+}
+
+void RigGeometry::skin(unsigned int frameNumber)
+{
+    osg::Geometry& geom = *getGeometry(frameNumber);
+
+    float* const positionDst = getData(static_cast<osg::Vec3Array*>(geom.getVertexArray()));
+    float* const normalDst = getData(static_cast<osg::Vec3Array*>(geom.getNormalArray()));
+    float* const tangentDst = getData(static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7)));
+
+    for (std::size_t i = 0; i < mBoneNodesVector.size(); ++i)
+        if (const Bone* bone = mBoneNodesVector[i])
+            mBoneMatrices[i] = mInfluenceMap->mData[i].second.mInvBindMatrix * bone->mMatrixInSkeletonSpace;
+
+    const SkinningSource& source = *mSkinningSource;
+    std::size_t offset = 0;
+    for (const auto& [weights, vertices] : mBone2VertexVector->mData)
     {
         osg::Matrixf resultMat (0, 0, 0, 0,
                                 0, 0, 0, 0,
                                 0, 0, 0, 0,
                                 0, 0, 0, 1);
 
-        for (auto &weight : pair.first)
+        for (const auto& [bone, weight] : weights)
         {
-            Bone* bone = mBoneNodesVector[index];
-            if (bone == nullptr)
+            if (mBoneNodesVector[bone] == nullptr)
                 continue;
 
-            accumulateMatrix(weight.first.second, bone->mMatrixInSkeletonSpace, weight.second, resultMat);
-            index++;
+            accumulateMatrix(mBoneMatrices[bone], weight, resultMat);
         }
 
         if (mGeomToSkelMatrix)
             resultMat *= (*mGeomToSkelMatrix);
 
-        for (auto &vertex : pair.second)
-        {
-            (*positionDst)[vertex] = resultMat.preMult((*positionSrc)[vertex]);
-            if (normalDst)
-                (*normalDst)[vertex] = osg::Matrixf::transform3x3((*normalSrc)[vertex], resultMat);
+        transformPoints(resultMat.ptr(), source.mPositions, offset, vertices.size(), vertices.data(), positionDst, 3);
+        if (normalDst)
+            transformVectors(resultMat.ptr(), source.mNormals, offset, vertices.size(), vertices.data(), normalDst, 3);
+        if (tangentDst)
+            transformVectors(resultMat.ptr(), source.mTangents, offset, vertices.size(), vertices.data(), tangentDst, 4);
 
-            if (tangentDst)
-            {
-                const osg::Vec4f& srcTangent = (*tangentSrc)[vertex];
-                osg::Vec3f transformedTangent = osg::Matrixf::transform3x3(osg::Vec3f(srcTangent.x(), srcTangent.y(), srcTangent.z()), resultMat);
-                (*tangentDst)[vertex] = osg::Vec4f(transformedTangent, srcTangent.w());
-            }
-        }
+        offset += vertices.size();
     }
-
-    positionDst->dirty();
-    if (normalDst)
-        normalDst->dirty();
-    if (tangentDst)
-        tangentDst->dirty();
-
-    geom.osg::Drawable::dirtyGLObjects();
-
-    nv->pushOntoNodePath(&geom);
-    nv->apply(geom);
-    nv->popFromNodePath();
 }
 
 void RigGeometry::updateBounds(osg::NodeVisitor *nv)
@@ -283,15 +325,13 @@ void RigGeometry::updateBounds(osg::NodeVisitor *nv)
 
     osg::BoundingBox box;
 
-    int index = 0;
-    for (auto& boundPair : mBoneSphereVector->mData)
+    for (std::size_t i = 0; i < mBoneSphereVector->mData.size(); ++i)
     {
-        Bone* bone = mBoneNodesVector[index];
+        Bone* bone = mBoneNodesVector[i];
         if (bone == nullptr)
             continue;
 
-        index++;
-        osg::BoundingSpheref bs = boundPair.second;
+        osg::BoundingSpheref bs = mBoneSphereVector->mData[i].second;
         if (mGeomToSkelMatrix)
             transformBoundingSphere(bone->mMatrixInSkeletonSpace * (*mGeomToSkelMatrix), bs);
         else
@@ -355,17 +395,17 @@ void RigGeometry::setInfluenceMap(osg::ref_ptr<InfluenceMap> influenceMap)
     mBoneSphereVector = new BoneSphereVector;
     mBoneSphereVector->mData.reserve(mInfluenceMap->mData.size());
     mBone2VertexVector = new Bone2VertexVector;
-    for (auto& influencePair : mInfluenceMap->mData)
+    for (std::size_t i = 0; i < mInfluenceMap->mData.size(); ++i)
     {
-        const std::string& boneName = influencePair.first;
-        const BoneInfluence& bi = influencePair.second;
+        const std::string& boneName = mInfluenceMap->mData[i].first;
+        const BoneInfluence& bi = mInfluenceMap->mData[i].second;
         mBoneSphereVector->mData.emplace_back(boneName, bi.mBoundSphere);
 
         for (auto& weightPair: bi.mWeights)
         {
             std::vector<BoneWeight>& vec = vertex2BoneMap[weightPair.first];
 
-            vec.emplace_back(std::make_pair(boneName, bi.mInvBindMatrix), weightPair.second);
+            vec.emplace_back(i, weightPair.second);
         }
     }
 
@@ -377,6 +417,59 @@ void RigGeometry::setInfluenceMap(osg::ref_ptr<InfluenceMap> influenceMap)
 
     mBone2VertexVector->mData.reserve(bone2VertexMap.size());
     mBone2VertexVector->mData.assign(bone2VertexMap.begin(), bone2VertexMap.end());
+
+    mSkinningSource = nullptr;
+    updateSkinningSource();
+}
+
+void RigGeometry::updateSkinningSource()
+{
+    if (mSourceGeometry == nullptr || mBone2VertexVector == nullptr)
+        return;
+
+    const osg::Vec3Array* positions = static_cast<const osg::Vec3Array*>(mSourceGeometry->getVertexArray());
+    const osg::Vec3Array* normals = static_cast<const osg::Vec3Array*>(mSourceGeometry->getNormalArray());
+    const osg::Vec4Array* tangents = mSourceTangents;
+
+    // Copies share the source with the template
+    if (mSkinningSource != nullptr && mSkinningSource->mVertexArray == positions
+        && mSkinningSource->mNormalArray == normals && mSkinningSource->mTangentArray == tangents)
+        return;
+
+    osg::ref_ptr<SkinningSource> source = new SkinningSource;
+    source->mVertexArray = positions;
+    source->mNormalArray = normals;
+    source->mTangentArray = tangents;
+
+    std::size_t verticesCount = 0;
+    for (const auto& [weights, vertices] : mBone2VertexVector->mData)
+        verticesCount += vertices.size();
+    source->mPositions.reserve(verticesCount);
+    if (normals != nullptr)
+        source->mNormals.reserve(verticesCount);
+    if (tangents != nullptr)
+        source->mTangents.reserve(verticesCount);
+
+    for (const auto& [weights, vertices] : mBone2VertexVector->mData)
+    {
+        for (unsigned short vertex : vertices)
+        {
+            const osg::Vec3f& position = (*positions)[vertex];
+            source->mPositions.push_back(position.x(), position.y(), position.z());
+            if (normals != nullptr)
+            {
+                const osg::Vec3f& normal = (*normals)[vertex];
+                source->mNormals.push_back(normal.x(), normal.y(), normal.z());
+            }
+            if (tangents != nullptr)
+            {
+                const osg::Vec4f& tangent = (*tangents)[vertex];
+                source->mTangents.push_back(tangent.x(), tangent.y(), tangent.z());
+            }
+        }
+    }
+
+    mSkinningSource = std::move(source);
 }
 
 void RigGeometry::accept(osg::NodeVisitor &nv)
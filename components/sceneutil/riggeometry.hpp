@@ -4,10 +4,36 @@
 #include <osg/Geometry>
 #include <osg/Matrixf>
 
+#include <atomic>
+
+#include "skinning.hpp"
+#include "workqueue.hpp"
+
 namespace SceneUtil
 {
     class Skeleton;
     class Bone;
+    class RigGeometry;
+
+    /// Skins a RigGeometry for a frame ahead of its cull traversal, see SkinningQueue.
+    class RigGeometrySkinning : public WorkItem
+    {
+    public:
+        RigGeometrySkinning(RigGeometry& rig, unsigned int frameNumber);
+
+        unsigned int getFrameNumber() const { return mFrameNumber; }
+
+        void doWork() override;
+
+        /// Skin if no other thread has started yet.
+        /// @return true if skinned by this call.
+        bool run();
+
+    private:
+        RigGeometry& mRig;
+        const unsigned int mFrameNumber;
+        std::atomic_bool mStarted {false};
+    };
 
     // TODO: This class has a lot of issues.
     // - We require too many workarounds to ensure safety.
@@ -53,6 +79,11 @@ namespace SceneUtil
 
         osg::ref_ptr<osg::Geometry> getSourceGeometry() const;
 
+        /// Prepare skinning for the frame to run in a WorkQueue thread, the cull traversal takes the result or
+        /// skins itself if no thread has started. The skeleton must not be changed until the work is done.
+        /// @return nullptr if the geometry doesn't need skinning for this frame.
+        osg::ref_ptr<RigGeometrySkinning> prepareSkinning(unsigned int frameNumber);
+
         void accept(osg::NodeVisitor &nv) override;
         bool supports(const osg::PrimitiveFunctor&) const override{ return true; }
         void accept(osg::PrimitiveFunctor&) const override;
@@ -72,7 +103,10 @@ namespace SceneUtil
         };
 
     private:
+        friend class RigGeometrySkinning;
+
         void cull(osg::NodeVisitor* nv);
+        void skin(unsigned int frameNumber);
         void updateBounds(osg::NodeVisitor* nv);
 
         osg::ref_ptr<osg::Geometry> mGeometry[2];
@@ -86,9 +120,8 @@ namespace SceneUtil
 
         osg::ref_ptr<InfluenceMap> mInfluenceMap;
 
-        typedef std::pair<std::string, osg::Matrixf> BoneBindMatrixPair;
-
-        typedef std::pair<BoneBindMatrixPair, float> BoneWeight;
+        // <index in mInfluenceMap, weight>
+        typedef std::pair<std::size_t, float> BoneWeight;
 
         typedef std::vector<unsigned short> VertexList;
 
@@ -105,7 +138,24 @@ namespace SceneUtil
             std::vector<std::pair<std::string, osg::BoundingSpheref>> mData;
         };
         osg::ref_ptr<BoneSphereVector> mBoneSphereVector;
+        // Bone of each mInfluenceMap item
         std::vector<Bone*> mBoneNodesVector;
+        // Inverse bind matrix multiplied by the bone matrix for each mInfluenceMap item
+        std::vector<osg::Matrixf> mBoneMatrices;
+
+        /// Skinned source arrays packed in the order of mBone2VertexVector vertices.
+        struct SkinningSource : public osg::Referenced
+        {
+            osg::ref_ptr<const osg::Array> mVertexArray;
+            osg::ref_ptr<const osg::Array> mNormalArray;
+            osg::ref_ptr<const osg::Array> mTangentArray;
+            SoAVec3Array mPositions;
+            SoAVec3Array mNormals;
+            SoAVec3Array mTangents;
+        };
+        osg::ref_ptr<SkinningSource> mSkinningSource;
+
+        osg::ref_ptr<RigGeometrySkinning> mSkinning;
 
         unsigned int mLastFrameNumber;
         bool mBoundsFirstFrame;
@@ -113,6 +163,8 @@ namespace SceneUtil
         bool initFromParentSkeleton(osg::NodeVisitor* nv);
 
         void updateGeomToSkelMatrix(const osg::NodePath& nodePath);
+
+        void updateSkinningSource();
     };
 
 }
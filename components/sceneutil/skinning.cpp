@@ -0,0 +1,164 @@
+#include "skinning.hpp"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define OPENMW_SKINNING_USE_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace SceneUtil
+{
+    namespace
+    {
+        template <bool translate>
+        void transformScalar(const float* m, const SoAVec3Array& src, std::size_t offset, std::size_t count,
+            const unsigned short* indices, float* dst, std::size_t dstStride)
+        {
+            const float* const srcX = src.mX.data() + offset;
+            const float* const srcY = src.mY.data() + offset;
+            const float* const srcZ = src.mZ.data() + offset;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const float x = srcX[i];
+                const float y = srcY[i];
+                const float z = srcZ[i];
+                float* const result = dst + indices[i] * dstStride;
+                if constexpr (translate)
+                {
+                    result[0] = m[0] * x + m[4] * y + m[8] * z + m[12];
+                    result[1] = m[1] * x + m[5] * y + m[9] * z + m[13];
+                    result[2] = m[2] * x + m[6] * y + m[10] * z + m[14];
+                }
+                else
+                {
+                    result[0] = m[0] * x + m[4] * y + m[8] * z;
+                    result[1] = m[1] * x + m[5] * y + m[9] * z;
+                    result[2] = m[2] * x + m[6] * y + m[10] * z;
+                }
+            }
+        }
+
+#ifdef OPENMW_SKINNING_USE_SSE
+        // Transforms 4 vertices at once, results are transposed back to write each vertex with 2 stores
+        template <bool translate>
+        void transformSse(const float* m, const SoAVec3Array& src, std::size_t offset, std::size_t count,
+            const unsigned short* indices, float* dst, std::size_t dstStride)
+        {
+            const __m128 m0 = _mm_set1_ps(m[0]);
+            const __m128 m1 = _mm_set1_ps(m[1]);
+            const __m128 m2 = _mm_set1_ps(m[2]);
+            const __m128 m4 = _mm_set1_ps(m[4]);
+            const __m128 m5 = _mm_set1_ps(m[5]);
+            const __m128 m6 = _mm_set1_ps(m[6]);
+            const __m128 m8 = _mm_set1_ps(m[8]);
+            const __m128 m9 = _mm_set1_ps(m[9]);
+            const __m128 m10 = _mm_set1_ps(m[10]);
+            const __m128 m12 = _mm_set1_ps(m[12]);
+            const __m128 m13 = _mm_set1_ps(m[13]);
+            const __m128 m14 = _mm_set1_ps(m[14]);
+
+            const float* const srcX = src.mX.data() + offset;
+            const float* const srcY = src.mY.data() + offset;
+            const float* const srcZ = src.mZ.data() + offset;
+
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128 x = _mm_loadu_ps(srcX + i);
+                const __m128 y = _mm_loadu_ps(srcY + i);
+                const __m128 z = _mm_loadu_ps(srcZ + i);
+
+                __m128 resultX = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m4, y)), _mm_mul_ps(m8, z));
+                __m128 resultY = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, x), _mm_mul_ps(m5, y)), _mm_mul_ps(m9, z));
+                __m128 resultZ = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m2, x), _mm_mul_ps(m6, y)), _mm_mul_ps(m10, z));
+                if constexpr (translate)
+                {
+                    resultX = _mm_add_ps(resultX, m12);
+                    resultY = _mm_add_ps(resultY, m13);
+                    resultZ = _mm_add_ps(resultZ, m14);
+                }
+                __m128 unused = _mm_setzero_ps();
+
+                _MM_TRANSPOSE4_PS(resultX, resultY, resultZ, unused);
+
+                const __m128 vertices[] = {resultX, resultY, resultZ, unused};
+                for (std::size_t j = 0; j < 4; ++j)
+                {
+                    float* const result = dst + indices[i + j] * dstStride;
+                    _mm_storel_pi(reinterpret_cast<__m64*>(result), vertices[j]);
+                    _mm_store_ss(result + 2, _mm_movehl_ps(vertices[j], vertices[j]));
+                }
+            }
+
+            transformScalar<translate>(m, src, offset + i, count - i, indices + i, dst, dstStride);
+        }
+#endif
+
+        void addScaledScalar(const float* src, float weight, std::size_t offset, std::size_t count, float* dst)
+        {
+            for (std::size_t i = offset; i < count; ++i)
+                dst[i] += src[i] * weight;
+        }
+    }
+
+    void SoAVec3Array::reserve(std::size_t size)
+    {
+        mX.reserve(size);
+        mY.reserve(size);
+        mZ.reserve(size);
+    }
+
+    void SoAVec3Array::push_back(float x, float y, float z)
+    {
+        mX.push_back(x);
+        mY.push_back(y);
+        mZ.push_back(z);
+    }
+
+    void transformPoints(const float* matrix, const SoAVec3Array& src, std::size_t offset, std::size_t count,
+        const unsigned short* indices, float* dst, std::size_t dstStride)
+    {
+#ifdef OPENMW_SKINNING_USE_SSE
+        transformSse<true>(matrix, src, offset, count, indices, dst, dstStride);
+#else
+        transformScalar<true>(matrix, src, offset, count, indices, dst, dstStride);
+#endif
+    }
+
+    void transformVectors(const float* matrix, const SoAVec3Array& src, std::size_t offset, std::size_t count,
+        const unsigned short* indices, float* dst, std::size_t dstStride)
+    {
+#ifdef OPENMW_SKINNING_USE_SSE
+        transformSse<false>(matrix, src, offset, count, indices, dst, dstStride);
+#else
+        transformScalar<false>(matrix, src, offset, count, indices, dst, dstStride);
+#endif
+    }
+
+    void transformPointsScalar(const float* matrix, const SoAVec3Array& src, std::size_t offset, std::size_t count,
+        const unsigned short* indices, float* dst, std::size_t dstStride)
+    {
+        transformScalar<true>(matrix, src, offset, count, indices, dst, dstStride);
+    }
+
+    void transformVectorsScalar(const float* matrix, const SoAVec3Array& src, std::size_t offset, std::size_t count,
+        const unsigned short* indices, float* dst, std::size_t dstStride)
+    {
+        transformScalar<false>(matrix, src, offset, count, indices, dst, dstStride);
+    }
+
+    void addScaled(const float* src, float weight, std::size_t count, float* dst)
+    {
+        std::size_t i = 0;
+#ifdef OPENMW_SKINNING_USE_SSE
+        const __m128 scale = _mm_set1_ps(weight);
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), scale)));
+#endif
+        addScaledScalar(src, weight, i, count, dst);
+    }
+
+    void addScaledScalar(const float* src, float weight, std::size_t count, float* dst)
+    {
+        addScaledScalar(src, weight, 0, count, dst);
+    }
+}
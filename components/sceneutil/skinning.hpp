@@ -0,0 +1,47 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_SKINNING_H
+#define OPENMW_COMPONENTS_SCENEUTIL_SKINNING_H
+
+#include <cstddef>
+#include <vector>
+
+namespace SceneUtil
+{
+    /// 3D vectors stored as structure of arrays, so one SIMD register holds the same component of consecutive vectors.
+    struct SoAVec3Array
+    {
+        std::vector<float> mX;
+        std::vector<float> mY;
+        std::vector<float> mZ;
+
+        std::size_t size() const { return mX.size(); }
+
+        void reserve(std::size_t size);
+
+        void push_back(float x, float y, float z);
+    };
+
+    /// Transforms count points of src starting from offset by the affine matrix and writes the result into
+    /// dst + indices[i] * dstStride. The matrix has osg::Matrixf layout transforming row vectors like
+    /// osg::Matrixf::preMult. Uses SSE when it's available.
+    void transformPoints(const float* matrix, const SoAVec3Array& src, std::size_t offset, std::size_t count,
+        const unsigned short* indices, float* dst, std::size_t dstStride);
+
+    /// Same as transformPoints ignoring the translation like osg::Matrixf::transform3x3.
+    void transformVectors(const float* matrix, const SoAVec3Array& src, std::size_t offset, std::size_t count,
+        const unsigned short* indices, float* dst, std::size_t dstStride);
+
+    /// Versions of transformPoints and transformVectors never using SIMD, give the same results.
+    void transformPointsScalar(const float* matrix, const SoAVec3Array& src, std::size_t offset, std::size_t count,
+        const unsigned short* indices, float* dst, std::size_t dstStride);
+
+    void transformVectorsScalar(const float* matrix, const SoAVec3Array& src, std::size_t offset, std::size_t count,
+        const unsigned short* indices, float* dst, std::size_t dstStride);
+
+    /// Adds src[i] * weight to dst[i] for count floats, blends morph target offsets. Uses SSE when it's available.
+    void addScaled(const float* src, float weight, std::size_t count, float* dst);
+
+    /// Version of addScaled never using SIMD, gives the same results.
+    void addScaledScalar(const float* src, float weight, std::size_t count, float* dst);
+}
+
+#endif
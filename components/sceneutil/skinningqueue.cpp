@@ -0,0 +1,66 @@
+#include "skinningqueue.hpp"
+
+#include "riggeometry.hpp"
+#include "skeleton.hpp"
+
+namespace SceneUtil
+{
+    namespace
+    {
+        thread_local SkinningQueue* sCurrent = nullptr;
+    }
+
+    SkinningQueue::SkinningQueue(std::size_t workerThreads)
+        : mWorkQueue(new WorkQueue(workerThreads))
+    {
+    }
+
+    SkinningQueue* SkinningQueue::getCurrent()
+    {
+        return sCurrent;
+    }
+
+    void SkinningQueue::add(RigGeometry& rig, Skeleton& skeleton)
+    {
+        mRigs.push_back(Rig {&rig, &skeleton});
+    }
+
+    void SkinningQueue::operator()(osg::Node* node, osg::NodeVisitor* nv)
+    {
+        const unsigned int frameNumber = nv->getTraversalNumber();
+
+        // Only the first traversal of the frame starts skinning, the next ones (e.g. for shadows) find
+        // the geometries already skinned
+        if (frameNumber != mFrameNumber)
+        {
+            mFrameNumber = frameNumber;
+
+            std::vector<Rig> rigs;
+            rigs.swap(mRigs);
+
+            for (const Rig& rig : rigs)
+            {
+                Skinning skinning;
+                if (!rig.mGeometry.lock(skinning.mGeometry) || !rig.mSkeleton.lock(skinning.mSkeleton))
+                    continue;
+                osg::ref_ptr<RigGeometrySkinning> workItem = skinning.mGeometry->prepareSkinning(frameNumber);
+                if (workItem == nullptr)
+                    continue;
+                mWorkQueue->addWorkItem(workItem);
+                skinning.mWorkItem = std::move(workItem);
+                mSkinnings.push_back(std::move(skinning));
+            }
+        }
+
+        SkinningQueue* const previous = sCurrent;
+        sCurrent = this;
+
+        traverse(node, nv);
+
+        sCurrent = previous;
+
+        for (const Skinning& skinning : mSkinnings)
+            skinning.mWorkItem->waitTillDone();
+        mSkinnings.clear();
+    }
+}
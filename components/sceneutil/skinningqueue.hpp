@@ -0,0 +1,57 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_SKINNINGQUEUE_H
+#define OPENMW_COMPONENTS_SCENEUTIL_SKINNINGQUEUE_H
+
+#include <osg/observer_ptr>
+#include <osg/ref_ptr>
+
+#include <cstddef>
+#include <vector>
+
+#include "nodecallback.hpp"
+#include "workqueue.hpp"
+
+namespace SceneUtil
+{
+    class RigGeometry;
+    class Skeleton;
+
+    /// @brief Cull callback skinning RigGeometries below the node in parallel before they are culled.
+    /// @par Skins the geometries culled in the previous frame at the start of the first cull traversal of the
+    /// frame, the cull traversal of each geometry waits for its result or skins it itself if no worker thread has
+    /// started yet. All work is finished when the callback returns, so the scene graph can be modified as usual.
+    class SkinningQueue : public SceneUtil::NodeCallback<SkinningQueue>
+    {
+    public:
+        explicit SkinningQueue(std::size_t workerThreads);
+
+        /// Return the queue of the cull traversal running in this thread, nullptr if there is none.
+        static SkinningQueue* getCurrent();
+
+        /// Skin the geometry in parallel starting from the next frame.
+        void add(RigGeometry& rig, Skeleton& skeleton);
+
+        void operator()(osg::Node* node, osg::NodeVisitor* nv);
+
+    private:
+        struct Rig
+        {
+            osg::observer_ptr<RigGeometry> mGeometry;
+            // Geometry removed from the scene may outlive its skeleton
+            osg::observer_ptr<Skeleton> mSkeleton;
+        };
+
+        struct Skinning
+        {
+            osg::ref_ptr<RigGeometry> mGeometry;
+            osg::ref_ptr<Skeleton> mSkeleton;
+            osg::ref_ptr<WorkItem> mWorkItem;
+        };
+
+        osg::ref_ptr<WorkQueue> mWorkQueue;
+        unsigned int mFrameNumber = 0;
+        std::vector<Rig> mRigs;
+        std::vector<Skinning> mSkinnings;
+    };
+}
+
+#endif
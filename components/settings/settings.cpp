@@ -1,8 +1,10 @@
 #include "settings.hpp"
 #include "parser.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <sstream>
+#include <thread>
 
 #include <components/files/configurationmanager.hpp>
 #include <components/misc/strings/algorithm.hpp>
@@ -140,6 +142,16 @@ std::int64_t Manager::getInt64(std::string_view setting, std::string_view catego
     return number;
 }
 
+std::size_t Manager::getThreadsCount(std::string_view setting, std::string_view category)
+{
+    const int value = getInt(setting, category);
+    if (value < 0)
+        return 0;
+    if (value > 0)
+        return static_cast<std::size_t>(value);
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency()) - 1;
+}
+
 bool Manager::getBool(std::string_view setting, std::string_view category)
 {
     const std::string& string = getString(setting, category);
@@ -69,6 +69,10 @@ namespace Settings
         static osg::Vec2f getVector2(std::string_view setting, std::string_view category);
         static osg::Vec3f getVector3(std::string_view setting, std::string_view category);
 
+        static std::size_t getThreadsCount(std::string_view setting, std::string_view category);
+        ///< returns the number of threads for a thread count setting: 0 when the value is negative (disabled),
+        /// the number of available cores minus one when it is 0, and the value itself otherwise
+
         static void setInt(std::string_view setting, std::string_view category, int value);
         static void setInt64(std::string_view setting, std::string_view category, std::int64_t value);
         static void setFloat(std::string_view setting, std::string_view category, float value);
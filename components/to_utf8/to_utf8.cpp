@@ -333,7 +333,8 @@ void StatelessUtf8Encoder::copyFromArrayLegacyEnc(std::string_view::iterator& ch
 }
 
 Utf8Encoder::Utf8Encoder(FromType sourceEncoding)
-    : mBuffer(50 * 1024, '\0')
+    : mSourceEncoding(sourceEncoding)
+    , mBuffer(50 * 1024, '\0')
     , mImpl(sourceEncoding)
 {
 }
@@ -64,7 +64,10 @@ namespace ToUTF8
             /// ASCII-only string. Otherwise returns a view to the input.
             std::string_view getLegacyEnc(std::string_view input);
 
+            FromType getSourceEncoding() const { return mSourceEncoding; }
+
         private:
+            FromType mSourceEncoding;
             std::string mBuffer;
             StatelessUtf8Encoder mImpl;
     };
@@ -7,10 +7,12 @@
 namespace VFS
 {
 
-BsaArchive::BsaArchive(const std::string &filename)
+BsaArchive::BsaArchive(const std::string &filename, bool memoryMapped)
 {
     mFile = std::make_unique<Bsa::BSAFile>();
     mFile->open(filename);
+    if (memoryMapped)
+        mFile->enableMemoryMapping();
 
     const Bsa::BSAFile::FileList &filelist = mFile->getList();
     for(Bsa::BSAFile::FileList::const_iterator it = filelist.begin();it != filelist.end();++it)
@@ -68,11 +70,13 @@ Files::IStreamPtr BsaArchiveFile::open()
     return mFile->getFile(mInfo);
 }
 
-CompressedBsaArchive::CompressedBsaArchive(const std::string &filename)
+CompressedBsaArchive::CompressedBsaArchive(const std::string &filename, bool memoryMapped)
     : Archive()
 {
     mCompressedFile = std::make_unique<Bsa::CompressedBSAFile>();
     mCompressedFile->open(filename);
+    if (memoryMapped)
+        mCompressedFile->enableMemoryMapping();
 
     const Bsa::BSAFile::FileList &filelist = mCompressedFile->getList();
     for(Bsa::BSAFile::FileList::const_iterator it = filelist.begin();it != filelist.end();++it)
@@ -38,7 +38,8 @@ namespace VFS
     class BsaArchive : public Archive
     {
     public:
-        BsaArchive(const std::string& filename);
+        /// @param memoryMapped Map the archive into memory instead of opening a file stream for each file.
+        BsaArchive(const std::string& filename, bool memoryMapped = false);
         BsaArchive();
         virtual ~BsaArchive();
         void listResources(std::map<std::string, File*>& out, char (*normalize_function) (char)) override;
@@ -53,7 +54,8 @@ namespace VFS
     class CompressedBsaArchive : public Archive
     {
     public:
-        CompressedBsaArchive(const std::string& filename);
+        /// @param memoryMapped Map the archive into memory instead of opening a file stream for each file.
+        CompressedBsaArchive(const std::string& filename, bool memoryMapped = false);
         virtual ~CompressedBsaArchive() {}
         void listResources(std::map<std::string, File*>& out, char (*normalize_function) (char)) override;
         bool contains(const std::string& file, char (*normalize_function) (char)) const override;
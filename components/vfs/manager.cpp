@@ -3,6 +3,7 @@
 #include <stdexcept>
 #include <istream>
 #include <algorithm>
+#include <map>
 
 #include <components/misc/strings/lower.hpp>
 
@@ -27,6 +28,35 @@ namespace
         std::transform(path.begin(), path.end(), path.begin(), normalize_char);
     }
 
+    /// FNV-1a over the normalized characters of the path, so unnormalized names can be hashed without a copy.
+    template <class Normalize>
+    std::uint64_t hashPath(std::string_view path, Normalize normalize)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (char ch : path)
+        {
+            hash ^= static_cast<unsigned char>(normalize(ch));
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    template <class Normalize>
+    bool equalsNormalized(std::string_view normalized, std::string_view path, Normalize normalize)
+    {
+        return normalized.size() == path.size()
+            && std::equal(normalized.begin(), normalized.end(), path.begin(),
+                [&] (char l, char r) { return l == normalize(r); });
+    }
+
+    std::size_t getHashIndexSize(std::size_t filesCount)
+    {
+        std::size_t result = 16;
+        while (result < 2 * filesCount)
+            result *= 2;
+        return result;
+    }
+
 }
 
 namespace VFS
@@ -42,7 +72,8 @@ namespace VFS
 
     void Manager::reset()
     {
-        mIndex.clear();
+        mSortedIndex.clear();
+        mHashIndex.clear();
         mArchives.clear();
     }
 
@@ -53,34 +84,75 @@ namespace VFS
 
     void Manager::buildIndex()
     {
-        mIndex.clear();
+        std::map<std::string, File*> index;
 
         for (const auto& archive : mArchives)
-            archive->listResources(mIndex, mStrict ? &strict_normalize_char : &nonstrict_normalize_char);
+            archive->listResources(index, mStrict ? &strict_normalize_char : &nonstrict_normalize_char);
+
+        if (index.size() >= sEmptySlot)
+            throw std::runtime_error("Too many files in VFS: " + std::to_string(index.size()));
+
+        mSortedIndex.clear();
+        mSortedIndex.reserve(index.size());
+        while (!index.empty())
+        {
+            auto node = index.extract(index.begin());
+            mSortedIndex.emplace_back(std::move(node.key()), node.mapped());
+        }
+
+        mHashIndex.assign(getHashIndexSize(mSortedIndex.size()), HashSlot {});
+        const std::size_t mask = mHashIndex.size() - 1;
+        for (std::size_t i = 0; i < mSortedIndex.size(); ++i)
+        {
+            // Names are already normalized, so identity normalization gives the same hash as find
+            const std::uint64_t hash = hashPath(mSortedIndex[i].first, [] (char ch) { return ch; });
+            std::size_t slot = hash & mask;
+            while (mHashIndex[slot].mEntry != sEmptySlot)
+                slot = (slot + 1) & mask;
+            mHashIndex[slot] = HashSlot {hash, static_cast<std::uint32_t>(i)};
+        }
     }
 
-    Files::IStreamPtr Manager::get(std::string_view name) const
+    File* Manager::find(std::string_view name) const
     {
-        std::string normalized(name);
-        normalize_path(normalized, mStrict);
+        if (mHashIndex.empty())
+            return nullptr;
 
-        return getNormalized(normalized);
+        const auto lookup = [&] (auto normalize) -> File*
+        {
+            const std::uint64_t hash = hashPath(name, normalize);
+            const std::size_t mask = mHashIndex.size() - 1;
+            for (std::size_t slot = hash & mask; mHashIndex[slot].mEntry != sEmptySlot; slot = (slot + 1) & mask)
+            {
+                if (mHashIndex[slot].mHash != hash)
+                    continue;
+                const auto& [path, file] = mSortedIndex[mHashIndex[slot].mEntry];
+                if (equalsNormalized(path, name, normalize))
+                    return file;
+            }
+            return nullptr;
+        };
+
+        return mStrict ? lookup(strict_normalize_char) : lookup(nonstrict_normalize_char);
     }
 
-    Files::IStreamPtr Manager::getNormalized(const std::string &normalizedName) const
+    Files::IStreamPtr Manager::get(std::string_view name) const
     {
-        std::map<std::string, File*>::const_iterator found = mIndex.find(normalizedName);
-        if (found == mIndex.end())
-            throw std::runtime_error("Resource '" + normalizedName + "' not found");
-        return found->second->open();
+        if (File* file = find(name))
+            return file->open();
+        throw std::runtime_error("Resource '" + normalizeFilename(name) + "' not found");
     }
 
-    bool Manager::exists(std::string_view name) const
+    Files::IStreamPtr Manager::getNormalized(std::string_view normalizedName) const
     {
-        std::string normalized(name);
-        normalize_path(normalized, mStrict);
+        if (File* file = find(normalizedName))
+            return file->open();
+        throw std::runtime_error("Resource '" + std::string(normalizedName) + "' not found");
+    }
 
-        return mIndex.find(normalized) != mIndex.end();
+    bool Manager::exists(std::string_view name) const
+    {
+        return find(name) != nullptr;
     }
 
     std::string Manager::normalizeFilename(std::string_view name) const
@@ -104,13 +176,9 @@ namespace VFS
 
     std::string Manager::getAbsoluteFileName(std::string_view name) const
     {
-        std::string normalized(name);
-        normalize_path(normalized, mStrict);
-
-        std::map<std::string, File*>::const_iterator found = mIndex.find(normalized);
-        if (found == mIndex.end())
-            throw std::runtime_error("Resource '" + normalized + "' not found");
-        return found->second->getPath();
+        if (File* file = find(name))
+            return file->getPath();
+        throw std::runtime_error("Resource '" + normalizeFilename(name) + "' not found");
     }
 
     namespace
@@ -119,17 +187,22 @@ namespace VFS
         {
             return text.rfind(start, 0) == 0;
         }
+
+        bool pathLess(const std::pair<std::string, File*>& entry, std::string_view path)
+        {
+            return entry.first < path;
+        }
     }
 
     Manager::RecursiveDirectoryRange Manager::getRecursiveDirectoryIterator(std::string_view path) const
     {
         if (path.empty())
-            return { mIndex.begin(), mIndex.end() };
+            return { mSortedIndex.begin(), mSortedIndex.end() };
         auto normalized = normalizeFilename(path);
-        const auto it = mIndex.lower_bound(normalized);
-        if (it == mIndex.end() || !startsWith(it->first, normalized))
+        const auto it = std::lower_bound(mSortedIndex.begin(), mSortedIndex.end(), normalized, pathLess);
+        if (it == mSortedIndex.end() || !startsWith(it->first, normalized))
             return { it, it };
         ++normalized.back();
-        return { it, mIndex.lower_bound(normalized) };
+        return { it, std::lower_bound(it, mSortedIndex.end(), normalized, pathLess) };
     }
 }
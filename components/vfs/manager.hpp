@@ -3,10 +3,13 @@
 
 #include <components/files/istreamptr.hpp>
 
-#include <vector>
-#include <map>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace VFS
 {
@@ -34,17 +37,19 @@ namespace VFS
     /// @par Most of the methods in this class are considered thread-safe, see each method documentation for details.
     class Manager
     {
+        using SortedIndex = std::vector<std::pair<std::string, File*>>;
+
         class RecursiveDirectoryIterator
         {
         public:
-            RecursiveDirectoryIterator(std::map<std::string, File*>::const_iterator it) : mIt(it) {}
+            RecursiveDirectoryIterator(SortedIndex::const_iterator it) : mIt(it) {}
             const std::string& operator*() const { return mIt->first; }
             const std::string* operator->() const { return &mIt->first; }
             bool operator!=(const RecursiveDirectoryIterator& other) { return mIt != other.mIt; }
             RecursiveDirectoryIterator& operator++() { ++mIt; return *this; }
 
         private:
-            std::map<std::string, File*>::const_iterator mIt;
+            SortedIndex::const_iterator mIt;
         };
 
         using RecursiveDirectoryRange = IteratorPair<RecursiveDirectoryIterator>;
@@ -81,7 +86,7 @@ namespace VFS
         /// Retrieve a file by name (name is already normalized).
         /// @note Throws an exception if the file can not be found.
         /// @note May be called from any thread once the index has been built.
-        Files::IStreamPtr getNormalized(const std::string& normalizedName) const;
+        Files::IStreamPtr getNormalized(std::string_view normalizedName) const;
 
         std::string getArchive(std::string_view name) const;
 
@@ -97,11 +102,29 @@ namespace VFS
         std::string getAbsoluteFileName(std::string_view name) const;
 
     private:
+        /// Slot of the open-addressed hash table, refers to an element of mSortedIndex.
+        struct HashSlot
+        {
+            std::uint64_t mHash = 0;
+            std::uint32_t mEntry = sEmptySlot;
+        };
+
+        static constexpr std::uint32_t sEmptySlot = std::numeric_limits<std::uint32_t>::max();
+
+        /// Find a file by name, normalizing the name on the fly without allocating.
+        /// @return nullptr if the file can not be found.
+        File* find(std::string_view name) const;
+
         bool mStrict;
 
         std::vector<std::unique_ptr<Archive>> mArchives;
 
-        std::map<std::string, File*> mIndex;
+        /// All files ordered by normalized path, used for directory iteration.
+        SortedIndex mSortedIndex;
+
+        /// Hash table over mSortedIndex keyed by the hash of the normalized path, used for lookups.
+        /// Size is a power of two and at least twice the number of files.
+        std::vector<HashSlot> mHashIndex;
     };
 
 }
@@ -13,7 +13,7 @@
 namespace VFS
 {
 
-    void registerArchives(VFS::Manager *vfs, const Files::Collections &collections, const std::vector<std::string> &archives, bool useLooseFiles)
+    void registerArchives(VFS::Manager *vfs, const Files::Collections &collections, const std::vector<std::string> &archives, bool useLooseFiles, bool memoryMappedArchives)
     {
         const Files::PathContainer& dataDirs = collections.getPaths();
 
@@ -27,9 +27,9 @@ namespace VFS
                 Bsa::BsaVersion bsaVersion = Bsa::CompressedBSAFile::detectVersion(archivePath);
 
                 if (bsaVersion == Bsa::BSAVER_COMPRESSED)
-                    vfs->addArchive(std::make_unique<CompressedBsaArchive>(archivePath));
+                    vfs->addArchive(std::make_unique<CompressedBsaArchive>(archivePath, memoryMappedArchives));
                 else
-                    vfs->addArchive(std::make_unique<BsaArchive>(archivePath));
+                    vfs->addArchive(std::make_unique<BsaArchive>(archivePath, memoryMappedArchives));
             }
             else
             {
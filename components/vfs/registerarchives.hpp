@@ -8,8 +8,9 @@ namespace VFS
     class Manager;
 
     /// @brief Register BSA and file system archives based on the given OpenMW configuration.
+    /// @param memoryMappedArchives Map BSA archives into memory instead of opening a file stream per file.
     void registerArchives (VFS::Manager* vfs, const Files::Collections& collections,
-        const std::vector<std::string>& archives, bool useLooseFiles);
+        const std::vector<std::string>& archives, bool useLooseFiles, bool memoryMappedArchives = false);
 }
 
 #endif
@@ -71,6 +71,18 @@
 --     radius = 10,
 -- })
 
+---
+-- Cast several rays at once, faster than calling `castRay` for each of them because the rays are cast in parallel.
+-- @function [parent=#nearby] castRays
+-- @param #list<#table> rays A list of tables with fields `from` and `to` (start and end points of the ray)
+-- and optional fields with the same meaning as in `options` of @{#nearby.castRay}: `ignore`, `collisionType`, `radius`.
+-- @return #list<#RayCastingResult> Results in the same order as rays.
+-- @usage local results = nearby.castRays({
+--     {from = self.position, to = enemy.position, ignore = self},
+--     {from = self.position, to = targetPos, radius = 10},
+-- })
+-- if not results[1].hit and not results[2].hit then print('both paths are clear') end
+
 ---
 -- Cast ray from one point to another and find the first visual intersection with anything in the scene.
 -- As opposite to `castRay` can find an intersection with an object without collisions.